@@ -38,6 +38,7 @@
 #include "misc/singletonmap.h"
 #include "num/gauss.h"
 #include <iterator>
+#include <limits>
 #include <set>
 
 namespace DROPS
@@ -153,7 +154,7 @@ void PeriodicEdgesCL::AccumulateMFR( int lvl)
 
 MultiGridCL::MultiGridCL (const MGBuilderCL& Builder)
     : TriangVertex_( *this), TriangEdge_( *this), TriangFace_( *this), TriangTetra_( *this), version_(0),
-    factory_( Vertices_, Edges_, Faces_, Tetras_), MeshDeform_(0)
+    factory_( Vertices_, Edges_, Faces_, Tetras_), MeshDeform_(0), boxtree_( 0)
 {
 #ifdef _PAR
     DiST::InfoCL::Instance( this);  // tell InfoCL about the multigrid before(!) building the grid
@@ -176,11 +177,33 @@ void MultiGridCL::ClearTriangCache ()
     ParMultiGridCL::Instance().MarkSimplicesForUnknowns();
 #endif
 
+    // The color classes are kept for the incremental update in GetColorClasses.
+    for (std::map<int, ColorClassesCL*>::iterator it= colors_.begin(), end= colors_.end(); it != end; ++it)
+        it->second->Outdate();
+    DeletePartitions();
+    DeleteBoxTree();
+}
+
+void MultiGridCL::DeleteColorClasses ()
+{
     for (std::map<int, ColorClassesCL*>::iterator it= colors_.begin(), end= colors_.end(); it != end; ++it)
         delete it->second;
     colors_.clear();
 }
 
+void MultiGridCL::DeletePartitions ()
+{
+    for (std::map<int, TriangPartitionCL*>::iterator it= partitions_.begin(), end= partitions_.end(); it != end; ++it)
+        delete it->second;
+    partitions_.clear();
+}
+
+void MultiGridCL::DeleteBoxTree ()
+{
+    delete boxtree_;
+    boxtree_= 0;
+}
+
 void MultiGridCL::CloseGrid(Uint Level)
 {
     Comment("Closing grid " << Level << "." << std::endl, DebugRefineEasyC);
@@ -1116,33 +1139,85 @@ LocatorCL::LocateInTetra(LocationCL& loc, Uint trilevel, const Point3DCL&p, doub
         }
 }
 
+/// \brief Collects the tetra with the smallest position in the level, which contains the point; used by LocatorCL::Locate.
+/// Taking the first tetra in the order of the level yields the same result as the linear search over the level.
+class LocateCandidateCL
+{
+  private:
+    const Point3DCL& p_;
+    double           tol_;
+    SMatrixCL<4,4>   M_;
+    SVectorCL<4>     b_;
+
+  public:
+    size_t         pos;
+    const TetraCL* tetra;
+    SVectorCL<4>   bary;
+
+    LocateCandidateCL (const Point3DCL& p, double tol)
+        : p_( p), tol_( tol), pos( static_cast<size_t>( -1)), tetra( 0) {}
+
+    void operator() (size_t k, const TetraCL* t)
+    {
+        if (k >= pos)
+            return;
+        LocatorCL::MakeMatrix( *t, M_);
+        std::copy( p_.begin(), p_.end(), b_.begin());
+        b_[3]= 1.;
+        gauss_pivot( M_, b_);
+        if (LocatorCL::InTetra( b_, tol_)) {
+            pos= k;
+            tetra= t;
+            bary= b_;
+        }
+    }
+};
+
 void
 LocatorCL::Locate(LocationCL& loc, const MultiGridCL& MG, int trilevel, const Point3DCL& p, double tol)
 /// \todo this only works for triangulations of polygonal domains, which resolve the geometry of the domain exactly (on level 0).
 /// \todo this only works for FE-functions living on the finest level
 {
-    SVectorCL<4>& b= loc.Coord_;
-    SMatrixCL<4,4> M;
 #ifndef _PAR
     const Uint search_level=0;
 #else
     const Uint search_level=MG.GetLastLevel()-1;
 #endif
 
-    for (MultiGridCL::const_TetraIterator it= MG.GetTetrasBegin(search_level), theend= MG.GetTetrasEnd(search_level); it!=theend; ++it)
-    {
-        MakeMatrix(*it, M);
-        std::copy(p.begin(), p.end(), b.begin());
-        b[3]= 1.;
-        gauss_pivot(M, b);
-        if ( InTetra(b, tol) )
-        {
-            loc.Tetra_= &*it;
-            LocateInTetra(loc, MG.GetTriangTetra().StdIndex( trilevel), p, tol);
-            return;
-        }
+    Locate( loc, MG.GetTetraBoxTree( search_level), MG, trilevel, p, tol);
+}
+
+void
+LocatorCL::Locate(LocationCL& loc, const TetraBoxTreeCL& tree, const MultiGridCL& MG, int trilevel, const Point3DCL& p, double tol)
+{
+    LocateCandidateCL cand( p, tol);
+    tree.for_each_candidate( p, tol, cand);
+    if (cand.tetra != 0) {
+        loc.Tetra_= cand.tetra;
+        loc.Coord_= cand.bary;
+        LocateInTetra(loc, MG.GetTriangTetra().StdIndex( trilevel), p, tol);
+        return;
     }
-    loc.Tetra_= 0; std::fill(b.begin(), b.end(), 0.);
+    loc.Tetra_= 0; std::fill(loc.Coord_.begin(), loc.Coord_.end(), 0.);
+}
+
+void
+LocatorCL::Locate(std::vector<LocationCL>& loc, const MultiGridCL& MG, int trilevel, const std::vector<Point3DCL>& p, double tol)
+{
+#ifndef _PAR
+    const TetraBoxTreeCL& tree= MG.GetTetraBoxTree( 0);
+#else
+    const TetraBoxTreeCL& tree= MG.GetTetraBoxTree( MG.GetLastLevel()-1);
+#endif
+    loc.resize( p.size());
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#pragma omp parallel for schedule(dynamic, 64)
+    for (i= 0; i < p.size(); ++i)
+        Locate( loc[i], tree, MG, trilevel, p[i], tol);
 }
 
 void MarkAll (DROPS::MultiGridCL& mg)
@@ -1163,17 +1238,13 @@ void UnMarkAll (DROPS::MultiGridCL& mg)
      }
 }
 
-void ColorClassesCL::compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL begin,
-                                        MultiGridCL::const_TriangTetraIteratorCL end,
-                                        std::vector<TetraNumVecT>& neighbors, match_fun match, const BndCondCL& Bnd)
+void ColorClassesCL::compute_vertex_map (MultiGridCL::const_TriangTetraIteratorCL begin,
+                                         MultiGridCL::const_TriangTetraIteratorCL end,
+                                         VertexMapT& vertexMap, match_fun match, const BndCondCL& Bnd)
 {
-    const size_t num_tetra= std::distance( begin, end);
-
     typedef std::tr1::unordered_map<const VertexCL*, std::vector<const VertexCL*> > Per1MapT;
     Per1MapT per1Map;
 
-    typedef std::tr1::unordered_map<const VertexCL*, TetraNumVecT> VertexMapT;
-    VertexMapT vertexMap;
     // Collect all tetras, that have vertex v in vertexMap[v].
     for (MultiGridCL::const_TriangTetraIteratorCL sit= begin; sit != end; ++sit)
         for (int i= 0; i < 4; ++i)
@@ -1209,6 +1280,16 @@ void ColorClassesCL::compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL
             }
         }
     }
+}
+
+void ColorClassesCL::compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL begin,
+                                        MultiGridCL::const_TriangTetraIteratorCL end,
+                                        std::vector<TetraNumVecT>& neighbors, match_fun match, const BndCondCL& Bnd)
+{
+    const size_t num_tetra= std::distance( begin, end);
+
+    VertexMapT vertexMap;
+    compute_vertex_map( begin, end, vertexMap, match, Bnd);
 
     // For every tetra j, store all neighboring tetras in neighbors[j].
     typedef std::set<size_t> TetraNumSetT;
@@ -1238,6 +1319,7 @@ void ColorClassesCL::fill_pointer_arrays (
     const std::list<ColorFreqT>& color_list, const std::vector<int>& color,
     MultiGridCL::const_TriangTetraIteratorCL begin, MultiGridCL::const_TriangTetraIteratorCL end)
 {
+    colors_.clear();
     colors_.resize( color_list.size());
     for (std::list<ColorFreqT>::const_iterator it= color_list.begin(); it != color_list.end(); ++it)
         colors_[it->first].reserve( it->second);
@@ -1251,9 +1333,15 @@ void ColorClassesCL::fill_pointer_arrays (
     int j;
 #endif
     // tetra sorting for better memory access pattern
+    vertices_.resize( num_colors());
     #pragma omp parallel for
-    for (j= 0; j < num_colors(); ++j)
+    for (j= 0; j < num_colors(); ++j) {
         sort( colors_[j].begin(), colors_[j].end());
+        vertices_[j].resize( colors_[j].size());
+        for (size_t k= 0; k < colors_[j].size(); ++k)
+            for (Uint i= 0; i < 4; ++i)
+                vertices_[j][k][i]= colors_[j][k]->GetVertex( i);
+    }
 }
 
 void ColorClassesCL::compute_color_classes (MultiGridCL::const_TriangTetraIteratorCL begin,
@@ -1303,6 +1391,7 @@ void ColorClassesCL::compute_color_classes (MultiGridCL::const_TriangTetraIterat
     // Build arrays of pointers for the colors
     fill_pointer_arrays( color_frequency, color, begin, end);
     color.clear();
+    num_recolored_= num_tetra;
 
     // for (size_t j= 0; j < num_colors(); ++j)
     //     std::cout << "Color " << j << " has " << colors_[j].size() << " tetras." << std::endl;
@@ -1313,15 +1402,430 @@ void ColorClassesCL::compute_color_classes (MultiGridCL::const_TriangTetraIterat
     std::cout << "Creation of the tetra-coloring took " << duration << " seconds, " << num_colors() << " colors used." << '\n';
 }
 
+void ColorClassesCL::update_color_classes (MultiGridCL::const_TriangTetraIteratorCL begin,
+                                           MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd, size_t version)
+{
+#   ifdef _PAR
+        ParTimerCL timer;
+#   else
+        TimerCL timer;
+#   endif
+        timer.Start();
+
+    const size_t num_tetra= std::distance( begin, end);
+
+    // Old color of each tetra; a tetra is only recognized, if it has the same vertices as before
+    // (the address of a deleted tetra may have been reused).
+    typedef DROPS_STD_UNORDERED_MAP<const TetraCL*, std::pair<int, VertexTupleT> > OldColorMapT;
+    OldColorMapT old_color;
+    for (size_t c= 0; c < num_colors(); ++c)
+        for (size_t k= 0; k < colors_[c].size(); ++k)
+            old_color[colors_[c][k]]= std::make_pair( static_cast<int>( c), vertices_[c][k]);
+    const size_t old_num_colors= num_colors();
+
+    std::vector<int> color( num_tetra, -1);
+    for (size_t j= 0; j < num_tetra; ++j) {
+        const TetraCL& t= *(begin + j);
+        OldColorMapT::const_iterator it= old_color.find( &t);
+        if (it == old_color.end())
+            continue;
+        bool same= true;
+        for (Uint i= 0; i < 4; ++i)
+            same= same && it->second.second[i] == t.GetVertex( i);
+        if (same)
+            color[j]= it->second.first;
+    }
+    old_color.clear();
+
+    VertexMapT vertexMap;
+    compute_vertex_map( begin, end, vertexMap, match, Bnd);
+
+    // Resolve conflicts in the changed neighborhoods: of two neighbors with the same old color, the second is recolored.
+    for (size_t j= 0; j < num_tetra; ++j) {
+        if (color[j] < 0)
+            continue;
+        for (Uint i= 0; i < 4 && color[j] >= 0; ++i) {
+            const TetraNumVecT& tetra_nums= vertexMap[(begin + j)->GetVertex( i)];
+            for (TetraNumVecT::const_iterator n= tetra_nums.begin(); n != tetra_nums.end(); ++n)
+                if (*n < j && color[*n] == color[j]) {
+                    color[j]= -1;
+                    break;
+                }
+        }
+    }
+
+    // Color the new tetras and the tetras with conflicts: Use the least used color, which does not occur in the neighborhood.
+    std::vector<size_t> frequency( old_num_colors, 0);
+    for (size_t j= 0; j < num_tetra; ++j)
+        if (color[j] >= 0)
+            ++frequency[color[j]];
+    std::vector<size_t> used( old_num_colors, num_tetra); // used[c] == j, if color c occurs in the neighborhood of j
+    num_recolored_= 0;
+    for (size_t j= 0; j < num_tetra; ++j) {
+        if (color[j] >= 0)
+            continue;
+        for (Uint i= 0; i < 4; ++i) {
+            const TetraNumVecT& tetra_nums= vertexMap[(begin + j)->GetVertex( i)];
+            for (TetraNumVecT::const_iterator n= tetra_nums.begin(); n != tetra_nums.end(); ++n)
+                if (color[*n] >= 0)
+                    used[color[*n]]= j;
+        }
+        int best= -1;
+        for (size_t c= 0; c < frequency.size(); ++c)
+            if (used[c] != j && (best < 0 || frequency[c] < frequency[best]))
+                best= static_cast<int>( c);
+        if (best < 0) {
+            best= frequency.size();
+            frequency.push_back( 0);
+            used.push_back( num_tetra);
+        }
+        color[j]= best;
+        ++frequency[best];
+        ++num_recolored_;
+    }
+    vertexMap.clear();
+
+    // Remove empty colors
+    std::vector<int> new_color( frequency.size(), -1);
+    std::list<ColorFreqT> color_frequency;
+    for (size_t c= 0; c < frequency.size(); ++c)
+        if (frequency[c] > 0) {
+            new_color[c]= color_frequency.size();
+            color_frequency.push_back( std::make_pair( color_frequency.size(), frequency[c]));
+        }
+    for (size_t j= 0; j < num_tetra; ++j)
+        color[j]= new_color[color[j]];
+
+    fill_pointer_arrays( color_frequency, color, begin, end);
+    version_= version;
+
+    timer.Stop();
+    const double duration= timer.GetTime();
+    std::cout << "Update of the tetra-coloring took " << duration << " seconds, " << num_recolored_ << " of " << num_tetra
+              << " tetras recolored, " << num_colors() << " colors used." << '\n';
+}
+
+size_t ColorClassesCL::num_tetra () const
+{
+    size_t n= 0;
+    for (size_t c= 0; c < num_colors(); ++c)
+        n+= colors_[c].size();
+    return n;
+}
+
+size_t ColorClassesCL::min_class_size () const
+{
+    size_t n= num_colors() == 0 ? 0 : colors_[0].size();
+    for (size_t c= 1; c < num_colors(); ++c)
+        n= std::min( n, colors_[c].size());
+    return n;
+}
+
+size_t ColorClassesCL::max_class_size () const
+{
+    size_t n= 0;
+    for (size_t c= 0; c < num_colors(); ++c)
+        n= std::max( n, colors_[c].size());
+    return n;
+}
+
+std::vector<size_t> ColorClassesCL::class_size_histogram () const
+{
+    std::vector<size_t> hist;
+    for (size_t c= 0; c < num_colors(); ++c) {
+        size_t k= 0;
+        for (size_t s= colors_[c].size(); s > 1; s/= 2)
+            ++k;
+        if (hist.size() <= k)
+            hist.resize( k + 1, 0);
+        ++hist[k];
+    }
+    return hist;
+}
+
+void ColorClassesCL::WriteStatistics (std::ostream& os) const
+{
+    os << "Tetra-coloring: " << num_tetra() << " tetras, " << num_colors() << " colors, class sizes in ["
+       << min_class_size() << ", " << max_class_size() << "], " << num_recolored() << " tetras colored by the last update.\n"
+       << "Histogram of the class sizes:\n";
+    const std::vector<size_t> hist= class_size_histogram();
+    for (size_t k= 0; k < hist.size(); ++k)
+        if (hist[k] > 0)
+            os << "  [" << (1ul << k) << ", " << (2ul << k) << "): " << hist[k] << " colors\n";
+}
+
 const ColorClassesCL& MultiGridCL::GetColorClasses (int Level, match_fun match, const BndCondCL& Bnd) const
 {
     if (Level < 0)
         Level+= GetNumLevel();
 
-    if (colors_.find( Level) == colors_.end())
-        colors_[Level]= new ColorClassesCL( GetTriangTetraBegin( Level), GetTriangTetraEnd( Level), match, Bnd);
+    std::map<int, ColorClassesCL*>::iterator it= colors_.find( Level);
+    if (it == colors_.end()) {
+        // The unrefined tetras of a coarser triangulation belong to this triangulation, too: Start with a copy of its color classes.
+        std::map<int, ColorClassesCL*>::iterator coarser= colors_.lower_bound( Level);
+        if (coarser == colors_.begin())
+            it= colors_.insert( std::make_pair( Level,
+                new ColorClassesCL( GetTriangTetraBegin( Level), GetTriangTetraEnd( Level), match, Bnd, version_))).first;
+        else {
+            it= colors_.insert( std::make_pair( Level, new ColorClassesCL( *(--coarser)->second))).first;
+            it->second->Outdate();
+        }
+    }
+    if (it->second->GetVersion() != version_)
+        it->second->update_color_classes( GetTriangTetraBegin( Level), GetTriangTetraEnd( Level), match, Bnd, version_);
+
+    return *it->second;
+}
+
+/// \brief Orders barycenters by their coordinate dir; used by TriangPartitionCL::bisect.
+class CoordLessCL
+{
+  private:
+    Uint dir_;
+
+  public:
+    CoordLessCL (Uint dir) : dir_( dir) {}
+    bool operator() (const std::pair<Point3DCL, const TetraCL*>& a, const std::pair<Point3DCL, const TetraCL*>& b) const
+        { return a.first[dir_] < b.first[dir_]; }
+};
+
+void TriangPartitionCL::bisect (CenterVecT& t, size_t begin, size_t end, size_t first_part, size_t num_parts, std::vector<size_t>& part_begin)
+{
+    if (num_parts == 1) {
+        part_begin[first_part]= begin;
+        return;
+    }
+    Point3DCL lo( std::numeric_limits<double>::max()), hi( -std::numeric_limits<double>::max());
+    for (size_t j= begin; j < end; ++j)
+        for (Uint i= 0; i < 3; ++i) {
+            lo[i]= std::min( lo[i], t[j].first[i]);
+            hi[i]= std::max( hi[i], t[j].first[i]);
+        }
+    Uint dir= 0;
+    for (Uint i= 1; i < 3; ++i)
+        if (hi[i] - lo[i] > hi[dir] - lo[dir])
+            dir= i;
+
+    const size_t num_left= num_parts/2,
+                 mid= begin + (end - begin)*num_left/num_parts;
+    std::nth_element( t.begin() + begin, t.begin() + mid, t.begin() + end, CoordLessCL( dir));
+    bisect( t, begin, mid, first_part,            num_left,             part_begin);
+    bisect( t, mid,   end, first_part + num_left, num_parts - num_left, part_begin);
+}
+
+TriangPartitionCL::TriangPartitionCL (MultiGridCL::const_TriangTetraIteratorCL begin,
+    MultiGridCL::const_TriangTetraIteratorCL end, size_t num_parts, match_fun match, const BndCondCL& Bnd, size_t version)
+    : interior_( std::max( num_parts, size_t( 1))), separator_( 0), version_( version)
+{
+#   ifdef _PAR
+        ParTimerCL timer;
+#   else
+        TimerCL timer;
+#   endif
+        timer.Start();
+
+    const size_t num_tetra= std::distance( begin, end);
+    num_parts= interior_.size();
+
+    // Split the tetras into spatially compact parts of equal size.
+    CenterVecT t( num_tetra);
+    for (size_t j= 0; j < num_tetra; ++j)
+        t[j]= std::make_pair( GetBaryCenter( begin[j]), &begin[j]);
+    std::vector<size_t> part_begin( num_parts + 1, num_tetra);
+    bisect( t, 0, num_tetra, 0, num_parts, part_begin);
+
+    // Determine the part of each vertex; -1 marks vertices shared by several parts and, in case of periodic boundaries,
+    // vertices on the periodic boundary, as their unknowns are shared with other vertices.
+    typedef DROPS_STD_UNORDERED_MAP<const VertexCL*, int> VertexPartMapT;
+    VertexPartMapT vertex_part;
+    for (size_t p= 0; p < num_parts; ++p)
+        for (size_t j= part_begin[p]; j < part_begin[p + 1]; ++j)
+            for (Uint i= 0; i < 4; ++i) {
+                const VertexCL* v= t[j].second->GetVertex( i);
+                const std::pair<VertexPartMapT::iterator, bool> ins= vertex_part.insert( std::make_pair( v, static_cast<int>( p)));
+                if (!ins.second && ins.first->second != static_cast<int>( p))
+                    ins.first->second= -1;
+                else if (ins.second && match != 0 && (Bnd.GetBC( *v) == Per1BC || Bnd.GetBC( *v) == Per2BC))
+                    ins.first->second= -1;
+            }
+
+    // Collect the interior tetras of each part and the separator tetras.
+    std::vector<const TetraCL*> separator;
+    for (size_t p= 0; p < num_parts; ++p)
+        for (size_t j= part_begin[p]; j < part_begin[p + 1]; ++j) {
+            bool is_interior= true;
+            for (Uint i= 0; i < 4 && is_interior; ++i)
+                is_interior= vertex_part[t[j].second->GetVertex( i)] == static_cast<int>( p);
+            if (is_interior)
+                interior_[p].push_back( t[j].second);
+            else
+                separator.push_back( t[j].second);
+        }
+    t.clear();
+    // Restore the order of the triangulation in each sequence.
+    for (size_t p= 0; p < num_parts; ++p)
+        std::sort( interior_[p].begin(), interior_[p].end());
+    std::sort( separator.begin(), separator.end());
 
-    return *colors_[Level];
+    const TetraCL** sep_begin= separator.empty() ? 0 : &separator[0];
+    separator_= new ColorClassesCL( MultiGridCL::const_TriangTetraIteratorCL( sep_begin),
+                                    MultiGridCL::const_TriangTetraIteratorCL( sep_begin + separator.size()), match, Bnd);
+
+    timer.Stop();
+    std::cout << "Creation of the tetra-partition took " << timer.GetTime() << " seconds, " << num_parts << " parts, "
+              << num_separator() << " of " << num_tetra << " tetras in the separator." << '\n';
+}
+
+TriangPartitionCL::~TriangPartitionCL ()
+{
+    delete separator_;
+}
+
+size_t TriangPartitionCL::num_interior () const
+{
+    size_t n= 0;
+    for (size_t p= 0; p < num_parts(); ++p)
+        n+= interior_[p].size();
+    return n;
+}
+
+void TriangPartitionCL::WriteStatistics (std::ostream& os) const
+{
+    size_t min_size= num_parts() == 0 ? 0 : interior_[0].size(),
+           max_size= 0;
+    for (size_t p= 0; p < num_parts(); ++p) {
+        min_size= std::min( min_size, interior_[p].size());
+        max_size= std::max( max_size, interior_[p].size());
+    }
+    os << "Tetra-partition: " << num_parts() << " parts with " << num_interior() << " interior tetras, part sizes in ["
+       << min_size << ", " << max_size << "], " << num_separator() << " separator tetras in "
+       << separator_->num_colors() << " colors.\n";
+}
+
+const TriangPartitionCL& MultiGridCL::GetTriangPartition (int Level, match_fun match, const BndCondCL& Bnd, size_t num_parts) const
+{
+    if (Level < 0)
+        Level+= GetNumLevel();
+
+    TriangPartitionCL*& part= partitions_[Level];
+    if (part != 0 && (part->GetVersion() != version_ || part->num_parts() != num_parts)) {
+        delete part;
+        part= 0;
+    }
+    if (part == 0)
+        part= new TriangPartitionCL( GetTriangTetraBegin( Level), GetTriangTetraEnd( Level), num_parts, match, Bnd, version_);
+
+    return *part;
+}
+
+const TetraBoxTreeCL& MultiGridCL::GetTetraBoxTree (Uint Level) const
+{
+    const TetraBoxTreeCL* tree;
+#pragma omp critical(GetTetraBoxTree)
+    {
+        if (boxtree_ == 0 || boxtree_->GetVersion() != version_ || boxtree_->GetLevel() != Level) {
+            delete boxtree_;
+            boxtree_= new TetraBoxTreeCL( *this, Level);
+        }
+        tree= boxtree_;
+    }
+    return *tree;
+}
+
+/// \brief Orders the positions of barycenters by their coordinate dir; used by TetraBoxTreeCL::build.
+class CenterLessCL
+{
+  private:
+    const std::vector<Point3DCL>& center_;
+    Uint dir_;
+
+  public:
+    CenterLessCL (const std::vector<Point3DCL>& center, Uint dir) : center_( center), dir_( dir) {}
+    bool operator() (size_t a, size_t b) const { return center_[a][dir_] < center_[b][dir_]; }
+};
+
+TetraBoxTreeCL::TetraBoxTreeCL (const MultiGridCL& mg, Uint level)
+    : max_diam_( 0.), level_( level), version_( mg.GetVersion())
+{
+    for (MultiGridCL::const_TetraIterator it= mg.GetTetrasBegin( level), end= mg.GetTetrasEnd( level); it != end; ++it)
+        tetras_.push_back( &*it);
+    const size_t n= tetras_.size();
+    if (n == 0)
+        return;
+
+    pos_.resize( n);
+    std::vector<Point3DCL> center( n);
+    for (size_t k= 0; k < n; ++k) {
+        pos_[k]= k;
+        center[k]= GetBaryCenter( *tetras_[k]);
+    }
+    nodes_.reserve( 2*n/LeafSize + 1);
+    nodes_.resize( 1);
+    build( center, 0, 0, n, 0);
+
+    // Apply the permutation of the positions to the tetras and compute their bounding boxes.
+    TetraSeqT tmp( tetras_);
+    lo_.resize( n);
+    hi_.resize( n);
+    for (size_t k= 0; k < n; ++k) {
+        tetras_[k]= tmp[pos_[k]];
+        lo_[k]= hi_[k]= tetras_[k]->GetVertex( 0)->GetCoord();
+        for (Uint v= 1; v < 4; ++v)
+            for (Uint i= 0; i < 3; ++i) {
+                lo_[k][i]= std::min( lo_[k][i], tetras_[k]->GetVertex( v)->GetCoord()[i]);
+                hi_[k][i]= std::max( hi_[k][i], tetras_[k]->GetVertex( v)->GetCoord()[i]);
+            }
+        for (Uint i= 0; i < 3; ++i)
+            max_diam_= std::max( max_diam_, hi_[k][i] - lo_[k][i]);
+    }
+    // Compute the bounding boxes of the nodes bottom-up; children are always stored after their parent.
+    for (size_t j= nodes_.size(); j-- > 0;) {
+        NodeT& node= nodes_[j];
+        if (node.child != 0) {
+            const NodeT& l= nodes_[node.child], & r= nodes_[node.child + 1];
+            for (Uint i= 0; i < 3; ++i) {
+                node.lo[i]= std::min( l.lo[i], r.lo[i]);
+                node.hi[i]= std::max( l.hi[i], r.hi[i]);
+            }
+        }
+        else {
+            node.lo= lo_[node.begin];
+            node.hi= hi_[node.begin];
+            for (size_t k= node.begin + 1; k < node.end; ++k)
+                for (Uint i= 0; i < 3; ++i) {
+                    node.lo[i]= std::min( node.lo[i], lo_[k][i]);
+                    node.hi[i]= std::max( node.hi[i], hi_[k][i]);
+                }
+        }
+    }
+}
+
+void TetraBoxTreeCL::build (std::vector<Point3DCL>& center, size_t node, size_t begin, size_t end, size_t depth)
+{
+    nodes_[node].begin= begin;
+    nodes_[node].end=   end;
+    nodes_[node].child= 0;
+    if (end - begin <= LeafSize || depth == MaxDepth)
+        return;
+
+    Point3DCL lo( std::numeric_limits<double>::max()), hi( -std::numeric_limits<double>::max());
+    for (size_t k= begin; k < end; ++k)
+        for (Uint i= 0; i < 3; ++i) {
+            lo[i]= std::min( lo[i], center[pos_[k]][i]);
+            hi[i]= std::max( hi[i], center[pos_[k]][i]);
+        }
+    Uint dir= 0;
+    for (Uint i= 1; i < 3; ++i)
+        if (hi[i] - lo[i] > hi[dir] - lo[dir])
+            dir= i;
+
+    const size_t mid= begin + (end - begin)/2;
+    std::nth_element( pos_.begin() + begin, pos_.begin() + mid, pos_.begin() + end, CenterLessCL( center, dir));
+    const size_t child= nodes_.size();
+    nodes_[node].child= child;
+    nodes_.resize( child + 2);
+    build( center, child,     begin, mid, depth + 1);
+    build( center, child + 1, mid,   end, depth + 1);
 }
 
 void read_PeriodicBoundaries (MultiGridCL& mg, const ParamCL& P)
@@ -152,6 +152,8 @@ class InfoCL;
 #endif
 
 class ColorClassesCL; ///< forward declaration of the partitioning of the tetras in a triangulation into color classes
+class TriangPartitionCL; ///< forward declaration of the partitioning of the tetras in a triangulation into spatially compact parts
+class TetraBoxTreeCL; ///< forward declaration of the search tree of the bounding boxes of the tetras
 
 class MultiGridCL
 {
@@ -208,7 +210,12 @@ class MultiGridCL
     SimplexFactoryCL factory_;                      ///< factory for generating simplices
     MeshDeformationCL* MeshDeform_;
 
-    mutable std::map<int, ColorClassesCL*> colors_; // map: level -> Color-classes of the tetra for that level
+    mutable std::map<int, ColorClassesCL*> colors_; // map: level -> Color-classes of the tetra for that level; outdated color classes are updated incrementally by GetColorClasses
+    mutable std::map<int, TriangPartitionCL*> partitions_; // map: level -> partition of the tetras for that level; recomputed after each modification
+    mutable TetraBoxTreeCL* boxtree_;               ///< search tree for LocatorCL; recomputed after each modification
+    void DeleteColorClasses ();
+    void DeletePartitions ();
+    void DeleteBoxTree ();
 
 #ifdef _PAR
     bool killedGhostTetra_;                         // are there ghost tetras, that are marked for removement
@@ -236,6 +243,9 @@ class MultiGridCL
 
     ~MultiGridCL()
     { 
+        DeleteColorClasses();
+        DeletePartitions();
+        DeleteBoxTree();
 #ifdef _PAR            
         DiST::InfoCL::Instance().Destroy();
 #endif 
@@ -330,7 +340,16 @@ class MultiGridCL
     void MakeConsistentHashes();
 #endif
 
+    ///\brief Color classes of the tetras of the triangulation of the given level.
+    /// They are computed on the first call; after a modification of the multigrid, only tetras, which are new or whose neighborhood changed, are recolored.
     const ColorClassesCL& GetColorClasses (int Level, match_fun match, const BndCondCL& Bnd) const;
+    ///\brief Partition of the tetras of the triangulation of the given level into num_parts parts.
+    /// It is recomputed after a modification of the multigrid or if num_parts changes.
+    const TriangPartitionCL& GetTriangPartition (int Level, match_fun match, const BndCondCL& Bnd, size_t num_parts) const;
+    ///\brief Search tree of the bounding boxes of the tetras of the given level, which is used by LocatorCL::Locate.
+    /// It is recomputed after a modification of the multigrid. Thread-safe, if the multigrid is not modified concurrently
+    /// and all concurrent callers ask for the same level.
+    const TetraBoxTreeCL& GetTetraBoxTree (Uint Level) const;
 
     bool IsSane (std::ostream&, int Level=-1) const;
 };
@@ -370,6 +389,10 @@ class PeriodicEdgesCL
 };
 
 /// \brief Storage of independent set of tetrahedra for assembling
+///
+/// Tetras of the same color share no vertex. After a modification of the triangulation, update_color_classes keeps
+/// the colors of all tetras, which still exist with the same vertices, and recolors only the new tetras and tetras with
+/// a conflict in their changed neighborhood.
 class ColorClassesCL
 {
   public:
@@ -377,11 +400,20 @@ class ColorClassesCL
     typedef std::vector<ColorClassT>::const_iterator const_iterator;
 
   private:
+    typedef SArrayCL<const VertexCL*, 4> VertexTupleT;
+
     std::vector<ColorClassT> colors_;
+    std::vector<std::vector<VertexTupleT> > vertices_; ///< vertices_[c][k] are the vertices of colors_[c][k]; used to recognize the tetras after a modification
+    size_t version_;      ///< version of the multigrid, for which the color classes were computed
+    size_t num_recolored_; ///< number of tetras colored by the last call of compute_color_classes or update_color_classes
 
     typedef std::vector<size_t> TetraNumVecT;
     typedef std::pair<size_t, size_t> ColorFreqT;
+    typedef DROPS_STD_UNORDERED_MAP<const VertexCL*, TetraNumVecT> VertexMapT;
 
+    void compute_vertex_map (MultiGridCL::const_TriangTetraIteratorCL begin,
+                             MultiGridCL::const_TriangTetraIteratorCL end,
+                             VertexMapT& vertexMap, match_fun match, const BndCondCL& Bnd);
     void compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL begin,
                             MultiGridCL::const_TriangTetraIteratorCL end,
                             std::vector<TetraNumVecT>& neighbors, match_fun match, const BndCondCL& Bnd);
@@ -392,15 +424,79 @@ class ColorClassesCL
 
   public:
     ColorClassesCL (MultiGridCL::const_TriangTetraIteratorCL begin,
-                    MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd)
+                    MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd, size_t version= 0)
+        : version_( version), num_recolored_( 0)
     { compute_color_classes( begin, end, match, Bnd); }
 
     void compute_color_classes (MultiGridCL::const_TriangTetraIteratorCL begin,
                                 MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd);
+    ///\brief Adapt the color classes to the modified triangulation [begin, end) of the multigrid with the given version.
+    void update_color_classes (MultiGridCL::const_TriangTetraIteratorCL begin,
+                               MultiGridCL::const_TriangTetraIteratorCL end, match_fun match, const BndCondCL& Bnd, size_t version);
 
     size_t num_colors () const { return colors_.size(); }
     const_iterator begin () const { return colors_.begin(); }
     const_iterator end   () const { return colors_.end(); }
+
+    /// \name Version of the multigrid, for which the color classes were computed
+    //@{
+    size_t GetVersion () const { return version_; }
+    void   Outdate    ()       { version_= static_cast<size_t>( -1); } ///< The triangulation has changed without a new version of the multigrid.
+    //@}
+
+    /// \name Statistics
+    //@{
+    size_t num_tetra     () const;                                  ///< number of colored tetras
+    size_t num_recolored () const { return num_recolored_; }        ///< number of tetras colored by the last (re)computation
+    size_t min_class_size () const;
+    size_t max_class_size () const;
+    /// \brief hist[k] is the number of colors with a class size in [2^k, 2^(k+1)); empty classes do not occur.
+    std::vector<size_t> class_size_histogram () const;
+    void WriteStatistics (std::ostream&) const;
+    //@}
+};
+
+/// \brief Partition of the tetras of a triangulation for the OpenMP-parallel accumulation in a single parallel region.
+///
+/// The tetras are split by recursive coordinate bisection of their barycenters into num_parts() parts of equal size.
+/// A tetra is interior, if all tetras sharing a vertex with it belong to the same part. Interior tetras of different
+/// parts do not share unknowns and can be visited concurrently. The remaining separator tetras, i.e. tetras with a
+/// vertex shared by several parts or on a periodic boundary, are distributed to color classes.
+class TriangPartitionCL
+{
+  public:
+    typedef ColorClassesCL::ColorClassT TetraSeqT;
+
+  private:
+    std::vector<TetraSeqT> interior_;  ///< interior_[p] are the interior tetras of part p
+    ColorClassesCL*        separator_; ///< color classes of the separator tetras
+    size_t                 version_;   ///< version of the multigrid, for which the partition was computed
+
+    typedef std::vector<std::pair<Point3DCL, const TetraCL*> > CenterVecT;
+    /// \brief Reorders t[begin, end) recursively into num_parts contiguous parts by splitting along the longest extent of the barycenters.
+    /// part_begin[first_part + i] receives the first position of part first_part + i.
+    void bisect (CenterVecT& t, size_t begin, size_t end, size_t first_part, size_t num_parts, std::vector<size_t>& part_begin);
+
+    TriangPartitionCL (const TriangPartitionCL&);            // not defined
+    TriangPartitionCL& operator= (const TriangPartitionCL&); // not defined
+
+  public:
+    TriangPartitionCL (MultiGridCL::const_TriangTetraIteratorCL begin,
+                      MultiGridCL::const_TriangTetraIteratorCL end, size_t num_parts, match_fun match, const BndCondCL& Bnd, size_t version= 0);
+    ~TriangPartitionCL ();
+
+    size_t num_parts () const { return interior_.size(); }
+    const TetraSeqT&      interior  (size_t p) const { return interior_[p]; }
+    const ColorClassesCL& separator ()         const { return *separator_; }
+
+    size_t GetVersion () const { return version_; }
+
+    /// \name Statistics
+    //@{
+    size_t num_interior  () const; ///< number of interior tetras of all parts
+    size_t num_separator () const { return separator_->num_tetra(); }
+    void WriteStatistics (std::ostream&) const;
+    //@}
 };
 
 
@@ -519,6 +615,8 @@ class LocationCL
         : Tetra_(t), Coord_(p) {}
     LocationCL(const LocationCL& loc)
         : Tetra_(loc.Tetra_), Coord_(loc.Coord_) {}
+    LocationCL& operator=(const LocationCL& loc)
+        { Tetra_= loc.Tetra_; Coord_= loc.Coord_; return *this; }
 
 #ifndef _PAR
     bool IsValid() const                        ///< Check if the tetrahedra is set
@@ -535,10 +633,66 @@ class LocationCL
     friend class LocatorCL;
 };
 
+/// \brief Bounding volume hierarchy of the axis-aligned bounding boxes of the tetras of one level of the multigrid.
+///
+/// The tree is built by recursive bisection of the barycenters along the longest extent. It provides the tetras,
+/// whose bounding box contains a given point, in O(log n) instead of testing all tetras of the level. The tetras are
+/// identified by their position in the sequence of the level, from which the tree was built.
+class TetraBoxTreeCL
+{
+  public:
+    typedef std::vector<const TetraCL*> TetraSeqT;
+
+  private:
+    struct NodeT
+    {
+        Point3DCL lo, hi;   ///< bounding box of all tetras of the subtree
+        size_t begin, end;  ///< range of tetras_ in the subtree
+        size_t child;       ///< index of the first child; the second child follows; 0 for leaves
+    };
+
+    static const size_t LeafSize= 4;
+    static const size_t MaxDepth= 64;
+
+    std::vector<NodeT>     nodes_;
+    TetraSeqT              tetras_;   ///< tetras in the order of the leaves
+    std::vector<size_t>    pos_;      ///< pos_[k] is the position of tetras_[k] in the level
+    std::vector<Point3DCL> lo_, hi_;  ///< bounding boxes of tetras_
+    double                 max_diam_; ///< maximal extent of the bounding box of a tetra
+    Uint                   level_;
+    size_t                 version_;  ///< version of the multigrid, for which the tree was built
+
+    /// \brief Splits the range [begin, end) of pos_ of the given node at the median of the barycenters along their longest extent.
+    void build (std::vector<Point3DCL>& center, size_t node, size_t begin, size_t end, size_t depth);
+
+    static bool contains (const Point3DCL& lo, const Point3DCL& hi, const Point3DCL& p, double eps)
+        { return p[0] >= lo[0] - eps && p[0] <= hi[0] + eps
+              && p[1] >= lo[1] - eps && p[1] <= hi[1] + eps
+              && p[2] >= lo[2] - eps && p[2] <= hi[2] + eps; }
+
+    TetraBoxTreeCL (const TetraBoxTreeCL&);            // not defined
+    TetraBoxTreeCL& operator= (const TetraBoxTreeCL&); // not defined
+
+  public:
+    TetraBoxTreeCL (const MultiGridCL& mg, Uint level);
+
+    Uint   GetLevel   () const { return level_; }
+    size_t GetVersion () const { return version_; }
+    size_t num_tetra  () const { return tetras_.size(); }
+    size_t num_nodes  () const { return nodes_.size(); }
+
+    /// \brief Calls f( pos, t) for all tetras t, whose bounding box contains p; pos is the position of t in the level.
+    /// The boxes are enlarged by 2*tol times the maximal tetra diameter, where tol is the relative tolerance of the barycentric coordinates.
+    template <class FunT>
+    void for_each_candidate (const Point3DCL& p, double tol, FunT& f) const;
+};
+
 /// \brief Find a tetrahedra that surrounds a given Point
 class LocatorCL
 {
   private:
+    friend class LocateCandidateCL;
+
     static bool InTetra(const SVectorCL<4>& b, double tol= 0)
         { return b[0] >= -tol && b[0] <= 1.+tol
               && b[1] >= -tol && b[1] <= 1.+tol
@@ -555,6 +709,10 @@ class LocatorCL
         }
     }
 
+    /// \brief Find the tetrahedra that surounds a point with the search tree of the multigrid
+    static void
+    Locate(LocationCL&, const TetraBoxTreeCL&, const MultiGridCL& MG, int, const Point3DCL&, double tol);
+
   public:
     // default ctor, copy-ctor, dtor, assignment-op
 
@@ -564,9 +722,37 @@ class LocatorCL
     /// \brief Find the tetrahedra that surounds a point
     static void
     Locate(LocationCL&, const MultiGridCL& MG, int, const Point3DCL&, double tol= 1e-14);
+    /// \brief Find the tetrahedra that surround the points p; the search is OpenMP-parallel.
+    static void
+    Locate(std::vector<LocationCL>& loc, const MultiGridCL& MG, int, const std::vector<Point3DCL>& p, double tol= 1e-14);
 };
 // inline functions
 
+template <class FunT>
+  void
+  TetraBoxTreeCL::for_each_candidate (const Point3DCL& p, double tol, FunT& f) const
+{
+    if (nodes_.empty())
+        return;
+    const double eps= 2.*tol*max_diam_;
+    size_t stack[MaxDepth + 1];
+    size_t top= 0;
+    stack[top++]= 0;
+    while (top > 0) {
+        const NodeT& n= nodes_[stack[--top]];
+        if (!contains( n.lo, n.hi, p, eps))
+            continue;
+        if (n.child != 0) {
+            stack[top++]= n.child + 1;
+            stack[top++]= n.child;
+        }
+        else
+            for (size_t k= n.begin; k < n.end; ++k)
+                if (contains( lo_[k], hi_[k], p, eps))
+                    f( pos_[k], tetras_[k]);
+    }
+}
+
 template <class SimplexT>
   TriangCL<SimplexT>::TriangCL (MultiGridCL& mg)
       : triang_( mg.GetNumLevel()), mg_( mg)
@@ -657,6 +843,45 @@ inline void GetTrafoTr( SMatrixCL<3,3>& T, double& det, const TetraCL& t)
     T(2,2)= (M[0][0]*M[1][1] - M[1][0]*M[0][1])/det;
 }
 
+/// \brief Number of tetras in a block of the batched accumulation, see AccumulatorCL::visit_block.
+const Uint TetraBlockSizeC= 8;
+
+/// \brief GetTrafoTr for the tetras t[0], ..., t[n-1], n <= TetraBlockSizeC, in structure-of-arrays layout: T[i][j][l] and det[l] belong to t[l].
+///
+/// The loops over the tetras of the block are independent and vectorize. The entries l >= n are those of the reference tetra.
+inline void GetTrafoTr (double T[3][3][TetraBlockSizeC], double det[TetraBlockSizeC], const TetraCL* const* t, Uint n)
+{
+    double M[3][3][TetraBlockSizeC];
+    for (Uint l= 0; l < TetraBlockSizeC; ++l) {
+        if (l < n) {
+            const Point3DCL& pt0= t[l]->GetVertex(0)->GetCoord();
+            for (int i= 0; i < 3; ++i) {
+                const Point3DCL& pt= t[l]->GetVertex(i+1)->GetCoord();
+                for (int j= 0; j < 3; ++j)
+                    M[j][i][l]= pt[j] - pt0[j];
+            }
+        }
+        else
+            for (int i= 0; i < 3; ++i)
+                for (int j= 0; j < 3; ++j)
+                    M[j][i][l]= i == j ? 1. : 0.;
+    }
+    for (Uint l= 0; l < TetraBlockSizeC; ++l) {
+        det[l]=   M[0][0][l] * (M[1][1][l]*M[2][2][l] - M[1][2][l]*M[2][1][l])
+                - M[0][1][l] * (M[1][0][l]*M[2][2][l] - M[1][2][l]*M[2][0][l])
+                + M[0][2][l] * (M[1][0][l]*M[2][1][l] - M[1][1][l]*M[2][0][l]);
+
+        T[0][0][l]= (M[1][1][l]*M[2][2][l] - M[1][2][l]*M[2][1][l])/det[l];
+        T[0][1][l]= (M[2][0][l]*M[1][2][l] - M[1][0][l]*M[2][2][l])/det[l];
+        T[0][2][l]= (M[1][0][l]*M[2][1][l] - M[2][0][l]*M[1][1][l])/det[l];
+        T[1][0][l]= (M[2][1][l]*M[0][2][l] - M[0][1][l]*M[2][2][l])/det[l];
+        T[1][1][l]= (M[0][0][l]*M[2][2][l] - M[2][0][l]*M[0][2][l])/det[l];
+        T[1][2][l]= (M[2][0][l]*M[0][1][l] - M[0][0][l]*M[2][1][l])/det[l];
+        T[2][0][l]= (M[0][1][l]*M[1][2][l] - M[1][1][l]*M[0][2][l])/det[l];
+        T[2][1][l]= (M[1][0][l]*M[0][2][l] - M[0][0][l]*M[1][2][l])/det[l];
+        T[2][2][l]= (M[0][0][l]*M[1][1][l] - M[1][0][l]*M[0][1][l])/det[l];
+    }
+}
 
 void MarkAll (MultiGridCL&);
 void UnMarkAll (MultiGridCL&);
@@ -55,11 +55,11 @@ class EdgeCL;
 class FaceCL;
 class TetraCL;
 
-// Containers for storage of the simplices
-typedef GlobalListCL<VertexCL> MG_VertexContT;
-typedef GlobalListCL<EdgeCL>   MG_EdgeContT;
-typedef GlobalListCL<FaceCL>   MG_FaceContT;
-typedef GlobalListCL<TetraCL>  MG_TetraContT;
+// Containers for storage of the simplices; simplices, which are created one after another, are adjacent in memory.
+typedef GlobalListCL<VertexCL, PoolAllocatorCL<VertexCL> > MG_VertexContT;
+typedef GlobalListCL<EdgeCL,   PoolAllocatorCL<EdgeCL> >   MG_EdgeContT;
+typedef GlobalListCL<FaceCL,   PoolAllocatorCL<FaceCL> >   MG_FaceContT;
+typedef GlobalListCL<TetraCL,  PoolAllocatorCL<TetraCL> >  MG_TetraContT;
 
 
 //**************************************************************************
@@ -684,11 +684,14 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int max
     ExchangeCL& ExVel  = Stokes_.v.RowIdx->GetEx();
 #endif
     double res_u = 0.0;
+    int iterNS= 0, numFP= 0; // iterations of the Navier-Stokes solver in this step
     for (int i=0; i<maxFPiter; ++i)
     {
         std::cout << "~~~~~~~~~~~~~~~~ FP-Iter " << i+1 << '\n';
         const VectorCL v( Stokes_.v.Data);
         EvalLsetNavStokesEquations();
+        iterNS+= solver_.GetIter();
+        ++numFP;
         if (solver_.GetIter()==0 && lsetsolver_.GetResid()<lsetsolver_.GetTol()) // no change of vel -> no change of Phi
         {
             std::cout << "Convergence after " << i+1 << " fixed point iterations!" << std::endl;
@@ -714,6 +717,9 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int max
             break;
         }
     }
+    if (numFP > 0)
+        std::cout << "Solving NavierStokes: " << iterNS << " iterations in " << numFP << " fixed point iterations, "
+                  << double( iterNS)/numFP << " per solve\n";
     CommitStep();
 }
 
@@ -735,6 +741,9 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::Update()
 
     rhs_.resize   ( vidx->NumUnknowns());
     ls_rhs_.resize( LvlSet_.idx.NumUnknowns());
+
+    // The numbering has changed, thus, directions recycled by the solver are meaningless.
+    solver_.ClearRecycleSpace();
 }
 
 // ==============================================
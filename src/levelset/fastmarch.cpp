@@ -123,6 +123,19 @@ void ReparamDataCL::InitCoord()
     }
 }
 
+/** Called by the propagation methods, which stop at the boundary of the narrow band. This does nothing, if no band is used.*/
+void ReparamDataCL::ClampToBand()
+{
+    if (band < 0.)
+        return;
+#pragma omp parallel for
+    for ( int dof=0; dof<(int)phi.Data.size(); ++dof)
+        if ( typ[dof]==Close)
+            phi.Data[dof]= std::min( phi.Data[dof], band);
+        else if ( typ[dof]!=Finished)
+            phi.Data[dof]= band;
+}
+
 /** Each call magnifies perDir.size() by a factor of 3. After appending all directions \f$ d_1,\ldots, d_k\f$,
  *  perDir will contain all points \f$ x=\sum_{i=1}^k\sum_{\alpha_i\in\{-1,0,+1\}}\alpha_i d_i\f$.
  */
@@ -157,14 +170,17 @@ InitZeroCL::~InitZeroCL()
 */
 void InitZeroNoModCL::Perform()
 {
-    InterfaceTriangleCL patch;                              // check for intersection
-    LocalNumbP2CL       n;                                  // local numbering of dof
     const RefRuleCL    RegRef= GetRefRule( RegRefRuleC);    // determine regular children
     const int lvl= base::data_.phi.GetLevel();
+    // The list of tetras of the triangulation is created on first use, so it is fetched before the parallel loop.
+    const MultiGridCL::TriangTetraIteratorCL begin= data_.mg.GetTriangTetraBegin(lvl);
+    const int num_tetra= std::distance( begin, data_.mg.GetTriangTetraEnd(lvl));
 
 #pragma omp parallel for
-    for ( int i=0; i<std::distance(data_.mg.GetTriangTetraBegin(lvl), data_.mg.GetTriangTetraEnd(lvl)); ++i ){
-        MultiGridCL::TriangTetraIteratorCL it= data_.mg.GetTriangTetraBegin(lvl)+i;
+    for ( int i=0; i<num_tetra; ++i ){
+        InterfaceTriangleCL patch;                              // check for intersection
+        LocalNumbP2CL       n;                                  // local numbering of dof
+        MultiGridCL::TriangTetraIteratorCL it= begin+i;
         patch.Init( *it, base::data_.phi, *base::data_.bnd);
         if ( patch.Intersects()){                                       // tetra (*it) is intersected
             n.assign( *it, *base::data_.phi.RowIdx, BndDataCL<>(0));    // create local numbering
@@ -175,15 +191,17 @@ void InitZeroNoModCL::Perform()
                     for ( int vert=0; vert<4; ++vert){
                         IdxT dof= data_.Map( n.num[ data.Vertices[vert]]);
 #pragma omp critical
-{
                         base::data_.typ[ dof]= data_.Finished;
-                        base::data_.phi.Data[ dof]= std::abs(base::data_.phi.Data[ dof]);
-}
                     }
                 }
             }
         }
     }
+    // Other threads read phi for the intersection test, so the values are changed afterwards.
+#pragma omp parallel for
+    for ( int dof=0; dof<(int)data_.phi.Data.size(); ++dof)
+        if ( base::data_.typ[ dof]==data_.Finished)
+            base::data_.phi.Data[ dof]= std::abs(base::data_.phi.Data[ dof]);
 }
 
 // I N I T  Z E R O  E X A C T  C L
@@ -1103,7 +1121,7 @@ void FastmarchingCL::DetermineDistances()
 #endif
     IdxT next;
 
-    while ( !close_.empty()) {
+    while ( !close_.empty() && data_.InBand( close_.Nearest().first)) {
 #ifdef COUNTMEM
         elemClose= std::max( elemClose, close_.size());
 #endif
@@ -1121,6 +1139,7 @@ void FastmarchingCL::DetermineDistances()
         }
         neigh_[next].clear(); // will not be needed anymore
     }
+    data_.ClampToBand();
 
 #ifdef COUNTMEM
     usedMem_=  elemClose*memPerClose                // elements in close
@@ -1143,6 +1162,274 @@ void FastmarchingCL::Perform()
     DetermineDistances();
 }
 
+// H E A P  F A S T M A R C H I N G  C L
+//--------------------------------------
+
+const size_t HeapFastmarchingCL::CloseHeapCL::Arity;
+
+void HeapFastmarchingCL::CloseHeapCL::push (const DistIdxT& a)
+{
+    size_t p= heap_.size();
+    heap_.push_back( a);
+    while (p > 0) {
+        const size_t parent= (p - 1)/Arity;
+        if (!(a < heap_[parent]))
+            break;
+        heap_[p]= heap_[parent];
+        p= parent;
+    }
+    heap_[p]= a;
+}
+
+HeapFastmarchingCL::DistIdxT HeapFastmarchingCL::CloseHeapCL::pop ()
+{
+    const DistIdxT ret= heap_.front();
+    const DistIdxT last= heap_.back();
+    heap_.pop_back();
+    const size_t n= heap_.size();
+    if (n == 0)
+        return ret;
+
+    size_t p= 0;
+    for (size_t child= 1; child < n; child= Arity*p + 1) {
+        size_t min= child;
+        for (size_t c= child + 1; c < std::min( child + Arity, n); ++c)
+            if (heap_[c] < heap_[min])
+                min= c;
+        if (!(heap_[min] < last))
+            break;
+        heap_[p]= heap_[min];
+        p= min;
+    }
+    heap_[p]= last;
+    return ret;
+}
+
+/** Store the child tetrahedra of each DoF and its neighbor DoF in CSR arrays. The
+    child tetrahedra are counted in a first sweep and stored in a second sweep.*/
+void HeapFastmarchingCL::InitNeigh()
+{
+    const size_t n= data_.phi.Data.size();
+    const Uint lvl= data_.phi.GetLevel();
+    const Uint idx= data_.per ? data_.augmIdx->GetIdx() : data_.phi.RowIdx->GetIdx();
+    const RefRuleCL RegRef= GetRefRule( RegRefRuleC);
+    Ubyte childVerts[MaxChildrenC][NumVertsC];
+    for (Uint ch= 0; ch < MaxChildrenC; ++ch)
+        for (Uint vert= 0; vert < NumVertsC; ++vert)
+            childVerts[ch][vert]= GetChildData( RegRef.Children[ch]).Vertices[vert];
+    IdxT Numb[10];
+
+    tetraBegin_.assign( n + 1, 0);
+    std::vector<size_t> fill;
+    for (int sweep= 0; sweep < 2; ++sweep) {
+        if (sweep == 1) {
+            for (size_t i= 0; i < n; ++i) // prefix sum of the counts
+                tetraBegin_[i+1]+= tetraBegin_[i];
+            tetras_.resize( tetraBegin_[n]);
+            fill.assign( tetraBegin_.begin(), tetraBegin_.end() - 1);
+        }
+        DROPS_FOR_TRIANG_TETRA( data_.mg, lvl, it) {
+            for (int v= 0; v < 10; ++v) // collect data on all DoF
+                Numb[v]= v < 4 ? it->GetVertex( v)->Unknowns( idx) : it->GetEdge( v-4)->Unknowns( idx);
+            for (Uint ch= 0; ch < MaxChildrenC; ++ch) {
+                ReprTetraT t;
+                for (Uint vert= 0; vert < NumVertsC; ++vert)
+                    t[vert]= Numb[childVerts[ch][vert]];
+                for (Uint vert= 0; vert < NumVertsC; ++vert) {
+                    const IdxT dof= data_.Map( t[vert]);
+                    if (sweep == 0)
+                        ++tetraBegin_[dof + 1];
+                    else
+                        tetras_[fill[dof]++]= t;
+                }
+            }
+        }
+    }
+
+    // neighbor DoF: vertices of the child tetrahedra without duplicates
+    const IdxT NoIdx= static_cast<IdxT>( -1);
+    std::vector<IdxT> mark( data_.coord.size(), NoIdx); // mark[j] == i: j is already a neighbor of i
+    vertBegin_.assign( n + 1, 0);
+    verts_.clear();
+    verts_.reserve( 2*tetras_.size());
+    for (size_t i= 0; i < n; ++i) {
+        for (size_t t= tetraBegin_[i]; t < tetraBegin_[i+1]; ++t)
+            for (Uint vert= 0; vert < NumVertsC; ++vert) {
+                const IdxT j= tetras_[t][vert];
+                if (mark[j] != i) {
+                    mark[j]= i;
+                    verts_.push_back( j);
+                }
+            }
+        vertBegin_[i+1]= verts_.size();
+    }
+}
+
+/** Put all neighbors of finished DoF in the close set.
+    \pre InitNeigh has to be called
+*/
+void HeapFastmarchingCL::InitClose()
+{
+    for (size_t dof= 0; dof < data_.typ.size(); ++dof)
+        if (data_.typ[dof] == data_.Finished)
+            for (size_t j= vertBegin_[dof]; j < vertBegin_[dof+1]; ++j)
+                Update( verts_[j]);
+}
+
+/** Same as FastmarchingCL::Update with the CSR arrays of the child tetrahedra.
+    \param NrI dof to be updated
+*/
+void HeapFastmarchingCL::Update( const IdxT NrI)
+{
+    const IdxT MapNrI = data_.Map(NrI);
+
+    if ( data_.typ[MapNrI] == data_.Finished)
+        return;
+
+    IdxT upd[3];
+    double minval = ( data_.typ[MapNrI] == data_.Close) ? data_.phi.Data[MapNrI] : 1e99;
+
+    for (size_t n= tetraBegin_[MapNrI]; n < tetraBegin_[MapNrI+1]; ++n) {
+        int num = 0;
+        for ( int j = 0; j < 4; ++j) {
+            const IdxT NrJ   = tetras_[n][j];
+            const IdxT MapNrJ= data_.Map( NrJ);
+            if ( data_.typ[MapNrJ] == data_.Finished) {
+                upd[num++] = NrJ;
+                minval = std::min(minval,
+                        data_.phi.Data[ MapNrJ]+(data_.coord[NrJ]-data_.coord[NrI]).norm());
+            }
+        }
+        minval = std::min(minval, CompValueProj(NrI, num, upd));
+    }
+
+    data_.phi.Data[MapNrI] = minval;
+    if (data_.typ[MapNrI] != data_.Close) {
+        heap_.push( DistIdxT( minval, MapNrI));
+        data_.typ[MapNrI] = data_.Close;
+    }
+}
+
+/** While the heap is not empty and the smallest value lies within the narrow band, finish the DoF with the smallest value
+    and update its neighbors*/
+void HeapFastmarchingCL::DetermineDistances()
+{
+    while (!heap_.empty() && data_.InBand( heap_.top().first)) {
+        const IdxT next= heap_.pop().second;
+        data_.typ[next] = data_.Finished;
+        for (size_t j= vertBegin_[next]; j < vertBegin_[next+1]; ++j)
+            Update( verts_[j]);
+    }
+    data_.ClampToBand();
+}
+
+/** Apply the FMM to a level set function*/
+void HeapFastmarchingCL::Perform()
+{
+    InitNeigh();
+    InitClose();
+    DetermineDistances();
+}
+
+// F A S T  I T E R A T I V E  C L
+//--------------------------------
+
+/** Like HeapFastmarchingCL::Update, where all neighbors with a smaller value than i are
+    treated as finished. Only phi at the neighbors is read.
+    \param i mapped dof to be computed
+*/
+double FastIterativeCL::Solve( const IdxT i) const
+{
+    const VectorCL& phi= data_.phi.Data;
+    double minval= phi[i];
+    IdxT upd[3];
+
+    for (size_t n= tetraBegin_[i]; n < tetraBegin_[i+1]; ++n) {
+        IdxT NrI= 0; // unmapped number of i in this tetra, determines the coordinates
+        for (int j= 0; j < 4; ++j)
+            if (data_.Map( tetras_[n][j]) == i)
+                NrI= tetras_[n][j];
+        int num= 0;
+        for (int j= 0; j < 4; ++j) {
+            const IdxT NrJ   = tetras_[n][j];
+            const IdxT MapNrJ= data_.Map( NrJ);
+            if (MapNrJ != i && phi[MapNrJ] < phi[i]) {
+                upd[num++]= NrJ;
+                minval= std::min( minval, phi[MapNrJ] + (data_.coord[NrJ] - data_.coord[NrI]).norm());
+            }
+        }
+        minval= std::min( minval, CompValueProj( NrI, num, upd));
+        if (num == 3) // fast marching also projects on the edges, while only two of the dof are finished
+            for (int j= 0; j < 3; ++j) {
+                const IdxT edge[3]= { upd[j], upd[(j+1)%3], 0 };
+                minval= std::min( minval, CompValueProj( NrI, 2, edge));
+            }
+    }
+    return minval;
+}
+
+/** Apply the FIM to a level set function*/
+void FastIterativeCL::Perform()
+{
+    InitNeigh();
+    const size_t n= data_.phi.Data.size();
+    VectorCL& phi= data_.phi.Data;
+    std::vector<byte> active( n, 0); // DoF is contained in list
+    std::vector<IdxT> list, next;
+    for (size_t i= 0; i < n; ++i)
+        if (data_.typ[i] != data_.Finished)
+            phi[i]= 1e99;
+    for (size_t dof= 0; dof < n; ++dof)
+        if (data_.typ[dof] == data_.Finished)
+            for (size_t j= vertBegin_[dof]; j < vertBegin_[dof+1]; ++j) {
+                const IdxT k= data_.Map( verts_[j]);
+                if (data_.typ[k] != data_.Finished && !active[k]) {
+                    active[k]= 1;
+                    list.push_back( k);
+                }
+            }
+
+    std::vector<double> val;
+    numIter_= numUpdates_= 0;
+    while (!list.empty()) {
+        ++numIter_;
+        numUpdates_+= list.size();
+        val.resize( list.size());
+#ifndef DROPS_WIN
+        size_t k;
+#else
+        int k;
+#endif
+#pragma omp parallel for schedule(dynamic, 256)
+        for (k= 0; k < list.size(); ++k)
+            val[k]= Solve( list[k]);
+
+        for (size_t k= 0; k < list.size(); ++k)
+            active[list[k]]= 0;
+        next.clear();
+        for (size_t k= 0; k < list.size(); ++k) {
+            const IdxT i= list[k];
+            if (!(val[k] < (1. - 1e-12)*phi[i]))
+                continue;
+            phi[i]= val[k];
+            if (!data_.InBand( val[k])) // do not propagate beyond the narrow band
+                continue;
+            for (size_t j= vertBegin_[i]; j < vertBegin_[i+1]; ++j) {
+                const IdxT l= data_.Map( verts_[j]);
+                if (data_.typ[l] != data_.Finished && !active[l]) {
+                    active[l]= 1;
+                    next.push_back( l);
+                }
+            }
+        }
+        list.swap( next);
+    }
+    if (data_.band >= 0.)
+        for (size_t i= 0; i < n; ++i)
+            if (data_.typ[i] != data_.Finished)
+                phi[i]= std::min( phi[i], data_.band);
+}
+
 #ifdef _PAR
 
 // F A S T M A R C H I N G  O N  M A S T E R  C L
@@ -1468,30 +1755,69 @@ void DirectDistanceCL::BuildKDTree()
     kd_tree_builder.build( front_);
 }
 
+/// \brief Distance of a query point to the front, determined from the result of a search in the kd-tree of the front
+template <class SearchT, bool SquaredDistance>
+class FrontDistanceCL
+{
+  private:
+    const KDTree::TreeCL<double,3>& tree_;
+    const VectorCL&                 vals_;      ///< values of phi on the points of the front
+    const double                    init_;      ///< distance, if no point of the front is found
+    std::vector<double>&            dist_;      ///< distance of each query point
+
+  public:
+    FrontDistanceCL( const KDTree::TreeCL<double,3>& tree, const VectorCL& vals, double init, std::vector<double>& dist)
+        : tree_( tree), vals_( vals), init_( init), dist_( dist) {}
+
+    void operator() (size_t i, const SearchT& searcher) const {
+        const typename SearchT::result_type& result= searcher.result();
+        double d= init_;
+        for ( size_t n=0; n<result.size(); ++n){
+            const double dn= SquaredDistance ? std::sqrt( result[n].distance()) : result[n].distance();
+            d= std::min( d, dn + vals_[ tree_.get_orig(result[n].get_idx())]);
+        }
+        dist_[i]= d;
+    }
+};
+
 void DirectDistanceCL::DetermineDistances()
 /** Iterate over all off-site vertices and assign shortest distance to a
-    frontier vertex or perpendicular foot to phi
+    frontier vertex or perpendicular foot to phi. With a narrow band, all frontier vertices
+    and perpendicular feet within the band are considered instead of the numNeigh_ nearest ones;
+    the search for vertices outside the band terminates at the root of the kd-tree.
+    The searches for all vertices and periodic directions are performed as a batch.
 */
 {
+    const size_t numDir= data_.perDir.size();
+    std::vector<int> dofs;
+    for ( int dof=0; dof<(int)data_.phi.Data.size(); ++dof)
+        if ( data_.typ[dof]!=ReparamDataCL::Finished && data_.typ[dof]!=ReparamDataCL::Handled)
+            dofs.push_back( dof);
+    if ( dofs.empty())
+        return;
+
+    // query point numDir*i+j is the vertex dofs[i] shifted by the j-th periodic direction
+    std::vector<double> queries( 3*numDir*dofs.size()), dist( numDir*dofs.size());
 #pragma omp parallel for
-    for ( int dof=0; dof<(int)data_.phi.Data.size(); ++dof) {
-        if ( data_.typ[dof]!=ReparamDataCL::Finished && data_.typ[dof]!=ReparamDataCL::Handled) {
-            double newPhi= std::numeric_limits<double>::max();
-            const Point3DCL coord= data_.coord[dof];
-            for (ReparamDataCL::perDirSetT::const_iterator dir= data_.perDir.begin(), end= data_.perDir.end(); dir!=end; ++dir) {
-                const Point3DCL p= coord + *dir;
-                typedef KDTree::SearchNearestNeighborsCL<2,double,3,12> SearcherT;
-                SearcherT searcher( *kdTree_, Addr(p), numNeigh_);
-                searcher.search();
-                SearcherT::result_type result= searcher.result();
-                for ( size_t n=0; n<result.size(); ++n){
-                    newPhi= std::min( newPhi, result[n].distance() + vals_[ kdTree_->get_orig(result[n].get_idx())]);
-                }
-            }
-#pragma omp critical
-            data_.phi.Data[dof]= newPhi;
-        }
+    for ( int i=0; i<(int)dofs.size(); ++i)
+        for ( size_t j=0; j<numDir; ++j)
+            for ( int k=0; k<3; ++k)
+                queries[3*(numDir*i+j)+k]= data_.coord[dofs[i]][k] + data_.perDir[j][k];
+
+    if ( data_.band < 0.){
+        typedef KDTree::SearchNearestNeighborsCL<2,double,3,12> SearcherT;
+        FrontDistanceCL<SearcherT, false> fun( *kdTree_, vals_, std::numeric_limits<double>::max(), dist);
+        KDTree::search_batch<SearcherT>( *kdTree_, Addr( queries), dist.size(), numNeigh_, fun);
     }
+    else {
+        typedef KDTree::SearchNeighborsCL<2,double,3,12> SearcherT;    // returns squared distances
+        FrontDistanceCL<SearcherT, true> fun( *kdTree_, vals_, data_.band, dist);
+        KDTree::search_batch<SearcherT>( *kdTree_, Addr( queries), dist.size(), data_.band, fun);
+    }
+
+#pragma omp parallel for
+    for ( int i=0; i<(int)dofs.size(); ++i)
+        data_.phi.Data[dofs[i]]= *std::min_element( dist.begin()+numDir*i, dist.begin()+numDir*(i+1));
 }
 
 void DirectDistanceCL::DisplayMem() const
@@ -1782,6 +2108,22 @@ std::auto_ptr<ReparamCL> ReparamFactoryCL::GetReparam( MultiGridCL& mg,
             }
             break;
         }
+        case 2: {
+#ifdef _PAR
+            reparam->propagate_ = new FastmarchingOnMasterCL( reparam->data_);
+#else
+            reparam->propagate_ = new HeapFastmarchingCL( reparam->data_);
+#endif
+            break;
+        }
+        case 3: {
+#ifdef _PAR
+            reparam->propagate_ = new FastmarchingOnMasterCL( reparam->data_);
+#else
+            reparam->propagate_ = new FastIterativeCL( reparam->data_);
+#endif
+            break;
+        }
         default: {
             throw DROPSErrCL("ReparamFactoryCL::GetReparam: Unknown method for Propagate");
         }
@@ -71,6 +71,7 @@ class ReparamDataCL
     const BndDataCL<>*       bnd;         ///< boundary for level set function
     perMapVecT               map;         ///< mapping of periodic boundary conditions
     perDirSetT               perDir;      ///< set of directions to be considered in case of periodic boundaries (only used by DirectDistanceCL)
+    double                   band;        ///< width of the narrow band around the interface, in which distances are computed; negative: whole domain
 
   public:
     // \brief Allocate memory, store references and init coordinates as well as map periodic boundary dofs
@@ -78,7 +79,7 @@ class ReparamDataCL
         : gatherPerp(GatherPerp), mg( MG), phi( Phi), old( phi.Data),
           coord( Phi.Data.size()), typ( Far, Phi.Data.size()),
           perpFoot( (Point3DCL*)0, GatherPerp ? Phi.Data.size() : 0),
-          per( Periodic), augmIdx( 0), bnd( Bnd), map( 0), perDir( 1, Point3DCL())
+          per( Periodic), augmIdx( 0), bnd( Bnd), map( 0), perDir( 1, Point3DCL()), band( -1.)
     { InitPerMap(); InitCoord(); }
     /// \brief Delete all perpendicular feet
     ~ReparamDataCL();
@@ -95,6 +96,10 @@ class ReparamDataCL
     inline bool UsePerp() const { return gatherPerp; }
     /// \brief Assign perpendicular foot
     inline void UpdatePerp( const IdxT, const double, const Point3DCL&);
+    /// \brief Check if a distance lies within the narrow band
+    bool InBand( double d) const { return band < 0. || d <= band; }
+    /// \brief Limit the values of the close DoF by the width of the narrow band, set all other DoF, which are not finished, to it
+    void ClampToBand();
 };
 
 inline void ReparamDataCL::Normalize( double& b) const
@@ -419,6 +424,8 @@ class FastmarchingCL : public PropagateCL
         ListT List_;
       public:
         CloseContCL() { }
+        /// \brief returns closest point to interface
+        const DistIdxT& Nearest() const { return *List_.begin(); }
         /// \brief returns closest point to interface and deletes this point from List_
         DistIdxT GetNearest() {
             DistIdxT ret = *List_.begin();
@@ -459,6 +466,9 @@ class FastmarchingCL : public PropagateCL
     /// \brief Compute the distances
     void DetermineDistances();
 
+    FastmarchingCL( ReparamDataCL& data, const std::string& name)
+        : base( data, name) {}
+
   public:
     FastmarchingCL( ReparamDataCL& data)
         : base( data, "Fast-Marching-Method") {}
@@ -467,6 +477,92 @@ class FastmarchingCL : public PropagateCL
     virtual void Perform();
 };
 
+/// \brief Propagate the values by the fast marching method with a heap as close set
+/** The close vertices are kept in a 4-ary heap in a flat array and the child tetrahedra of each DoF as well as
+    the neighbor DoF are stored in flat arrays (CSR), so no memory is allocated per vertex during the propagation.
+    The close vertices are ordered by their value at insertion like in FastmarchingCL, so both classes
+    compute the same distances.
+*/
+class HeapFastmarchingCL : public FastmarchingCL
+{
+  public:
+    typedef FastmarchingCL base;
+
+    /// \brief 4-ary min-heap of pairs (value, DoF)
+    class CloseHeapCL
+    {
+      private:
+        static const size_t Arity= 4;
+        std::vector<DistIdxT> heap_;
+
+      public:
+        bool   empty () const { return heap_.empty(); }
+        size_t size  () const { return heap_.size(); }
+        void     push (const DistIdxT&);
+        /// \brief The pair with the smallest value
+        const DistIdxT& top () const { return heap_.front(); }
+        /// \brief Remove and return the pair with the smallest value
+        DistIdxT pop ();
+    };
+
+  protected:
+    std::vector<size_t>     tetraBegin_; ///< child tetrahedra of DoF i are tetras_[tetraBegin_[i]], ..., tetras_[tetraBegin_[i+1]-1]
+    std::vector<ReprTetraT> tetras_;
+    std::vector<size_t>     vertBegin_;  ///< neighbor DoF of DoF i are verts_[vertBegin_[i]], ..., verts_[vertBegin_[i+1]-1]
+    std::vector<IdxT>       verts_;
+    CloseHeapCL             heap_;
+
+    /// \brief initialize the CSR arrays of the child tetrahedra and the neighbor DoF
+    void InitNeigh();
+
+  private:
+    /// \brief initialize close set
+    void InitClose();
+    /// \brief Update value on a vertex and put this vertex into the heap, if it is not yet close
+    void Update( const IdxT);
+    /// \brief Compute the distances
+    void DetermineDistances();
+
+  protected:
+    HeapFastmarchingCL( ReparamDataCL& data, const std::string& name)
+        : base( data, name) {}
+
+  public:
+    HeapFastmarchingCL( ReparamDataCL& data)
+        : base( data, "Fast-Marching-Method with heap") {}
+    /// \brief Determine unsigned distances by the fast marching method
+    void Perform();
+};
+
+/// \brief Propagate the values by the OpenMP-parallel fast iterative method (FIM)
+/** Starting from the frontier, all DoF of an active list are updated concurrently (Jacobi-like) from the current
+    values of their neighbors, which are smaller than their own value. The neighbors of DoF, whose value decreased,
+    form the next active list. The iteration stops, when no value decreases anymore. The local update is the one of
+    the fast marching method, thus the distances are close to, but not identical with, those of FastmarchingCL.
+    As the update only reads the old values, the result does not depend on the number of threads.
+*/
+class FastIterativeCL : public HeapFastmarchingCL
+{
+  public:
+    typedef HeapFastmarchingCL base;
+
+  private:
+    size_t numIter_;    ///< number of iterations of the last call of Perform
+    size_t numUpdates_; ///< number of local updates of the last call of Perform
+
+    /// \brief Value of DoF i computed from the smaller values of its neighbors; thread-safe
+    double Solve( const IdxT i) const;
+
+  public:
+    FastIterativeCL( ReparamDataCL& data)
+        : base( data, "Fast-Iterative-Method"), numIter_( 0), numUpdates_( 0) {}
+    /// \brief Determine unsigned distances by the fast iterative method
+    void Perform();
+
+    size_t GetNumIter()    const { return numIter_; }
+    size_t GetNumUpdates() const { return numUpdates_; }
+};
+
 #ifdef _PAR
 /// \brief Performing the FMM on a master process
 class FastmarchingOnMasterCL : public FastmarchingCL
@@ -626,6 +722,8 @@ class ReparamCL
     /// \brief Constructor
     ReparamCL( MultiGridCL& mg, VecDescCL& phi, bool gatherPerp, bool periodic=false, const BndDataCL<>* bnd=0);
     ~ReparamCL();
+    /// \brief Compute the distances only up to the given width around the interface; beyond, the level set function is set to +-width
+    void SetNarrowBand( double width) { data_.band= width; }
     /// \brief Perform the reparametrization
     void Perform();
 };
@@ -642,6 +740,14 @@ class ReparamCL
     <tr><td>  11    </td><td> P1 Scaling        </td><td> Direct distance with KD trees </td></tr>
     <tr><td>  12    </td><td> P1 projection     </td><td> Direct distance with KD trees </td></tr>
     <tr><td>  13    </td><td> Exact Distance    </td><td> Direct distance with KD trees </td></tr>
+    <tr><td>  20    </td><td> No modification   </td><td> Fast marching with heap       </td></tr>
+    <tr><td>  21    </td><td> P1 Scaling        </td><td> Fast marching with heap       </td></tr>
+    <tr><td>  22    </td><td> P1 projection     </td><td> Fast marching with heap       </td></tr>
+    <tr><td>  23    </td><td> Exact Distance    </td><td> Fast marching with heap       </td></tr>
+    <tr><td>  30    </td><td> No modification   </td><td> Fast iterative method         </td></tr>
+    <tr><td>  31    </td><td> P1 Scaling        </td><td> Fast iterative method         </td></tr>
+    <tr><td>  32    </td><td> P1 projection     </td><td> Fast iterative method         </td></tr>
+    <tr><td>  33    </td><td> Exact Distance    </td><td> Fast iterative method         </td></tr>
     </table>
 */
 class ReparamFactoryCL
@@ -29,6 +29,8 @@
 #include "num/lattice-eval.h"
 #include "num/quadrature.h"
 #include <fstream>
+#include <numeric>
+#include <iterator>
 
 namespace DROPS
 {
@@ -1100,16 +1102,181 @@ void LevelsetP2CL::CreateNumbering( Uint level, MLIdxDescCL* idx, match_fun matc
 }
 
 
-void LevelsetP2CL::Reparam( int method, bool Periodic)
+void LevelsetP2CL::Reparam( int method, bool Periodic, double band)
 /** \param method How to perform the reparametrization (see description of ReparamFactoryCL for details)
     \param Periodic: If true, a special variant of the algorithm for periodic boundaries is used.
+    \param band: width of the narrow band around the interface; outside, the level set function is set to +-band. Negative: no band.
 */
 {
     std::auto_ptr<ReparamCL> reparam= ReparamFactoryCL::GetReparam( MG_, *PhiC, method, Periodic, &BndData_, perDirections);
+    reparam->SetNarrowBand( band);
     reparam->Perform();
     UpdateDiscontinuous();
 }
 
+// ==============================================
+//              InterfaceTetraListCL
+// ==============================================
+
+const Uint InterfaceTetraListCL::NoLayer;
+
+void InterfaceTetraListCL::build_dof_map (const MultiGridCL& mg, const IdxDescCL& idx)
+{
+    const Uint lvl= idx.TriangLevel(),
+               num= idx.GetIdx();
+    tetra_.clear();
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, lvl, it)
+        tetra_.push_back( &*it);
+    dof_.resize( 10*tetra_.size());
+    bnd_tetra_.clear();
+    dof_tetra_begin_.assign( idx.NumUnknowns() + 1, 0);
+    for (size_t k= 0; k < tetra_.size(); ++k) {
+        const TetraCL& t= *tetra_[k];
+        bool bnd= false;
+        for (Uint i= 0; i < 10; ++i) {
+            const UnknownHandleCL& unk= i < 4 ? t.GetVertex( i)->Unknowns : t.GetEdge( i - 4)->Unknowns;
+            IdxT& dof= dof_[10*k + i];
+            dof= unk.Exist( num) ? unk( num) : NoIdx;
+            if (dof == NoIdx)
+                bnd= true;
+            else
+                ++dof_tetra_begin_[dof + 1];
+        }
+        if (bnd)
+            bnd_tetra_.push_back( k);
+    }
+    std::partial_sum( dof_tetra_begin_.begin(), dof_tetra_begin_.end(), dof_tetra_begin_.begin());
+    dof_tetra_.resize( dof_tetra_begin_.back());
+    std::vector<size_t> pos( dof_tetra_begin_.begin(), dof_tetra_begin_.end() - 1);
+    for (size_t k= 0; k < tetra_.size(); ++k)
+        for (Uint i= 0; i < 10; ++i)
+            if (dof_[10*k + i] != NoIdx)
+                dof_tetra_[pos[dof_[10*k + i]]++]= k;
+
+    version_= mg.GetVersion();
+    numb_version_= idx.GetNumberingVersion();
+}
+
+bool InterfaceTetraListCL::is_cut (size_t k, const VecDescCL& ls, const BndDataCL<>& lsetbnd) const
+{
+    const IdxT* dof= &dof_[10*k];
+    int sum= 0;
+    if (std::find( dof, dof + 10, NoIdx) != dof + 10) {
+        const LocalP2CL<> loc( *tetra_[k], ls, lsetbnd);
+        for (Uint i= 0; i < 10; ++i)
+            sum+= InterfacePatchCL::Sign( loc[i]);
+    }
+    else
+        for (Uint i= 0; i < 10; ++i)
+            sum+= sign_[dof[i]];
+    return std::abs( sum) != 10;
+}
+
+void InterfaceTetraListCL::compute_band ()
+{
+    for (size_t j= 0; j < band_.size(); ++j)
+        layer_[band_[j]]= NoLayer;
+    for (size_t j= 0; j < cut_.size(); ++j)
+        layer_[cut_[j]]= 0;
+    band_= cut_;
+    std::vector<size_t> front( cut_), next;
+    for (Uint l= 1; l <= width_ && !front.empty(); ++l) {
+        next.clear();
+        for (size_t j= 0; j < front.size(); ++j)
+            for (const IdxT* dof= &dof_[10*front[j]], *dofend= dof + 10; dof != dofend; ++dof) {
+                if (*dof == NoIdx)
+                    continue;
+                for (size_t m= dof_tetra_begin_[*dof]; m < dof_tetra_begin_[*dof + 1]; ++m)
+                    if (layer_[dof_tetra_[m]] == NoLayer) {
+                        layer_[dof_tetra_[m]]= l;
+                        next.push_back( dof_tetra_[m]);
+                    }
+            }
+        band_.insert( band_.end(), next.begin(), next.end());
+        front.swap( next);
+    }
+    std::sort( band_.begin(), band_.end());
+    band_width_= width_;
+
+    cut_seq_.resize( cut_.size());
+    for (size_t j= 0; j < cut_.size(); ++j)
+        cut_seq_[j]= tetra_[cut_[j]];
+    band_seq_.resize( band_.size());
+    for (size_t j= 0; j < band_.size(); ++j)
+        band_seq_[j]= tetra_[band_[j]];
+    colors_[0].clear();
+    colors_[1].clear();
+}
+
+void InterfaceTetraListCL::Update (const MultiGridCL& mg, const VecDescCL& ls, const BndDataCL<>& lsetbnd)
+{
+    const IdxDescCL& idx= *ls.RowIdx;
+    if (mg.GetVersion() != version_ || idx.GetNumberingVersion() != numb_version_ || tetra_.empty()) {
+        build_dof_map( mg, idx);
+        sign_.resize( idx.NumUnknowns());
+        for (size_t i= 0; i < sign_.size(); ++i)
+            sign_[i]= InterfacePatchCL::Sign( ls.Data[i]);
+        layer_.assign( tetra_.size(), NoLayer);
+        cut_.clear();
+        band_.clear();
+        for (size_t k= 0; k < tetra_.size(); ++k)
+            if (is_cut( k, ls, lsetbnd))
+                cut_.push_back( k);
+        num_checked_= tetra_.size();
+        compute_band();
+        return;
+    }
+
+    // Check the tetras at the DoFs with a new sign and the tetras with boundary values again.
+    std::vector<size_t> check( bnd_tetra_);
+    for (size_t i= 0; i < sign_.size(); ++i) {
+        const signed char s= InterfacePatchCL::Sign( ls.Data[i]);
+        if (s == sign_[i])
+            continue;
+        sign_[i]= s;
+        check.insert( check.end(), dof_tetra_.begin() + dof_tetra_begin_[i], dof_tetra_.begin() + dof_tetra_begin_[i + 1]);
+    }
+    std::sort( check.begin(), check.end());
+    check.erase( std::unique( check.begin(), check.end()), check.end());
+    num_checked_= check.size();
+
+    std::vector<size_t> recut, rest, newcut;
+    for (size_t j= 0; j < check.size(); ++j)
+        if (is_cut( check[j], ls, lsetbnd))
+            recut.push_back( check[j]);
+    std::set_difference( cut_.begin(), cut_.end(), check.begin(), check.end(), std::back_inserter( rest));
+    std::set_union( rest.begin(), rest.end(), recut.begin(), recut.end(), std::back_inserter( newcut));
+    if (newcut == cut_ && band_width_ == width_)
+        return;
+    cut_.swap( newcut);
+    compute_band();
+}
+
+const ColorClassesCL& InterfaceTetraListCL::GetColorClasses (bool band, match_fun match, const BndCondCL& Bnd) const
+{
+    std::vector<ColorClassesCL>& colors= colors_[band ? 1 : 0];
+    if (colors.empty())
+        colors.push_back( band ? ColorClassesCL( begin(), end(), match, Bnd, version_)
+                               : ColorClassesCL( cut_begin(), cut_end(), match, Bnd, version_));
+    return colors.front();
+}
+
+void LevelsetP2CL::AccumulateOnInterface( TetraAccumulatorTupleCL& accus, bool band) const
+{
+    const InterfaceTetraListCL& tetras= GetInterfaceTetras();
+#ifdef _OPENMP
+    if (omp_get_max_threads() > 1) {
+        accus( tetras.GetColorClasses( band, PhiC->RowIdx->GetMatchingFunction(), PhiC->RowIdx->GetBndInfo()));
+        return;
+    }
+#endif
+    if (band)
+        accus( tetras.begin(), tetras.end());
+    else
+        accus( tetras.cut_begin(), tetras.cut_end());
+}
+
+
 void LevelsetP2CL::AccumulateBndIntegral( VecDescCL& f) const
 {
     ScopeTimerCL scope("AccumulateBndIntegral");
@@ -1129,10 +1296,17 @@ void LevelsetP2CL::AccumulateBndIntegral( VecDescCL& f) const
         throw DROPSErrCL("LevelsetP2CL::AccumulateBndIntegral not implemented for this SurfaceForceT");
     }
     TetraAccumulatorTupleCL accus;
-    ProgressBarTetraAccumulatorCL accup(MG_, "SurfTension Setup", Phi.RowIdx->TriangLevel());
-    accus.push_back( &accup);
-    accus.push_back( accu);
-    accumulate( accus, MG_, Phi.RowIdx->TriangLevel(), Phi.RowIdx->GetMatchingFunction(), Phi.RowIdx->GetBndInfo());
+    if (curvDiff_ <= 0. && PhiC->RowIdx->TriangLevel() == Phi.RowIdx->TriangLevel()) {
+        // Without smoothing, the accumulators only contribute on tetras cut by the zero level of PhiC.
+        accus.push_back( accu);
+        AccumulateOnInterface( accus);
+    }
+    else {
+        ProgressBarTetraAccumulatorCL accup(MG_, "SurfTension Setup", Phi.RowIdx->TriangLevel());
+        accus.push_back( &accup);
+        accus.push_back( accu);
+        accumulate( accus, MG_, Phi.RowIdx->TriangLevel(), Phi.RowIdx->GetMatchingFunction(), Phi.RowIdx->GetBndInfo());
+    }
 
     delete accu;
 }
@@ -1160,21 +1334,30 @@ void LevelsetP2CL::AccumulateYoungForce( VecDescCL& f) const
 //>to do for parallel programe, we need add all values in different process
 double LevelsetP2CL::GetInterfaceArea() const
 {
-	InterfaceTriangleCL triangle;
 	const DROPS::Uint lvl = idx.TriangLevel();
-	BndDataCL lsetbnd = GetBndData();
+	const PrincipalLatticeCL& lat= PrincipalLatticeCL::instance( 2);
+	std::valarray<double> ls_loc( lat.vertex_size());
+	LocalP2CL<> loc_phi;
+	InterfaceCutCacheCL& cache= GetCutCache();
 	double area = 0;
-	DROPS_FOR_TRIANG_TETRA( MG_, lvl, it){
-		triangle.Init( *it, Phi, lsetbnd);
-		for(int ch=0;ch<8;++ch)
-		{
-			if (!triangle.ComputeForChild(ch)) // no patch for this child
-		            continue;
-			for(int v=0;v<triangle.GetNumTriangles();v++)
-				area += triangle.GetAbsDet(v);
-		}
+	// For continuous level set functions, only the tetras at the interface are cut.
+	const MultiGridCL& mg= MG_;
+	MultiGridCL::const_TriangTetraIteratorCL begin= mg.GetTriangTetraBegin( lvl), end= mg.GetTriangTetraEnd( lvl);
+	if (PhiC == &Phi) {
+		const InterfaceTetraListCL& tetras= GetInterfaceTetras();
+		begin= tetras.cut_begin();
+		end= tetras.cut_end();
 	}
-	return area*0.5;
+	for (MultiGridCL::const_TriangTetraIteratorCL it= begin; it != end; ++it) {
+		loc_phi.assign( *it, Phi, BndData_);
+		evaluate_on_vertexes( loc_phi, lat, Addr( ls_loc));
+		CutDataCL* cut= cache.Get( *it, lat, ls_loc);
+		if (cut == 0) // no patch for this tetra
+			continue;
+		const QuadDomain2DCL& q= cut->quad5_domain_2D();
+		area += quad_2D( GridFunctionCL<>( 1., q.vertex_size()), q);
+	}
+	return area;
 }
 
 //>to do for parallel programe, we need add all values in different process
@@ -1334,14 +1517,20 @@ double LevelsetP2CL::GetVolume_Composite( double translation, int l) const
     QuadDomainCL qdom;
     LocalP2CL<> loc_phi;
     TetraPartitionCL partition;
+    // The translated level set functions of AdjustVolume are not cached.
+    InterfaceCutCacheCL* cache= translation == 0. ? &GetCutCache() : 0;
     DROPS_FOR_TRIANG_TETRA( MG_, idx.TriangLevel(), it) {
         loc_phi.assign(*it,Phi,GetBndData());
         loc_phi+= translation;
         evaluate_on_vertexes (loc_phi, lat, Addr(ls_values));
-        partition.make_partition< SortedVertexPolicyCL,MergeCutPolicyCL>(lat, ls_values);
-        make_CompositeQuad5Domain( qdom, partition);
-        DROPS::GridFunctionCL<> integrand( 1., qdom.vertex_size());
-        vol+=quad( integrand, it->GetVolume()*6., qdom, NegTetraC);
+        CutDataCL* cut= cache != 0 ? cache->Get( *it, lat, ls_values) : 0;
+        if (cut == 0) {
+            partition.make_partition< SortedVertexPolicyCL,MergeCutPolicyCL>(lat, ls_values);
+            make_CompositeQuad5Domain( qdom, partition);
+        }
+        const QuadDomainCL& q= cut != 0 ? cut->quad5_domain() : qdom;
+        DROPS::GridFunctionCL<> integrand( 1., q.vertex_size());
+        vol+=quad( integrand, it->GetVolume()*6., q, NegTetraC);
     }
     return vol;
 }
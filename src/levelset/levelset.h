@@ -33,6 +33,7 @@
 #include "levelset/mgobserve.h"
 #include "levelset/surfacetension.h"
 #include "num/interfacePatch.h"
+#include "num/cutcache.h"
 #include "num/renumber.h"
 #include "num/prolongation.h"
 #include <vector>
@@ -63,6 +64,86 @@ class LevelsetCoeffCL {
 };
 
 
+/// \brief The tetras cut by the zero level of a continuous P2 level set function and the tetras in a band around them.
+///
+/// A tetra is cut, if the signs (InterfacePatchCL::Sign) of the level set function in its ten P2-DoFs are not
+/// all positive or all negative. This includes all tetras, for which InterfacePatchCL::Intersects() is true or
+/// equal_signs() on the principal lattice of order 2 is false. The band of width k contains the tetras, which
+/// share a DoF with a tetra of the band of width k-1; the band of width 0 are the cut tetras.
+///
+/// Update has to be called after each modification of the level set function. As long as the multigrid and the
+/// numbering are unchanged, only the tetras at DoFs, whose sign has changed, are checked again. The tetras are
+/// stored in the order of the triangulation, thus they can be used in place of the triangulation, e.g. for
+/// AccumulatorTupleCL or ColorClassesCL.
+class InterfaceTetraListCL
+{
+  public:
+    typedef MultiGridCL::const_TriangTetraIteratorCL const_iterator;
+
+  private:
+    typedef std::vector<const TetraCL*> TetraSeqT;
+    static const Uint NoLayer= static_cast<Uint>( -1);
+
+    Uint   width_,        ///< width of the band
+           band_width_;   ///< width of the band in band_
+    size_t version_,      ///< version of the multigrid, for which the map from DoFs to tetras was built
+           numb_version_; ///< version of the numbering of the level set function
+
+    TetraSeqT                tetra_;           ///< all tetras of the triangulation
+    std::vector<IdxT>        dof_;             ///< the ten P2-DoFs of each tetra; NoIdx, if there is no unknown
+    std::vector<size_t>      dof_tetra_begin_, ///< the tetras at DoF i are dof_tetra_[dof_tetra_begin_[i]], ..., dof_tetra_[dof_tetra_begin_[i+1]-1]
+                             dof_tetra_,
+                             bnd_tetra_;       ///< tetras with DoFs without unknown; they are checked in each update
+    std::vector<signed char> sign_;            ///< sign of the level set function in each DoF
+    std::vector<Uint>        layer_;           ///< 0 for cut tetras, k for the band of width k, NoLayer for the others
+
+    std::vector<size_t> cut_,  ///< indices of the cut tetras in ascending order
+                        band_; ///< indices of the tetras in the band in ascending order
+    TetraSeqT           cut_seq_,
+                        band_seq_;
+    mutable std::vector<ColorClassesCL> colors_[2]; ///< color classes of cut_seq_ and band_seq_, computed on demand
+
+    size_t num_checked_; ///< number of tetras checked by the last update
+
+    void build_dof_map (const MultiGridCL& mg, const IdxDescCL& idx);
+    bool is_cut (size_t k, const VecDescCL& ls, const BndDataCL<>& lsetbnd) const;
+    void compute_band ();
+
+    static const_iterator make_iterator (const TetraSeqT& seq, size_t i)
+        { return const_iterator( seq.empty() ? 0 : const_cast<const TetraCL**>( &seq[0]) + i); }
+
+  public:
+    InterfaceTetraListCL (Uint width= 1)
+        : width_( width), band_width_( width), version_( NoIdx), numb_version_( 0), num_checked_( 0) {}
+
+    /// \brief Update the list for the level set function ls on the triangulation of ls.RowIdx.
+    void Update (const MultiGridCL& mg, const VecDescCL& ls, const BndDataCL<>& lsetbnd);
+
+    /// \brief Set the width of the band (in layers of tetras); takes effect with the next update.
+    void SetBandWidth (Uint width) { width_= width; }
+    Uint GetBandWidth () const { return width_; }
+
+    /// \name The cut tetras
+    //@{
+    const_iterator cut_begin () const { return make_iterator( cut_seq_, 0); }
+    const_iterator cut_end   () const { return make_iterator( cut_seq_, cut_seq_.size()); }
+    size_t         num_cut   () const { return cut_seq_.size(); }
+    //@}
+    /// \name The cut tetras and the tetras in the band
+    //@{
+    const_iterator begin () const { return make_iterator( band_seq_, 0); }
+    const_iterator end   () const { return make_iterator( band_seq_, band_seq_.size()); }
+    size_t         size  () const { return band_seq_.size(); }
+    //@}
+
+    /// \brief Color classes of the cut tetras (band == false) or of the tetras in the band, e.g. for the OpenMP-parallel accumulation.
+    const ColorClassesCL& GetColorClasses (bool band, match_fun match, const BndCondCL& Bnd) const;
+
+    /// \brief Number of tetras checked by the last update.
+    size_t GetNumChecked () const { return num_checked_; }
+};
+
+
 class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
 /// abstract base class for continuous and discontinuous P2 level set discretization
 /// P2-discretization and solution of the level set equation for two phase flow problems. Bnd_ will be used to impose boundary data on the inflow boundary.
@@ -104,6 +185,9 @@ class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
 
     bool IsDG;
 
+    mutable InterfaceCutCacheCL cutcache_; ///< subtriangulations of the cut tetras, see GetCutCache
+    mutable InterfaceTetraListCL iftetras_; ///< tetras at the interface, see GetInterfaceTetras
+
   public:
     MatrixCL            E, H;  ///< E: mass matrix, H: convection matrix
     VecDescCL           rhs;  ///< rhs due to boundary conditions 
@@ -142,8 +226,8 @@ LevelsetP2CL( MultiGridCL& mg, const LsetBndDataCL& bnd, SurfaceTensionCL& sf, F
     /// \remarks call SetupSystem \em before calling SetTimeStep!
     template<class DiscVelSolT>
     void SetupSystem( const DiscVelSolT&, const double);
-    /// Reparametrization of the level set function.
-    void Reparam( int method=03, bool Periodic= false);
+    /// Reparametrization of the level set function; with band >= 0, the distances are only computed within the narrow band of this width.
+    void Reparam( int method=03, bool Periodic= false, double band= -1.);
 
     /// \brief Perform downwind numbering
     template <class DiscVelSolT>
@@ -170,6 +254,21 @@ LevelsetP2CL( MultiGridCL& mg, const LsetBndDataCL& bnd, SurfaceTensionCL& sf, F
     /// Get type of surface force.
     SurfaceForceT GetSurfaceForce() const { return SF_; }
 
+    /// \brief Cache of the subtriangulations of the tetras cut by the zero level of PhiC.
+    /// The cache is cleared, if the multigrid has been modified or a new time step has started (Phi.t changed).
+    InterfaceCutCacheCL& GetCutCache() const
+        { cutcache_.Validate( MG_.GetVersion(), Phi.t); return cutcache_; }
+
+    /// \brief Tetras cut by the zero level of PhiC and the tetras in a band around them.
+    /// The list is updated with the current PhiC on each call; call it outside of parallel regions.
+    const InterfaceTetraListCL& GetInterfaceTetras() const
+        { iftetras_.Update( MG_, *PhiC, BndData_); return iftetras_; }
+    /// Set the width of the band of GetInterfaceTetras() in layers of tetras.
+    void SetInterfaceBand( Uint width) { iftetras_.SetBandWidth( width); }
+    /// \brief Accumulation over the cut tetras (band == false) or the band of GetInterfaceTetras() instead of the whole triangulation.
+    /// Only for accumulators, which do nothing on the other tetras.
+    void AccumulateOnInterface( TetraAccumulatorTupleCL& accus, bool band= false) const;
+
     ///returns the area of the two-phase flow interface(\phi=0)
     double GetInterfaceArea() const;
     ///returns the area of the solid-liquid(phi<0) interface
@@ -372,11 +471,12 @@ private:
 
     int    step_;
     bool   per_;
+    double rpm_NarrowBand_;
 
 public:
-    LevelsetModifyCL( int rpm_Freq, int rpm_Method, double rpm_MaxGrad, double rpm_MinGrad, int lvs_VolCorrection, double Vol, bool periodic=false) :
+    LevelsetModifyCL( int rpm_Freq, int rpm_Method, double rpm_MaxGrad, double rpm_MinGrad, int lvs_VolCorrection, double Vol, bool periodic=false, double rpm_NarrowBand= -1.) :
         rpm_Freq_( rpm_Freq), rpm_Method_( rpm_Method), rpm_MaxGrad_( rpm_MaxGrad),
-        rpm_MinGrad_( rpm_MinGrad), lvs_VolCorrection_( lvs_VolCorrection), Vol_( Vol), step_( 0), per_(periodic) {}
+        rpm_MinGrad_( rpm_MinGrad), lvs_VolCorrection_( lvs_VolCorrection), Vol_( Vol), step_( 0), per_(periodic), rpm_NarrowBand_( rpm_NarrowBand) {}
 
 
     void maybeDoReparam( LevelsetP2CL& lset) {
@@ -393,7 +493,7 @@ public:
         // reparam levelset function
         if (doReparam) {
             std::cout << "before reparametrization: minGradPhi " << lsetminGradPhi << "\tmaxGradPhi " << lsetmaxGradPhi << '\n';
-            lset.Reparam( rpm_Method_, per_);
+            lset.Reparam( rpm_Method_, per_, rpm_NarrowBand_);
             lset.GetMaxMinGradPhi( lsetmaxGradPhi, lsetminGradPhi);
             std::cout << "after  reparametrization: minGradPhi " << lsetminGradPhi << "\tmaxGradPhi " << lsetmaxGradPhi << '\n';
             // volume correction after reparametrization
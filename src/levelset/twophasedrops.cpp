@@ -247,6 +247,10 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
         Stokes.SetNumVelLvl ( Stokes.GetMG().GetNumLevel());
     if ( StokesSolverFactoryHelperCL().PrMGUsed(P))
         Stokes.SetNumPrLvl  ( Stokes.GetMG().GetNumLevel());
+    // algorithm of the products with B^T: 0 serial, 1 thread-private accumulation, 2 explicit transpose
+    Stokes.B.Data.SetTranspMul( static_cast<TranspMulT>( P.get<int>("Stokes.TranspMul")));
+    // reassemble only the values of A and M as long as the velocity numbering does not change
+    Stokes.SetPatternReuse( P.get<int>("Stokes.ReusePattern"));
 
     SetInitialLevelsetConditions( lset, MG, P);
 
@@ -390,7 +394,7 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
     LsetPcT lset_pc;
     GMResSolverCL<LsetPcT>* gm = new GMResSolverCL<LsetPcT>( lset_pc, 200, P.get<int>("Levelset.Iter"), P.get<double>("Levelset.Tol"));
 
-    LevelsetModifyCL lsetmod( P.get<int>("Reparam.Freq"), P.get<int>("Reparam.Method"), P.get<double>("Reparam.MaxGrad"), P.get<double>("Reparam.MinGrad"), P.get<int>("Levelset.VolCorrection"), Vol, is_periodic);
+    LevelsetModifyCL lsetmod( P.get<int>("Reparam.Freq"), P.get<int>("Reparam.Method"), P.get<double>("Reparam.MaxGrad"), P.get<double>("Reparam.MinGrad"), P.get<int>("Levelset.VolCorrection"), Vol, is_periodic, P.get<double>("Reparam.NarrowBand", -1.));
 
     UpdateProlongationCL<Point3DCL> PVel( Stokes.GetMG(), stokessolverfactory.GetPVel(), &Stokes.vel_idx, &Stokes.vel_idx);
     adap.push_back( &PVel);
@@ -693,6 +697,8 @@ void SetMissingParameters(DROPS::ParamCL& P){
 
     P.put_if_unset<int>("General.ProgressBar", 0);
     P.put_if_unset<std::string>("General.DynamicLibsPrefix", "../");
+    P.put_if_unset<int>("General.ReproducibleReductions", 0);
+    P.put_if_unset<int>("General.PartitionedAccumulation", 0);
 	//contactangle problem--------------------------------------------
 	P.put_if_unset<double>("SpeBnd.alpha", 0.0);
     P.put_if_unset<double>("SpeBnd.beta1", 0.0);
@@ -711,6 +717,8 @@ void SetMissingParameters(DROPS::ParamCL& P){
    P.put_if_unset<double>("Exp.SimuType", 0.0);
    P.put_if_unset<double>("Stokes.epsP", 0.0);
    P.put_if_unset<double>("Stokes.DirectSolve", 0);
+   P.put_if_unset<int>("Stokes.TranspMul", 0);
+   P.put_if_unset<int>("Stokes.ReusePattern", 0);
 }
 
 int main (int argc, char** argv)
@@ -730,6 +738,10 @@ int main (int argc, char** argv)
 
     if (P.get<int>("General.ProgressBar"))
         DROPS::ProgressBarTetraAccumulatorCL::Activate();
+    if (P.get<int>("General.ReproducibleReductions"))
+        DROPS::SetBLAS1Reduction( DROPS::ReproducibleReduction);
+    if (P.get<int>("General.PartitionedAccumulation"))
+        DROPS::SetTetraAccumulation( DROPS::PartitionedAccumulation);
 
     // check parameter file
     if (P.get<double>("SurfTens.DilatationalVisco")< P.get<double>("SurfTens.ShearVisco"))
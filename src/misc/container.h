@@ -30,6 +30,7 @@
 #include <cmath>
 #include <iostream>
 #include <valarray>
+#include <new>
 #include "misc/utils.h"
 
 namespace DROPS
@@ -1241,6 +1242,151 @@ template <Uint Rows_, Uint Cols_>
     std::copy( buffer + a_.size() + Cols_, buffer + a_.size() + 2*Cols_, beta_);
 }
 
+//**************************************************************************
+// Class:   MemoryPoolCL, PoolAllocatorCL                                  *
+// Purpose: Storage of small objects of equal size in large chunks with a  *
+//          free-list for the recycling of deallocated objects. Objects,   *
+//          which are allocated one after another, are adjacent in memory. *
+// Remarks: The pools are not thread-safe.                                 *
+//**************************************************************************
+
+/// \brief Kind of the storage of PoolAllocatorCL; the default is PooledAllocation.
+enum PoolAllocationT {
+    PooledAllocation, ///< objects are stored contiguously in the chunks of a MemoryPoolCL
+    HeapAllocation    ///< each object is allocated by operator new
+};
+
+/// \brief The storage of PoolAllocatorCL.
+inline PoolAllocationT& pool_allocation_mode ()
+{
+    static PoolAllocationT mode= PooledAllocation;
+    return mode;
+}
+
+/// \brief Select the storage of PoolAllocatorCL for the whole program.
+/// A pool adopts the mode only if it holds no objects, e.g. before the multigrid is built.
+inline void SetPoolAllocation (PoolAllocationT mode) { pool_allocation_mode()= mode; }
+/// \brief Returns the storage of PoolAllocatorCL.
+inline PoolAllocationT GetPoolAllocation () { return pool_allocation_mode(); }
+
+/// \brief Allocates objects of Size bytes in chunks of ChunkSize objects; deallocated objects are reused first.
+/// The addresses of the objects are stable. The chunks are released, when the last object is deallocated.
+template <size_t Size>
+class MemoryPoolCL
+{
+  private:
+    union SlotT
+    {
+        SlotT* next;          ///< next free slot
+        char   data[Size];
+        double align_d_;
+        void*  align_p_;
+    };
+    static const size_t ChunkSize= 1024;
+
+    std::vector<SlotT*> chunks_;
+    SlotT*              free_;   ///< list of deallocated slots
+    size_t              next_;   ///< first unused slot in chunks_.back()
+    size_t              live_;   ///< number of allocated objects
+    bool                pooled_; ///< false: use operator new; fixed, while objects are allocated
+
+    MemoryPoolCL () : free_( 0), next_( ChunkSize), live_( 0), pooled_( true) {}
+
+    void release () {
+        for (size_t i= 0; i < chunks_.size(); ++i)
+            delete[] chunks_[i];
+        chunks_.clear();
+        free_= 0;
+        next_= ChunkSize;
+    }
+
+  public:
+    /// \brief The pool is never destroyed, as objects may be deallocated during the destruction of static objects.
+    static MemoryPoolCL& Instance () {
+        static MemoryPoolCL* pool= new MemoryPoolCL;
+        return *pool;
+    }
+
+    void* allocate () {
+        if (live_++ == 0)
+            pooled_= GetPoolAllocation() == PooledAllocation;
+        if (!pooled_)
+            return ::operator new( Size);
+        if (free_ != 0) {
+            SlotT* s= free_;
+            free_= s->next;
+            return s;
+        }
+        if (next_ == ChunkSize) {
+            chunks_.push_back( new SlotT[ChunkSize]);
+            next_= 0;
+        }
+        return chunks_.back() + next_++;
+    }
+
+    void deallocate (void* p) {
+        if (!pooled_)
+            ::operator delete( p);
+        else {
+            SlotT* s= static_cast<SlotT*>( p);
+            s->next= free_;
+            free_= s;
+        }
+        if (--live_ == 0)
+            release();
+    }
+
+    size_t num_chunks () const { return chunks_.size(); }
+    size_t num_live   () const { return live_; }
+};
+
+/// \brief Standard allocator, which takes single objects from MemoryPoolCL<sizeof(T)>.
+///
+/// It is stateless, i.e. all instances are equal; thus, std::lists with this allocator can be spliced.
+/// Arrays of objects are allocated by operator new.
+template <class T>
+class PoolAllocatorCL
+{
+  public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind { typedef PoolAllocatorCL<U> other; };
+
+    PoolAllocatorCL () {}
+    template <class U>
+    PoolAllocatorCL (const PoolAllocatorCL<U>&) {}
+
+    pointer       address (reference x)       const { return &x; }
+    const_pointer address (const_reference x) const { return &x; }
+    size_type     max_size () const { return static_cast<size_type>( -1)/sizeof( T); }
+
+    pointer allocate (size_type n, const void* = 0) {
+        return static_cast<pointer>( n == 1 ? MemoryPoolCL<sizeof( T)>::Instance().allocate()
+                                            : ::operator new( n*sizeof( T)));
+    }
+    void deallocate (pointer p, size_type n) {
+        if (n == 1)
+            MemoryPoolCL<sizeof( T)>::Instance().deallocate( p);
+        else
+            ::operator delete( p);
+    }
+
+    void construct (pointer p, const T& val) { new (p) T( val); }
+    void destroy   (pointer p)               { p->~T(); }
+};
+
+template <class T, class U>
+inline bool operator== (const PoolAllocatorCL<T>&, const PoolAllocatorCL<U>&) { return true; }
+template <class T, class U>
+inline bool operator!= (const PoolAllocatorCL<T>&, const PoolAllocatorCL<U>&) { return false; }
+
 //**************************************************************************
 // Class:   GlobalListCL                                                   *
 // Purpose: A list that is subdivided in levels. For modifications, it can *
@@ -1248,12 +1394,12 @@ template <Uint Rows_, Uint Cols_>
 //          after modifications.                                           *
 // Remarks: Negative level-indices count backwards from end().             *
 //**************************************************************************
-template <class T>
+template <class T, class Alloc= std::allocator<T> >
 class GlobalListCL
 {
   public:
-    typedef std::list<T>                  Cont;
-    typedef std::list<T>                  LevelCont;
+    typedef std::list<T, Alloc>           Cont;
+    typedef std::list<T, Alloc>           LevelCont;
     typedef typename Cont::iterator       iterator;
     typedef typename Cont::const_iterator const_iterator;
     typedef typename LevelCont::iterator       LevelIterator;
@@ -1316,9 +1462,9 @@ class GlobalListCL
     }
 };
 
-template <class T>
+template <class T, class Alloc>
   void // Split Data_ into level-wise lists in LevelViews_.
-  GlobalListCL<T>::PrepareModify()
+  GlobalListCL<T, Alloc>::PrepareModify()
 {
     Assert( !modifiable_, DROPSErrCL("GlobalListCL::PrepareModify:"
         "Data is already modifiable."), DebugContainerC );
@@ -1337,9 +1483,9 @@ template <class T>
     modifiable_= true;
 }
 
-template <class T>
+template <class T, class Alloc>
   void // Merge LevelViews_ into Data_.
-  GlobalListCL<T>::FinalizeModify()
+  GlobalListCL<T, Alloc>::FinalizeModify()
 {
     Assert( modifiable_,
         DROPSErrCL("GlobalListCL::FinalizeModify: Data is not modifiable."),
@@ -1367,18 +1513,18 @@ template <class T>
     LevelViews_.clear();
 }
 
-template <class T>
+template <class T, class Alloc>
   void
-  GlobalListCL<T>::AppendLevel()
+  GlobalListCL<T, Alloc>::AppendLevel()
 {
     Assert( modifiable_, DROPSErrCL("GlobalListCL::AppendLevel: "
         "Data not modifiable."), DebugContainerC );
     LevelViews_.push_back( new LevelCont());
 }
 
-template <class T>
+template <class T, class Alloc>
   void
-  GlobalListCL<T>::RemoveLastLevel()
+  GlobalListCL<T, Alloc>::RemoveLastLevel()
 {
     Assert( modifiable_, DROPSErrCL("GlobalListCL::RemoveLast: "
         "Data not modifiable."), DebugContainerC );
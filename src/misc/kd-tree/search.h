@@ -284,6 +284,73 @@ namespace KDTree{
 
 
 
+    /* ******************************************************************** */
+    /*  B A T C H E D  S E A R C H                                          */
+    /* ******************************************************************** */
+
+    namespace internal {
+        /// \brief Sort points along a space filling curve
+        /** The points are ordered by their Morton code (Z-order) w.r.t. the bounding box bb.
+            Points outside the bounding box are projected onto it.
+            \param[in]  bb     the bounding box
+            \param[in]  p      point i is located at K*i,...,K*i+(K-1)
+            \param[in]  n      number of points
+            \param[out] order  the indices of the points sorted by the Morton code
+        */
+        template <typename T, usint K>
+        void morton_order( const BoundingBoxCL<T,K>& bb, T const * p, const size_t n, std::vector<size_t>& order)
+        {
+            const int bits= (8*sizeof(size_t))/K;                           // bits per dimension
+            std::vector< std::pair<size_t, size_t> > keys( n);
+#pragma omp parallel for
+            for ( int i=0; i<(int)n; ++i){
+                size_t c[K];
+                for ( usint d=0; d<K; ++d){
+                    const T len= bb[2*d+1]-bb[2*d];
+                    const T x= len>0 ? std::min( std::max( (p[K*i+d]-bb[2*d])/len, T(0)), T(1)) : T(0);
+                    c[d]= static_cast<size_t>( x*static_cast<T>( (size_t(1)<<bits)-1));
+                }
+                size_t key= 0;
+                for ( int b=bits-1; b>=0; --b)
+                    for ( usint d=0; d<K; ++d)
+                        key= (key<<1) | ((c[d]>>b) & 1);
+                keys[i]= std::make_pair( key, static_cast<size_t>( i));
+            }
+            std::sort( keys.begin(), keys.end());
+            order.resize( n);
+            for ( size_t i=0; i<n; ++i)
+                order[i]= keys[i].second;
+        }
+    }
+
+    /// \brief Perform a search for many query points
+    /** The query points are processed in the order of a space filling curve, so consecutive
+        searches traverse nearly the same nodes of the tree. Blocks of BatchBlockSize consecutive
+        queries are distributed dynamically among the threads.
+        \tparam SearchT   the search class, e.g., SearchNearestNeighborsCL or SearchNeighborsCL
+        \param  tree      the kd-tree
+        \param  queries   query point i is located at K*i,...,K*i+(K-1)
+        \param  n         number of query points
+        \param  arg       third argument of the constructor of SearchT, i.e., number of neighbors or radius
+        \param  f         after the search for query point i, f( i, searcher) is called; calls for different i may be concurrent
+    */
+    template <class SearchT, typename T, usint K, int BucketSize, typename ArgT, class FunT>
+    void search_batch( const TreeCL<T,K,BucketSize>& tree, T const * queries, const size_t n, const ArgT& arg, FunT& f)
+    {
+        if ( n==0)
+            return;
+        std::vector<size_t> order;
+        internal::morton_order<T,K>( tree.root()->bounding_box(), queries, n, order);
+#pragma omp parallel for schedule(dynamic, 64)
+        for ( int i=0; i<(int)n; ++i){
+            SearchT searcher( tree, queries+K*order[i], arg);
+            searcher.search();
+            f( order[i], searcher);
+        }
+    }
+
+
+
     /* ******************************************************************** */
     /*  D E F I N I T I O N   O F   T E M P L A T E   F U N C T I O N S     */
     /* ******************************************************************** */
@@ -31,6 +31,8 @@
 #include "misc/kd-tree/bounding_box.h"
 #include "misc/kd-tree/bucket.h"
 #include "misc/kd-tree/kd_tree_utils.h"
+#include <deque>
+#include <set>
 
 namespace DROPS{
 namespace KDTree{
@@ -44,6 +46,11 @@ namespace KDTree{
         construction. If such points are found, the equal points are represented 
         in the kd-tree by a single point.
 
+        The upper levels of the tree (the "hat") are built level by level, where
+        the nodes of a level are constructed in parallel. The remaining subtrees,
+        about SubtreesPerThread per thread, are built and optimized in parallel by
+        a dynamic schedule.
+
         \tparam T            type of a scalar data entry, e.g., component of a vector
         \tparam K            dimension of the space
         \tparam BucketSize   size of buckets
@@ -67,7 +74,9 @@ namespace KDTree{
         typedef std::vector<size_t>               ivector_type;             ///< type of an index vector
         typedef ivector_type::iterator            ivector_iterator;         ///< type of iterator of an index vector
         typedef std::queue<BuildTask>             build_queue_type;         ///< type of the queue that stores all nodes to be built
-        
+        typedef std::deque<BuildTask>             build_deque_type;         ///< type of a list of nodes to be built
+
+        enum { SubtreesPerThread= 8 };                                      ///< number of subtrees below the hat per thread
 
     private:  // ------- member variables ------- 
         tree_type&          p_tree;                                         ///< the tree to be built
@@ -85,8 +94,11 @@ namespace KDTree{
         T sort( const size_t&, const size_t&, const usint, size_t&);        ///< partition the index vector and return the median
         void buildLeaf( const size_t&, const size_t&, node_type*&);         ///< build the bucket of a leaf node and determine the exact bounding box
         void buildNode( BuildTask&, build_queue_type&);                     ///< build a single node
-        void buildRoot( std::vector<build_queue_type>&, const size_t);      ///< build the "widened" root node
+        void buildHat( build_deque_type&, std::vector<node_type*>&, const size_t); ///< build the upper levels of the tree
+        void buildSubtree( BuildTask&);                                     ///< build a subtree below the hat
+        size_t numPoints( const node_type*) const;                          ///< number of points stored in a subtree
         void optimize( size_t&, node_type*&);                               ///< optimize the storage of the points
+        void uniteHat( node_type*, const std::set<const node_type*>&);      ///< determine the bounding boxes of the hat
         void clear() { p_idxvec.clear(); }                                  ///< free the memory
         //@}
 
@@ -381,7 +393,6 @@ namespace KDTree{
             if ( node->sdim()==K) {     // this becomes a bucket node, since the largest spread is < eps
                 // merge the points in the interval [first,last)
                 buildLeaf( first, first+1, node);
-                p_skipped += last-first-1;
             }
             else {                      // the bounding box has a volume>eps^K
                 size_t start_right=last;
@@ -411,7 +422,6 @@ namespace KDTree{
                         std::cerr << "Giving up and combine all points in a single node :-(" << std::endl;
                     }
                     buildLeaf( first, first+1, node);
-                    p_skipped += last-first-1;
                 }
             }
         }
@@ -421,53 +431,71 @@ namespace KDTree{
     }
 
 
-    /** The "widened" root of the tree is constructed in the following approach. The root node 
-        (on level 0) is constructed by a single thread. The nodes on level 1 are constructed by
-        two threads, etc. That is, the nodes on level i are constructed by 2^i threads.
+    /** The upper levels of the tree are constructed level by level, all nodes of a level
+        in parallel. Tasks with at most n/(SubtreesPerThread*number of threads) points are
+        not built, but collected in \a subtrees. Nodes of the hat that become leaves, e.g.
+        because all their points are identical, are collected in \a leaves.
 
-        \param queues   the queue in queues[i] is assigned to the thread i
+        \param subtrees the roots of the subtrees below the hat
+        \param leaves   the leaves of the hat
         \param n        number of data points
     */
     template <typename T, usint K, int BucketSize>
-    void TreeBuilderCL<T,K,BucketSize>::buildRoot( std::vector<build_queue_type>& queues, const size_t n)
+    void TreeBuilderCL<T,K,BucketSize>::buildHat( build_deque_type& subtrees, std::vector<node_type*>& leaves, const size_t n)
     {
-        // if only a single thread is used, only the root is pushed into the queue
-        if ( get_num_threads()==1){
-            queues[0].push( BuildTask( 0, n, p_tree.root(), 0, true));
-            return;
-        }
-
-        // use maximal num_threads/2 threads to generate the sub roots of the first log2(num_threads) levels.
-        for ( int num_thr=1; num_thr<=get_num_threads()/2; num_thr*=2){
-#pragma omp parallel for num_threads(num_thr)
-            for ( int thread=0; thread<num_thr; ++thread){
-                BuildTask* sub_root=0;                                  // this node should be constructed
-                if ( num_thr==1){                                       // 0-th level, this is the root of the tree
-                    sub_root= new BuildTask( 0, n, p_tree.root(), 0, true);      
-                }
-                else{                                                   // it is constructed by the previous level
-                    if ( !queues[thread].empty()){
-                        sub_root= new BuildTask( queues[thread].front()); 
-                        queues[thread].pop();
-                    }
-                }
-                if ( sub_root!=0){                                      // for very small trees it may happen, that the tree is already constructed
-                    buildNode( *sub_root, queues[thread]);
-                    if ( !queues[thread].empty()){
-                        BuildTask left(  queues[thread].front()); queues[thread].pop();
-                        queues[thread*2+0].push( left);
-                    }
-                    if ( !queues[thread].empty()){
-                        BuildTask right( queues[thread].front()); queues[thread].pop();
-                        queues[thread*2+1].push( right);
-                    }
-                    delete sub_root;
+        const size_t max_subtree= std::max<size_t>( n/(SubtreesPerThread*get_num_threads()), BucketSize);
+        build_deque_type level;
+        (n>max_subtree ? level : subtrees).push_back( BuildTask( 0, n, p_tree.root(), 0, true));
+        while ( !level.empty()){
+            std::vector<build_queue_type> children( level.size());
+#pragma omp parallel for schedule(dynamic)
+            for ( int i=0; i<(int)level.size(); ++i){
+                buildNode( level[i], children[i]);
+            }
+            for ( size_t i=0; i<level.size(); ++i){     // the children of internal nodes are not built yet, so isLeaf cannot be used
+                if ( level[i].node->sdim()==K)
+                    leaves.push_back( level[i].node);
+            }
+            level.clear();
+            for ( size_t i=0; i<children.size(); ++i){
+                for ( ; !children[i].empty(); children[i].pop()){
+                    const BuildTask& task= children[i].front();
+                    (task.last-task.first>max_subtree ? level : subtrees).push_back( task);
                 }
             }
         }
     }
 
 
+    /** Build all nodes of the subtree specified by \a task.*/
+    template <typename T, usint K, int BucketSize>
+    void TreeBuilderCL<T,K,BucketSize>::buildSubtree( BuildTask& task)
+    {
+        build_queue_type queue;
+        buildNode( task, queue);
+        while ( !queue.empty()){
+            BuildTask subtask( queue.front());
+            queue.pop();
+            buildNode( subtask, queue);
+        }
+    }
+
+
+    /** Count the points stored in the buckets of the subtree with root \a node. Identical
+        points are stored only once.*/
+    template <typename T, usint K, int BucketSize>
+    size_t TreeBuilderCL<T,K,BucketSize>::numPoints( const node_type* node) const
+    {
+        if ( node->isLeaf()){
+            size_t num= 0;
+            for ( int i=0; i<BucketSize && node->bucket()[i]!=NoIdx; ++i)
+                ++num;
+            return num;
+        }
+        return (node->hasLeft() ? numPoints( node->left()) : 0) + (node->hasRight() ? numPoints( node->right()) : 0);
+    }
+
+
     /** The memory layout to store all the points is optimized in the following 
         way. All points addressed by a single bucket are aligned consecutively
         in the memory. 
@@ -511,6 +539,28 @@ namespace KDTree{
     }
 
 
+    /** Determine the bounding boxes of the nodes of the hat by uniting the bounding boxes of
+        their children. The bounding boxes of the subtrees are determined by optimize.
+        \param node           node of the hat
+        \param subtree_roots  roots of the subtrees below the hat
+    */
+    template <typename T, usint K, int BucketSize>
+    void TreeBuilderCL<T,K,BucketSize>::uniteHat( node_type* node, const std::set<const node_type*>& subtree_roots)
+    {
+        if ( subtree_roots.count( node)!=0)
+            return;
+        if ( node->hasLeft()){
+            uniteHat( node->left(), subtree_roots);
+        }
+        if ( node->hasRight()){
+            uniteHat( node->right(), subtree_roots);
+        }
+        if ( node->hasChildren()){
+            uniteBB( node);
+        }
+    }
+
+
     /** Build a kd-tree that covers the \a n points located in the field. The field
         data is not changed by this routine. However, the kd-tree does not
         actually store the data but references to the data. Therefore, it is necessary
@@ -531,26 +581,39 @@ namespace KDTree{
         for ( size_t i=0; i<n; ++i) 
             p_idxvec[i]= i;
 
-        // for each thread a single queue is used
-        std::vector<build_queue_type> queues( get_num_threads());
-
-        // build the hat (= "widend" root) of the tree
-        buildRoot( queues, n);
+        // build the hat of the tree ...
+        build_deque_type subtrees;
+        std::vector<node_type*> roots;      // roots of the subtrees and leaves of the hat
+        buildHat( subtrees, roots, n);
 
-#pragma omp parallel for
-        for ( int thread=0; thread<get_num_threads(); ++thread){
-            while ( !queues[thread].empty()){
-                BuildTask task( queues[thread].front());
-                queues[thread].pop();
-                buildNode( task, queues[thread]);
-            }
+        // ... and the subtrees below
+#pragma omp parallel for schedule(dynamic)
+        for ( int i=0; i<(int)subtrees.size(); ++i){
+            buildSubtree( subtrees[i]);
+        }
+        for ( size_t i=0; i<subtrees.size(); ++i){
+            roots.push_back( subtrees[i].node);
         }
 
-        // optimize the data
+        // optimize the data; the points of root i are stored from position offset[i] on
+        std::vector<size_t> offset( roots.size()+1, 0);
+#pragma omp parallel for schedule(dynamic)
+        for ( int i=0; i<(int)roots.size(); ++i){
+            offset[i+1]= numPoints( roots[i]);
+        }
+        for ( size_t i=0; i<roots.size(); ++i){
+            offset[i+1]+= offset[i];
+        }
+        p_skipped= n-offset.back();
         p_tree.data().resize( (n-p_skipped)*K);
         p_tree.origidx().resize( (n-p_skipped)*K);
-        size_t first_free=0;
-        optimize( first_free, p_tree.root());
+        std::set<const node_type*> subtree_roots( roots.begin(), roots.end());
+#pragma omp parallel for schedule(dynamic)
+        for ( int i=0; i<(int)roots.size(); ++i){
+            size_t first_free= offset[i];
+            optimize( first_free, roots[i]);
+        }
+        uniteHat( p_tree.root(), subtree_roots);
         
         // free the memory
         clear();
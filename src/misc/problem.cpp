@@ -32,10 +32,12 @@ namespace DROPS
 
 const Uint        IdxDescCL::InvalidIdx = std::numeric_limits<Uint>::max();
 std::vector<bool> IdxDescCL::IdxFree;
+size_t            IdxDescCL::NumbVersionCount= 0;
 
 IdxDescCL::IdxDescCL( FiniteElementT fe, const BndCondCL& bnd, match_fun match, double omit_bound)
     : FE_InfoCL( fe), Idx_( GetFreeIdx()), TriangLevel_( 0), NumUnknowns_( 0), Bnd_(bnd),
-      extIdx_( omit_bound != -99 ? omit_bound : IsExtended() ? 1./32. : -1.) // default value is 1./32. for XFEM and -1 otherwise
+      extIdx_( omit_bound != -99 ? omit_bound : IsExtended() ? 1./32. : -1.), // default value is 1./32. for XFEM and -1 otherwise
+      NumbVersion_( 0)
 {
     Bnd_.SetMatchingFunction( match);
 #ifdef _PAR
@@ -66,7 +68,7 @@ Uint IdxDescCL::GetFreeIdx()
 
 IdxDescCL::IdxDescCL( const IdxDescCL& orig)
  : FE_InfoCL(orig), Idx_(orig.Idx_), TriangLevel_(orig.TriangLevel_), NumUnknowns_(orig.NumUnknowns_),
-   Bnd_(orig.Bnd_), extIdx_(orig.extIdx_)
+   Bnd_(orig.Bnd_), extIdx_(orig.extIdx_), NumbVersion_(orig.NumbVersion_)
 {
     // invalidate orig
     const_cast<IdxDescCL&>(orig).Idx_= InvalidIdx;
@@ -88,6 +90,7 @@ void IdxDescCL::swap( IdxDescCL& obj)
     std::swap( NumUnknowns_, obj.NumUnknowns_);
     std::swap( Bnd_,         obj.Bnd_);
     std::swap( extIdx_,      obj.extIdx_);
+    std::swap( NumbVersion_, obj.NumbVersion_);
     std::swap( ex_,          obj.ex_);
 }
 
@@ -419,15 +422,18 @@ void IdxDescCL::CreateNumbering( Uint level, MultiGridCL& mg, const VecDescCL* l
             NumUnknowns_= extIdx_.UpdateXNumbering( this, mg, *lsetp, *lsetbnd, true);
         }
     }
+    NumbVersion_= ++NumbVersionCount;
 #ifdef _PAR
     ex_->CreateList(mg, this, true, true);
 #endif
 }
 
-void IdxDescCL::UpdateXNumbering( MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd)
+void IdxDescCL::UpdateXNumbering( MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd,
+    MultiGridCL::const_TriangTetraIteratorCL cut_begin, MultiGridCL::const_TriangTetraIteratorCL cut_end)
 {
     if (IsExtended()) {
-        NumUnknowns_= extIdx_.UpdateXNumbering( this, mg, lset, lsetbnd, false);
+        NumUnknowns_= extIdx_.UpdateXNumbering( this, mg, lset, lsetbnd, false, cut_begin, cut_end);
+        NumbVersion_= ++NumbVersionCount;
 #ifdef _PAR
         ex_->CreateList(mg, this, true, true);
 #endif
@@ -457,6 +463,7 @@ void IdxDescCL::DeleteNumbering(MultiGridCL& MG)
     const Uint idxnum = GetIdx();    // idx is the index in UnknownIdxCL
     const Uint level  = -1;          // last level
     NumUnknowns_ = 0;
+    NumbVersion_= ++NumbVersionCount;
 
     // delete memory allocated for indices
     if (NumUnknownsVertex())
@@ -473,7 +480,8 @@ void IdxDescCL::DeleteNumbering(MultiGridCL& MG)
 #endif
 }
 
-IdxT ExtIdxDescCL::UpdateXNumbering( IdxDescCL* Idx, const MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd, bool NumberingChanged)
+IdxT ExtIdxDescCL::UpdateXNumbering( IdxDescCL* Idx, const MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd, bool NumberingChanged,
+    MultiGridCL::const_TriangTetraIteratorCL cut_begin, MultiGridCL::const_TriangTetraIteratorCL cut_end)
 {
     const Uint sysnum= Idx->GetIdx(),
         level= Idx->TriangLevel(),
@@ -495,7 +503,11 @@ IdxT ExtIdxDescCL::UpdateXNumbering( IdxDescCL* Idx, const MultiGridCL& mg, cons
     }
     LocalP2CL<> locPhi;
 
-    DROPS_FOR_TRIANG_CONST_TETRA( mg, level, it)
+    if (cut_begin == cut_end) {
+        cut_begin= mg.GetTriangTetraBegin( level);
+        cut_end=   mg.GetTriangTetraEnd( level);
+    }
+    for (MultiGridCL::const_TriangTetraIteratorCL it= cut_begin; it != cut_end; ++it)
     {
         const double h3= it->GetVolume()*6,
             h= cbrt( h3), h5= h*h*h3, // h^5
@@ -211,7 +211,11 @@ class ExtIdxDescCL
     /// Has to be called in two situations:
     /// - whenever level set function has changed to account for the moving interface (set \p NumberingChanged=false)
     /// - when numbering of index has changed, i.e. \p CreateNumbering was called before (set \p NumberingChanged=true)
-    IdxT UpdateXNumbering( IdxDescCL*, const MultiGridCL&, const VecDescCL&, const BndDataCL<>& lsetbnd, bool NumberingChanged= false );
+    ///
+    /// If \p cut_begin != \p cut_end, only the tetras in [cut_begin, cut_end) are checked; they must contain all tetras of the
+    /// triangulation, which are cut by the interface, in the order of the triangulation, e.g. InterfaceTetraListCL::cut_begin/cut_end.
+    IdxT UpdateXNumbering( IdxDescCL*, const MultiGridCL&, const VecDescCL&, const BndDataCL<>& lsetbnd, bool NumberingChanged= false,
+        MultiGridCL::const_TriangTetraIteratorCL cut_begin= 0, MultiGridCL::const_TriangTetraIteratorCL cut_end= 0);
     /// \brief Delete extended numbering
     void DeleteXNumbering() { Xidx_.resize(0); Xidx_old_.resize(0); }
 
@@ -261,12 +265,14 @@ class IdxDescCL: public FE_InfoCL
   private:
     static const Uint        InvalidIdx;   ///< Constant representing an invalid index.
     static std::vector<bool> IdxFree;      ///< Cache for unused indices; reduces memory-usage.
+    static size_t            NumbVersionCount; ///< Number of numberings created by all IdxDescCL-objects.
 
     Uint                     Idx_;         ///< The unique index.
     Uint                     TriangLevel_; ///< Triangulation of the index.
     IdxT                     NumUnknowns_; ///< total number of unknowns on the triangulation
     BndCondCL                Bnd_;         ///< boundary conditions and  matching function for periodic boundaries
     ExtIdxDescCL             extIdx_;      ///< extended index for XFEM
+    size_t                   NumbVersion_; ///< unique version of the current numbering; 0, if there is none
 
 #ifdef _PAR
     ExchangeCL*              ex_;          ///< exchanging numerical data
@@ -319,6 +325,9 @@ class IdxDescCL: public FE_InfoCL
     Uint TriangLevel() const { return TriangLevel_; }
     /// \brief total number of unknowns on the triangulation
     IdxT NumUnknowns() const { return NumUnknowns_; }
+    /// \brief Version of the numbering; each call of CreateNumbering, UpdateXNumbering or DeleteNumbering (of any IdxDescCL-object) yields a new version.
+    /// It can be used as key to detect, that the sparsity pattern of a matrix is still valid, cf. SparseMatBaseCL::SetPatternKey.
+    size_t GetNumberingVersion() const { return NumbVersion_; }
     /// \brief Compare two IdxDescCL-objects. If a multigrid is given via mg, the
     ///     unknown-numbers on it are compared, too.
     static bool
@@ -334,7 +343,9 @@ class IdxDescCL: public FE_InfoCL
     void CreateNumbering( Uint level, MultiGridCL& mg, const IdxDescCL& baseIdx, const VecDescCL* lsetp= 0, const BndDataCL<>* lsetbnd =0);
     /// \brief Update numbering of extended DoFs.
     /// Has to be called whenever level set function has changed to account for the moving interface.
-    void UpdateXNumbering( MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd);
+    /// See ExtIdxDescCL::UpdateXNumbering for the range of cut tetras.
+    void UpdateXNumbering( MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd,
+        MultiGridCL::const_TriangTetraIteratorCL cut_begin= 0, MultiGridCL::const_TriangTetraIteratorCL cut_end= 0);
     /// \brief Returns true, if XFEM is used and standard DoF \p dof is extended.
     bool IsExtended( IdxT dof) const
     { return IsExtended() ? extIdx_[dof] != NoIdx : false; }
@@ -441,10 +452,15 @@ class MLIdxDescCL : public MLDataCL<IdxDescCL>
     }
     /// \brief Update numbering of extended DoFs on all levels.
     /// Has to be called whenever level set function has changed to account for the moving interface.
-    void UpdateXNumbering( MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd)
+    /// The range of cut tetras (see ExtIdxDescCL::UpdateXNumbering) is only used on the finest level.
+    void UpdateXNumbering( MultiGridCL& mg, const VecDescCL& lset, const BndDataCL<>& lsetbnd,
+        MultiGridCL::const_TriangTetraIteratorCL cut_begin= 0, MultiGridCL::const_TriangTetraIteratorCL cut_end= 0)
     {
         for (MLIdxDescCL::iterator it = this->begin(); it != this->end(); ++it)
-            it->UpdateXNumbering( mg, lset, lsetbnd);
+            if (&*it == &this->GetFinest())
+                it->UpdateXNumbering( mg, lset, lsetbnd, cut_begin, cut_end);
+            else
+                it->UpdateXNumbering( mg, lset, lsetbnd);
     }
     /// \brief Mark unknown-indices as invalid on all levels.
     void DeleteNumbering( MultiGridCL& mg)
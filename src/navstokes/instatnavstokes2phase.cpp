@@ -42,8 +42,8 @@ class LocalNonlConvSystemOnePhase_P2CL
   private:
     double rho_;
 
-    Quad5CL<Point3DCL> Grad[10], GradRef[10];
-    Quad5CL<Point3DCL> vel_;
+    SQuad5CL<Point3DCL> Grad[10], GradRef[10];
+    SQuad5CL<Point3DCL> vel_;
     const SVectorCL<Quad2DataCL::NumNodesC> Ones;
 
   public:
@@ -52,7 +52,7 @@ class LocalNonlConvSystemOnePhase_P2CL
     { P2DiscCL::GetGradientsOnRef( GradRef); }
 
     void   velocity  (const LocalP2CL<Point3DCL> & velp2)          { vel_.assign(velp2); }
-    const Quad5CL<Point3DCL> & velocity  () const { return vel_;        }
+    const SQuad5CL<Point3DCL> & velocity  () const { return vel_;        }
 
     void   rho (double new_rho)                   { rho_= new_rho;      }
     double rho () const                           { return rho_;        }
@@ -63,9 +63,10 @@ class LocalNonlConvSystemOnePhase_P2CL
 void LocalNonlConvSystemOnePhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, LocalNonlConvDataCL& loc)
 {
     P2DiscCL::GetGradients( Grad, GradRef, T);
-    for (Uint i= 0; i < 10; ++i) {
-        for (Uint j= 0; j < 10; ++j) {
-            loc.C[i][j]= rho() * Quad5CL<>( dot(velocity(),Grad[j])).quadP2(i,absdet);
+    for (Uint j= 0; j < 10; ++j) {
+        const SQuad5CL<> convection( dot( velocity(), Grad[j]));
+        for (Uint i= 0; i < 10; ++i) {
+            loc.C[i][j]= rho() * convection.quadP2(i,absdet);
         }
     }
 }
@@ -78,10 +79,10 @@ class LocalNonlConvSystemSmoothedJumps_P2CL
   private:
     const SmoothedJumpCL & rho_;
     
-    Quad5CL<Point3DCL> Grad[10], GradRef[10];
-    Quad5CL<Point3DCL> vel_;
-    Quad5CL<double> lset_;
-    Quad5CL<double> qrho_;
+    SQuad5CL<Point3DCL> Grad[10], GradRef[10];
+    SQuad5CL<Point3DCL> vel_;
+    SQuad5CL<double> lset_;
+    SQuad5CL<double> qrho_;
     const SVectorCL<Quad2DataCL::NumNodesC> Ones;
 
   public:
@@ -93,15 +94,15 @@ class LocalNonlConvSystemSmoothedJumps_P2CL
     }
 
     void   velocity  (const LocalP2CL<Point3DCL> & velp2) { vel_.assign(velp2); }
-    const Quad5CL<Point3DCL> & velocity  () const   { return vel_;        }
+    const SQuad5CL<Point3DCL> & velocity  () const   { return vel_;        }
 
     void   levelset  (const LocalP2CL<double> & lsetp2) { 
         lset_.assign(lsetp2); 
         qrho_ = lset_;
         qrho_.apply( rho_);
     }
-    const Quad5CL<double> & levelset () const     { return lset_;  }
-    const Quad5CL<double> & smoothed_rho () const { return qrho_; }
+    const SQuad5CL<double> & levelset () const     { return lset_;  }
+    const SQuad5CL<double> & smoothed_rho () const { return qrho_; }
 
     void setup (const SMatrixCL<3,3>& T, double absdet, LocalNonlConvDataCL& loc);
 };
@@ -109,9 +110,10 @@ class LocalNonlConvSystemSmoothedJumps_P2CL
 void LocalNonlConvSystemSmoothedJumps_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, LocalNonlConvDataCL& loc)
 {
     P2DiscCL::GetGradients( Grad, GradRef, T);
-    for (Uint i= 0; i < 10; ++i) {
-        for (Uint j= 0; j < 10; ++j) {
-            loc.C[i][j]= Quad5CL<>( smoothed_rho() * dot(velocity(),Grad[j])) .quadP2(i,absdet);
+    for (Uint j= 0; j < 10; ++j) {
+        const SQuad5CL<> convection( smoothed_rho() * dot( velocity(), Grad[j]));
+        for (Uint i= 0; i < 10; ++i) {
+            loc.C[i][j]= convection.quadP2(i,absdet);
         }
     }
 }
@@ -136,6 +138,8 @@ class LocalNonlConvSystemTwoPhase_P2CL
 
     std::valarray<double> qshape[10];
     GridFunctionCL<Point3DCL> qdshape[10];
+    GridFunctionCL<Point3DCL> velocity;
+    GridFunctionCL<double> convection;
 
     double intpos, intneg;
     SMatrixCL<3,3> cAkp, cAkn;
@@ -158,16 +162,19 @@ void LocalNonlConvSystemTwoPhase_P2CL::setup (const SMatrixCL<3,3>& T, double ab
     evaluate_on_vertexes( ls, lat, Addr( ls_loc));
     partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc);
     make_CompositeQuad5Domain( q5dom, partition);
-    GridFunctionCL<Point3DCL> velocity;
     resize_and_evaluate_on_vertexes( velp2, q5dom, velocity);
     for (int i= 0; i < 10; ++i) {
         p2[i]= 1.; p2[i==0 ? 9 : i - 1]= 0.;
         resize_and_evaluate_on_vertexes( p2,      q5dom,  qshape[i]); // shape 
         resize_and_evaluate_on_vertexes( Grad[i], q5dom, qdshape[i]); // gradient shape
     }
-    for (int i= 0; i < 10; ++i) {
-        for (int j= 0; j < 10; ++j) {
-            quad( qshape[i]*dot(velocity,qdshape[j]), absdet, q5dom, intneg, intpos);
+    if (convection.size() != velocity.size())
+        convection.resize( velocity.size());
+    for (int j= 0; j < 10; ++j) {
+        for (size_t k= 0; k < velocity.size(); ++k)
+            convection[k]= inner_prod( velocity[k], qdshape[j][k]);
+        for (int i= 0; i < 10; ++i) {
+            quad( make_ProductExpression( qshape[i], convection), absdet, q5dom, intneg, intpos);
             loc.C[i][j]= rho_p*intpos + rho_n*intneg;
         }
     }
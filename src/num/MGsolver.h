@@ -30,6 +30,8 @@
 
 #include <list>
 #include <cstring>
+#include <cmath>
+#include <iterator>
 
 namespace DROPS
 {
@@ -80,12 +82,80 @@ void MG(const MLMatrixCL& MGData, const ProlongationT& Prolong, const SmootherCL
         DirectSolverCL&, VectorCL& x, const VectorCL& b, const MLIdxDescCL& idx, int& maxiter, double& tol,
         const bool residerr= true, Uint sm=1, int lvl=-1);
 
+/// \brief Prepare the coarse grid solver of MGSolverCL for the matrix A
+/** Iterative coarse grid solvers need no setup; solvers with a factorization
+    are wrapped by MGDirectCoarseSolverCL, see the overload below. */
+template<class DirectSolverT>
+inline void SetupCoarseSolver( DirectSolverT&, const MatrixCL&) {}
+
+/*******************************************************************
+*   M G D i r e c t C o a r s e S o l v e r  C L                   *
+*******************************************************************/
+/// \brief Coarse grid solver for MGSolverCL with a factorization of the coarse matrix
+/** DirectT is DirectSymmSolverCL or DirectNonSymmSolverCL from num/directsolver.h (SuiteSparse),
+    SparseCholeskySolverCL or SparseLUSolverCL from num/sparsedirect.h, or any class with the constructor DirectT(const MatrixCL&) and the members
+    Update(const MatrixCL&) and Solve(const MatrixCL&, VectorCL&, const VectorCL&).
+    The matrix is only factorized in Update, i.e. in the setup of MGSolverCL, and only
+    if it has been modified since the last factorization. */
+/*******************************************************************
+*   M G D i r e c t C o a r s e S o l v e r  C L                   *
+********************************************************************/
+template<class DirectT>
+class MGDirectCoarseSolverCL
+{
+  private:
+    DirectT*        solver_;
+    const MatrixCL* A_;          ///< factorized matrix
+    size_t          version_;    ///< version of A_ at the factorization
+    Uint            numFact_;    ///< number of factorizations
+
+    MGDirectCoarseSolverCL( const MGDirectCoarseSolverCL&);            // not defined
+    MGDirectCoarseSolverCL& operator=( const MGDirectCoarseSolverCL&); // not defined
+
+  public:
+    MGDirectCoarseSolverCL() : solver_( 0), A_( 0), version_( 0), numFact_( 0) {}
+    ~MGDirectCoarseSolverCL() { delete solver_; }
+
+    /// factorizes A, if it is not the factorized matrix
+    void Update( const MatrixCL& A)
+    {
+        if (&A == A_ && A.Version() == version_)
+            return;
+        if (solver_ == 0)
+            solver_= new DirectT( A);
+        else
+            solver_->Update( A);
+        A_= &A;
+        version_= A.Version();
+        ++numFact_;
+    }
+    /// solves with the last factorization; A is only factorized, if there is none
+    template<typename ExT>
+    void Solve( const MatrixCL& A, VectorCL& x, const VectorCL& b, const ExT&)
+    {
+        if (solver_ == 0)
+            Update( A);
+        solver_->Solve( A, x, b);
+    }
+    Uint GetNumFactorizations() const { return numFact_; }
+};
+
+template<class DirectT>
+inline void SetupCoarseSolver( MGDirectCoarseSolverCL<DirectT>& solver, const MatrixCL& A) { solver.Update( A); }
+
 /*******************************************************************
 *   M G S o l v e r  C L                                           *
 *******************************************************************/
 /// \brief MultiGrid solver for a single matrix problem
 /** Uses a Multigrid structure for a single matrix, e.g.
-    a poisson problem or the A-block of a (navier-)stokes problem */
+    a poisson problem or the A-block of a (navier-)stokes problem.
+
+    By default, the smoothers and the coarse grid solver are set up in each call of Solve.
+    After SetReuse( degradation) with degradation > 0, the setup is reused for modified
+    matrices, e.g. in the following time steps, as long as the number of levels and
+    unknowns does not change. Each Solve measures the average contraction rate of the
+    residual; if it exceeds degradation times the rate of the first solve after the last
+    setup, the setup is repeated in the next call of Solve. */
 /*******************************************************************
 *   M G S o l v e r  C L                                           *
 ********************************************************************/
@@ -101,6 +171,44 @@ class MGSolverCL : public SolverBaseCL
     Uint               smoothSteps_;      ///< number of smoothing steps
     int                usedLevels_;       ///< number of used levels (-1 = all)
 
+    double              degradation_;     ///< factor for the contraction rate, which triggers a new setup (<= 0: setup in each solve)
+    bool                setup_;           ///< set up in the next solve
+    double              rateRef_;         ///< contraction rate of the first solve after the last setup (< 0: not measured yet)
+    double              rate_;            ///< contraction rate of the last solve
+    Uint                numSetup_;        ///< number of setups
+    std::vector<size_t> numRows_;         ///< number of unknowns on each level in the last setup
+
+    /// matrix, which is solved by the coarse grid solver
+    const MatrixCL& CoarseMatrix( const MLMatrixCL& A) const
+    {
+        MLMatrixCL::const_iterator it= A.begin();
+        if (usedLevels_ >= 0 && static_cast<size_t>( usedLevels_) < A.size())
+            std::advance( it, A.size() - 1 - usedLevels_);
+        return *it;
+    }
+    bool SameLevels( const MLMatrixCL& A) const
+    {
+        if (A.size() != numRows_.size())
+            return false;
+        std::vector<size_t>::const_iterator n= numRows_.begin();
+        for (MLMatrixCL::const_iterator it= A.begin(); it != A.end(); ++it, ++n)
+            if (it->num_rows() != *n)
+                return false;
+        return true;
+    }
+    void Setup( const MLMatrixCL& A)
+    {
+        smoother_.SetDiag( A, idx_);
+        SetupCoarseSolver( directSolver_, CoarseMatrix( A));
+        numRows_.clear();
+        for (MLMatrixCL::const_iterator it= A.begin(); it != A.end(); ++it)
+            numRows_.push_back( it->num_rows());
+        setup_= false;
+        rateRef_= -1.;
+        ++numSetup_;
+    }
+    double Residual( const MLMatrixCL& A, const VectorCL& x, const VectorCL& b) const;
+
   public:
     /// constructor for MGSolverCL
     /** \param sm         multigrid smoother
@@ -113,17 +221,34 @@ class MGSolverCL : public SolverBaseCL
     MGSolverCL( SmootherT& sm, DirectSolverT& ds, int maxiter,
                 double tol, const MLIdxDescCL& idx, const bool residerr= true, Uint smsteps= 1, int lvl= -1 )
         : SolverBaseCL(maxiter, tol), smoother_(sm), directSolver_(ds), idx_(idx),
-          residerr_(residerr), smoothSteps_(smsteps), usedLevels_(lvl) {}
+          residerr_(residerr), smoothSteps_(smsteps), usedLevels_(lvl),
+          degradation_( 0.), setup_( true), rateRef_( -1.), rate_( 0.), numSetup_( 0) {}
 
     ProlongationT* GetProlongation() { return &P; }
     /// solve function: calls the MultiGrid-routine
     template<typename ExT>
     void Solve(const MLMatrixCL& A, VectorCL& x, const VectorCL& b, const ExT&)
     {
-        smoother_.SetDiag(A, idx_);
+        if (degradation_ <= 0.) {
+            Setup( A);
+            res_=  tol_;
+            iter_= maxiter_;
+            MG( A, P, smoother_, directSolver_, x, b, idx_, iter_, res_, residerr_, smoothSteps_, usedLevels_);
+            return;
+        }
+        if (setup_ || !SameLevels( A))
+            Setup( A);
+        const double res0= Residual( A, x, b);
         res_=  tol_;
         iter_= maxiter_;
         MG( A, P, smoother_, directSolver_, x, b, idx_, iter_, res_, residerr_, smoothSteps_, usedLevels_);
+        if (iter_ == 0 || res0 == 0.)
+            return;
+        rate_= std::pow( Residual( A, x, b)/res0, 1./iter_);
+        if (rateRef_ < 0.)
+            rateRef_= rate_;
+        else if (!(rate_ <= degradation_*rateRef_)) // also catches divergence to nan
+            setup_= true;
     }
     template<typename ExT>
     void Solve(const MatrixCL&, VectorCL&, const VectorCL&, const ExT&)
@@ -134,6 +259,18 @@ class MGSolverCL : public SolverBaseCL
     bool NeedDiag()  {return false; } // diag is saved during solve
     template<typename Mat, typename ExT>
     void SetDiag(const Mat&, const ExT&) {}
+
+    /// \brief Reuse the setup until the contraction rate exceeds degradation times the rate after the setup; degradation <= 0 switches the reuse off.
+    void SetReuse( double degradation)
+    {
+        degradation_= degradation;
+        setup_= true;
+        smoother_.CheckMatVersion( degradation <= 0.);
+    }
+    /// \brief Number of setups of the smoothers and the coarse grid solver
+    Uint GetNumSetups() const { return numSetup_; }
+    /// \brief Average contraction rate of the residual in the last solve; only measured, if the setup is reused.
+    double GetRate() const { return rate_; }
 };
 
 /// checks multigrid structure
@@ -156,6 +156,12 @@ void MG(const MLMatrixCL& MGData, const ProlongationT& Prolong, const SmootherCL
     tol= resid;
 }
 
+template<class SmootherT, class DirectSolverT, class ProlongationT>
+double MGSolverCL<SmootherT, DirectSolverT, ProlongationT>::Residual( const MLMatrixCL& A, const VectorCL& x, const VectorCL& b) const
+{
+    return idx_.GetFinest().GetEx().Norm( VectorCL( b - A.GetFinest()*x), false);
+}
+
 template<class StokesSmootherCL, class StokesDirectSolverCL, class ProlongItT1, class ProlongItT2>
 void StokesMGM( const MLMatrixCL::const_iterator& beginA,  const MLMatrixCL::const_iterator& fineA,
                 const MLMatrixCL::const_iterator& fineB,   const MLMatrixCL::const_iterator& fineBT, 
@@ -50,6 +50,15 @@ class AccumulatorCL
     /// \brief Called exactly once for each element of the visited sequence.
     virtual void visit (const VisitedT& t)= 0;
 
+    /// \brief Maximal number of objects per call of visit_block; 1 means that the accumulator only implements visit.
+    virtual size_t block_size () const { return 1; }
+    /// \brief Called instead of visit for the n <= block_size() objects *t[0], ..., *t[n-1], if all accumulators of the AccumulatorTupleCL support blocks.
+    ///
+    /// The objects of a block may share unknowns, e.g., consecutive tetras in operator()(begin, end) or in an interior part of a
+    /// TriangPartitionCL. Overriding accumulators evaluate the local matrices of the block in structure-of-arrays layout, but must
+    /// add them to the global data as visit does for a sequence of single objects.
+    virtual void visit_block (const VisitedT* const* t, size_t n) { for (size_t i= 0; i < n; ++i) visit( *t[i]); }
+
     /// \brief Returns a pointer to a copy of the actual instantiation of this class
     /// \param clone_id the thread-id, in which the clone will run. Useful to locate cloned helper objects.
     virtual AccumulatorCL* clone (int clone_id)= 0;
@@ -63,13 +72,44 @@ typedef AccumulatorCL<TetraCL> TetraAccumulatorCL;
 /// \brief Accumulation over sequences of FaceCL.
 typedef AccumulatorCL<FaceCL> FaceAccumulatorCL;
 
+/// \brief Strategy of the OpenMP-parallel accumulation over the tetras of a triangulation.
+enum TetraAccumulationT {
+    ColoredAccumulation,    ///< one parallel region per color class of the ColorClassesCL
+    PartitionedAccumulation ///< a single parallel region for a TriangPartitionCL: the interior tetras of the parts, then the color classes of the separator
+};
+
+/// \brief The accumulation strategy; the default is ColoredAccumulation.
+inline TetraAccumulationT& tetra_accumulation_mode ()
+{
+    static TetraAccumulationT mode= ColoredAccumulation;
+    return mode;
+}
+
+/// \brief Select the strategy of the OpenMP-parallel accumulation over tetras for the whole program.
+inline void SetTetraAccumulation (TetraAccumulationT mode) { tetra_accumulation_mode()= mode; }
+/// \brief Returns the strategy of the OpenMP-parallel accumulation over tetras.
+inline TetraAccumulationT GetTetraAccumulation () { return tetra_accumulation_mode(); }
+
+/// \brief Whether AccumulatorTupleCL calls visit_block; the default is true.
+inline bool& block_accumulation_mode ()
+{
+    static bool mode= true;
+    return mode;
+}
+
+/// \brief Enable or disable the batched accumulation with AccumulatorCL::visit_block for the whole program.
+inline void SetBlockAccumulation (bool mode) { block_accumulation_mode()= mode; }
+/// \brief Returns whether the batched accumulation with AccumulatorCL::visit_block is enabled.
+inline bool GetBlockAccumulation () { return block_accumulation_mode(); }
+
 /// \brief A tuple of accumulators plus the iteration logic.
 ///
 /// The accumulators are stored via pointers to AccumulatorCL.
-/// There are two ways to accumulate: First, a pair of external iterators, defining the sequence of VisitedT-objects to be visited, can be provided. Second, a ColorClassesCL-object can be used. This results in OpenMP-parallel accumulation on each color-class. The accumulators are cloned after begin_accumulation, visit is called OpenMP-parallel, and the clones are destroyed. finalize_accumulation is called only for the original accumulators.
+/// There are three ways to accumulate: First, a pair of external iterators, defining the sequence of VisitedT-objects to be visited, can be provided. Second, a ColorClassesCL-object can be used. This results in OpenMP-parallel accumulation on each color-class. Third, a TriangPartitionCL-object can be used. This results in OpenMP-parallel accumulation in a single parallel region: The parts of interior tetras are distributed dynamically to the threads; afterwards, the color classes of the separator tetras are visited. In the latter two cases, the accumulators are cloned after begin_accumulation, visit is called OpenMP-parallel, and the clones are destroyed. finalize_accumulation is called only for the original accumulators.
 /// It is valid to accumulate an empty AccumulatorTupleCL-object and to accumulate over empty sets of VisitedT.
 ///
 /// For each visited  object t, the accumulators are called in the sequence of their registration.
+/// If all accumulators support blocks (block_size() > 1) and GetBlockAccumulation() is true, visit_block is called instead of visit for blocks of consecutive objects; then, the accumulators are called in the sequence of their registration for each block.
 ///
 /// Accumulators, which are registered with push_back_acquire, are deleted in ~AccumulatorTupleCL.
 template <class VisitedT>
@@ -90,6 +130,11 @@ class AccumulatorTupleCL
     /// \brief Deletes the clones defined from clone_accus; obviously, accus_ is not deleted
     void delete_clones(std::vector<ContainerT>& clones);
 
+    /// \brief The common block size of the accumulators; 1, if one of them does not support blocks or the batched accumulation is disabled.
+    size_t block_size () const;
+    /// \brief Visits the n objects *seq[0], ..., *seq[n-1] in blocks of size bs with the accumulators in accus.
+    static void visit_blocks (ContainerT& accus, const VisitedT* const* seq, size_t n, size_t bs);
+
   public:
     /// \brief Deletes the objects in deletion_cache_.
     ~AccumulatorTupleCL ();
@@ -104,6 +149,8 @@ class AccumulatorTupleCL
     void operator() (ExternalIteratorCL begin, ExternalIteratorCL end);
     /// \brief Calls the accumulators for each object by using a ColorClassesCL.
     void operator() (const ColorClassesCL& colors);
+    /// \brief Calls the accumulators for each object by using a TriangPartitionCL.
+    void operator() (const TriangPartitionCL& part);
 };
 
 template <class VisitedT>
@@ -136,6 +183,25 @@ void AccumulatorTupleCL<VisitedT>::delete_clones(std::vector<ContainerT>& clones
             delete clones[i][j];
 }
 
+template<class VisitedT>
+size_t AccumulatorTupleCL<VisitedT>::block_size () const
+{
+    if (!GetBlockAccumulation() || accus_.empty())
+        return 1;
+    size_t bs= accus_[0]->block_size();
+    for (size_t i= 1; i < accus_.size(); ++i)
+        bs= std::min( bs, accus_[i]->block_size());
+    return bs;
+}
+
+template<class VisitedT>
+void AccumulatorTupleCL<VisitedT>::visit_blocks (ContainerT& accus, const VisitedT* const* seq, size_t n, size_t bs)
+{
+    for (size_t j= 0; j < n; j+= bs)
+        for (typename ContainerT::iterator it= accus.begin(), end= accus.end(); it != end; ++it)
+            (*it)->visit_block( seq + j, std::min( bs, n - j));
+}
+
 template<class VisitedT>
 AccumulatorTupleCL<VisitedT>::~AccumulatorTupleCL ()
 {
@@ -148,8 +214,23 @@ template <class ExternalIteratorCL>
 void AccumulatorTupleCL<VisitedT>::operator() (ExternalIteratorCL begin, ExternalIteratorCL end)
 {
     begin_iteration();
-    for ( ; begin != end; ++begin)
-        std::for_each( accus_.begin(), accus_.end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *begin));
+    const size_t bs= block_size();
+    if (bs > 1) {
+        std::vector<const VisitedT*> block;
+        block.reserve( bs);
+        for ( ; begin != end; ++begin) {
+            block.push_back( &*begin);
+            if (block.size() == bs) {
+                visit_blocks( accus_, &block[0], bs, bs);
+                block.clear();
+            }
+        }
+        if (!block.empty())
+            visit_blocks( accus_, &block[0], block.size(), bs);
+    }
+    else
+        for ( ; begin != end; ++begin)
+            std::for_each( accus_.begin(), accus_.end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *begin));
     finalize_iteration();
 }
 
@@ -161,6 +242,7 @@ void AccumulatorTupleCL<VisitedT>::operator() (const ColorClassesCL& colors)
 
     std::vector<ContainerT> clones( omp_get_max_threads());
     clone_accus( clones);
+    const size_t bs= block_size();
     for (ColorClassesCL::const_iterator cit= colors.begin(); cit != colors.end() ;++cit) {
 #       pragma omp parallel
         {
@@ -171,9 +253,62 @@ void AccumulatorTupleCL<VisitedT>::operator() (const ColorClassesCL& colors)
 #else
             int j;
 #endif
-#           pragma omp for schedule(dynamic)
-            for (j= 0; j < cc.size(); ++j)
-                std::for_each( clones[t_id].begin(), clones[t_id].end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *cc[j]));
+            if (bs > 1) {
+#               pragma omp for schedule(dynamic)
+                for (j= 0; j < cc.size(); j+= bs)
+                    visit_blocks( clones[t_id], &cc[j], std::min( bs, cc.size() - j), bs);
+            }
+            else {
+#               pragma omp for schedule(dynamic)
+                for (j= 0; j < cc.size(); ++j)
+                    std::for_each( clones[t_id].begin(), clones[t_id].end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *cc[j]));
+            }
+        }
+    }
+    delete_clones(clones);
+
+    finalize_iteration();
+}
+
+template<class VisitedT>
+void AccumulatorTupleCL<VisitedT>::operator() (const TriangPartitionCL& part)
+{
+    begin_iteration();
+
+    std::vector<ContainerT> clones( omp_get_max_threads());
+    clone_accus( clones);
+    const size_t bs= block_size();
+#   pragma omp parallel
+    {
+        const int t_id= omp_get_thread_num();
+#ifndef DROPS_WIN
+        size_t p, j;
+#else
+        int p, j;
+#endif
+        // Interior tetras of different parts do not share unknowns.
+#       pragma omp for schedule(dynamic, 1)
+        for (p= 0; p < part.num_parts(); ++p) {
+            const TriangPartitionCL::TetraSeqT& seq= part.interior( p);
+            if (bs > 1)
+                visit_blocks( clones[t_id], seq.empty() ? 0 : &seq[0], seq.size(), bs);
+            else
+                for (j= 0; j < seq.size(); ++j)
+                    std::for_each( clones[t_id].begin(), clones[t_id].end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *seq[j]));
+        }
+        // The implicit barriers separate the parts and the color classes of the separator.
+        for (ColorClassesCL::const_iterator cit= part.separator().begin(); cit != part.separator().end(); ++cit) {
+            const ColorClassesCL::ColorClassT& cc= *cit;
+            if (bs > 1) {
+#               pragma omp for schedule(dynamic)
+                for (j= 0; j < cc.size(); j+= bs)
+                    visit_blocks( clones[t_id], &cc[j], std::min( bs, cc.size() - j), bs);
+            }
+            else {
+#               pragma omp for schedule(dynamic)
+                for (j= 0; j < cc.size(); ++j)
+                    std::for_each( clones[t_id].begin(), clones[t_id].end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *cc[j]));
+            }
         }
     }
     delete_clones(clones);
@@ -208,7 +343,9 @@ struct do_accumulateCL<AccumulatorTupleCL<VisitedT> >
     static void accumulate (AccumulatorTupleCL<VisitedT>& accu, const MultiGridCL& mg, int lvl, __UNUSED__ match_fun match, __UNUSED__ const BndCondCL& Bnd)
     {
 #ifdef _OPENMP
-        if (omp_get_max_threads() > 1)
+        if (omp_get_max_threads() > 1 && GetTetraAccumulation() == PartitionedAccumulation)
+            accu( mg.GetTriangPartition( lvl, match, Bnd, omp_get_max_threads()));
+        else if (omp_get_max_threads() > 1)
             accu( mg.GetColorClasses( lvl, match, Bnd));
         else
 #endif
@@ -0,0 +1,294 @@
+/// \file amg.cpp
+/// \brief smoothed aggregation algebraic multigrid preconditioner
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/amg.h"
+#include "misc/scopetimer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace DROPS
+{
+
+const size_t AMGPcCL::NoAgg;
+
+/// \brief Couplings with |a_ij| > theta*sqrt(|a_ii*a_jj|) are strong; theta2 is theta^2, d contains |a_ii|.
+inline bool StrongCoupling (const MatrixCL& A, const VectorCL& d, double theta2, size_t i, size_t nz)
+{
+    return A.col_ind( nz) != i && A.val( nz)*A.val( nz) > theta2*d[i]*d[A.col_ind( nz)];
+}
+
+size_t AMGPcCL::Aggregate (const MatrixCL& A, double theta, std::vector<size_t>& agg)
+{
+    const size_t n= A.num_rows();
+    const VectorCL d( std::abs( A.GetDiag()));
+    const double theta2= theta*theta;
+
+    agg.assign( n, NoAgg);
+    size_t nc= 0;
+    // Phase 1: A dof, which is strongly coupled only to free dofs, forms a new aggregate with these neighbors.
+    for (size_t i= 0; i < n; ++i) {
+        if (agg[i] != NoAgg)
+            continue;
+        bool coupled= false, free= true;
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1) && free; ++nz)
+            if (StrongCoupling( A, d, theta2, i, nz)) {
+                coupled= true;
+                free= agg[A.col_ind( nz)] == NoAgg;
+            }
+        if (!coupled || !free)
+            continue;
+        agg[i]= nc;
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+            if (StrongCoupling( A, d, theta2, i, nz))
+                agg[A.col_ind( nz)]= nc;
+        ++nc;
+    }
+    // Phase 2: The remaining dofs join the aggregate of phase 1 with the strongest coupling.
+    const std::vector<size_t> agg1( agg);
+    for (size_t i= 0; i < n; ++i) {
+        if (agg[i] != NoAgg)
+            continue;
+        double max= 0.;
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+            if (StrongCoupling( A, d, theta2, i, nz) && agg1[A.col_ind( nz)] != NoAgg
+                && std::abs( A.val( nz))/std::sqrt( d[A.col_ind( nz)]) > max) {
+                max= std::abs( A.val( nz))/std::sqrt( d[A.col_ind( nz)]);
+                agg[i]= agg1[A.col_ind( nz)];
+            }
+    }
+    // Phase 3: Strongly coupled dofs, which are still free, form new aggregates with their free neighbors.
+    for (size_t i= 0; i < n; ++i) {
+        if (agg[i] != NoAgg)
+            continue;
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+            if (StrongCoupling( A, d, theta2, i, nz) && agg[A.col_ind( nz)] == NoAgg) {
+                agg[i]= agg[A.col_ind( nz)]= nc;
+            }
+        if (agg[i] == nc)
+            ++nc;
+    }
+    return nc;
+}
+
+void AMGPcCL::ComputeValues (const MatrixCL& A, LevelCL& lvl)
+{
+    const size_t n= A.num_rows();
+    const VectorCL d( A.GetDiag());
+    // omega= 4/(3 rho(D^{-1}A)), where the spectral radius is estimated by Gerschgorin's theorem.
+    double rho= 0.;
+    for (size_t i= 0; i < n; ++i) {
+        if (d[i] == 0.)
+            throw DROPSErrCL( "AMGPcCL::ComputeValues: zero diagonal entry.\n");
+        double s= 0.;
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+            s+= std::abs( A.val( nz));
+        rho= std::max( rho, s/std::abs( d[i]));
+    }
+    const double omega= 4./(3.*rho);
+
+    // P= T - omega*D^{-1}*A*T; the pattern of A*T contains the pattern of T.
+    mat_mul_values( A, lvl.T, lvl.P);
+    double* p= lvl.P.raw_val();
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for
+    for (i= 0; i < n; ++i) {
+        for (size_t k= lvl.P.row_beg( i); k < lvl.P.row_beg( i + 1); ++k)
+            p[k]*= -omega/d[i];
+        if (lvl.T.row_beg( i) == lvl.T.row_beg( i + 1))
+            continue;
+        const size_t* c= std::lower_bound( lvl.P.GetFirstCol( i), lvl.P.GetFirstCol( i + 1), lvl.T.col_ind( lvl.T.row_beg( i)));
+        p[c - lvl.P.raw_col()]+= lvl.T.val( lvl.T.row_beg( i));
+    }
+    transpose( lvl.P, lvl.R);
+    mat_mul_values( A, lvl.P, lvl.AP);
+    mat_mul_values( lvl.R, lvl.AP, lvl.Ac);
+}
+
+bool AMGPcCL::SamePattern (const MatrixCL& A) const
+{
+    return A.num_rows() + 1 == rowbeg_.size() && A.num_nonzeros() == colind_.size()
+        && std::equal( rowbeg_.begin(), rowbeg_.end(), A.raw_row())
+        && std::equal( colind_.begin(), colind_.end(), A.raw_col());
+}
+
+void AMGPcCL::SetMatrix (const MatrixCL& A)
+{
+    if (&A == A_ && A.Version() == mat_version_)
+        return;
+    const bool update= reuse_ && A_ != 0 && SamePattern( A);
+    A_= &A;
+    mat_version_= A.Version();
+    if (update)
+        Update();
+    else
+        Setup();
+}
+
+void AMGPcCL::Setup ()
+{
+    ScopeTimerCL scope( "AMGPcCL::Setup");
+    ++num_setup_;
+    rowbeg_.assign( A_->raw_row(), A_->raw_row() + A_->num_rows() + 1);
+    colind_.assign( A_->raw_col(), A_->raw_col() + A_->num_nonzeros());
+    levels_.clear();
+    levels_.reserve( max_levels_);
+    std::vector<size_t> agg;
+    while (levels_.size() + 1 < max_levels_) {
+        const MatrixCL& A= levels_.empty() ? *A_ : levels_.back().Ac;
+        if (A.num_rows() <= coarse_size_)
+            break;
+        const size_t nc= Aggregate( A, theta_*std::pow( 0.5, static_cast<double>( levels_.size())), agg);
+        if (nc == 0 || nc == A.num_rows())
+            break;
+        levels_.push_back( LevelCL());
+        LevelCL& lvl= levels_.back();
+        const size_t n= A.num_rows();
+        lvl.T.resize( n, nc, n - std::count( agg.begin(), agg.end(), NoAgg));
+        size_t* rb= lvl.T.raw_row();
+        rb[0]= 0;
+        for (size_t i= 0; i < n; ++i) {
+            rb[i + 1]= rb[i];
+            if (agg[i] != NoAgg) {
+                lvl.T.raw_col()[rb[i]]= agg[i];
+                lvl.T.raw_val()[rb[i]]= 1.;
+                ++rb[i + 1];
+            }
+        }
+        mat_mul_pattern( A, lvl.T, lvl.P);
+        transpose( lvl.P, lvl.R);
+        mat_mul_pattern( A, lvl.P, lvl.AP);
+        mat_mul_pattern( lvl.R, lvl.AP, lvl.Ac);
+        ComputeValues( A, lvl);
+        lvl.xc.resize( nc);
+        lvl.bc.resize( nc);
+    }
+    Factorize();
+    if (output_ != 0)
+        *output_ << "AMGPcCL::Setup: levels: " << GetNumLevels() << "\tcoarsest size: " << piv_.size()
+                 << "\toperator complexity: " << GetOperatorComplexity() << '\n';
+}
+
+void AMGPcCL::Update ()
+{
+    ScopeTimerCL scope( "AMGPcCL::Update");
+    ++num_update_;
+    for (size_t l= 0; l < levels_.size(); ++l)
+        ComputeValues( l == 0 ? *A_ : levels_[l - 1].Ac, levels_[l]);
+    Factorize();
+}
+
+void AMGPcCL::Factorize ()
+{
+    const MatrixCL& A= levels_.empty() ? *A_ : levels_.back().Ac;
+    const size_t n= A.num_rows();
+    lu_.assign( n*n, 0.);
+    piv_.resize( n);
+    zeropiv_.assign( n, 0);
+    double scale= 0.;
+    for (size_t i= 0; i < n; ++i)
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz) {
+            lu_[i*n + A.col_ind( nz)]= A.val( nz);
+            scale= std::max( scale, std::abs( A.val( nz)));
+        }
+    // LU-decomposition with partial pivoting; the unknowns with vanishing pivot are set to 0.
+    for (size_t k= 0; k < n; ++k) {
+        size_t p= k;
+        for (size_t i= k + 1; i < n; ++i)
+            if (std::abs( lu_[i*n + k]) > std::abs( lu_[p*n + k]))
+                p= i;
+        piv_[k]= p;
+        if (p != k)
+            std::swap_ranges( lu_.begin() + k*n, lu_.begin() + (k + 1)*n, lu_.begin() + p*n);
+        if (std::abs( lu_[k*n + k]) <= 1e-12*scale) {
+            zeropiv_[k]= 1;
+            lu_[k*n + k]= 1.;
+            for (size_t i= k + 1; i < n; ++i)
+                lu_[i*n + k]= lu_[k*n + i]= 0.;
+            continue;
+        }
+        for (size_t i= k + 1; i < n; ++i) {
+            const double l= (lu_[i*n + k]/= lu_[k*n + k]);
+            if (l != 0.)
+                for (size_t j= k + 1; j < n; ++j)
+                    lu_[i*n + j]-= l*lu_[k*n + j];
+        }
+    }
+}
+
+void AMGPcCL::SolveCoarse (VectorCL& x, const VectorCL& b) const
+{
+    const size_t n= piv_.size();
+    x= b;
+    for (size_t k= 0; k < n; ++k)
+        std::swap( x[k], x[piv_[k]]);
+    for (size_t k= 0; k < n; ++k) {
+        if (zeropiv_[k]) {
+            x[k]= 0.;
+            continue;
+        }
+        for (size_t j= 0; j < k; ++j)
+            x[k]-= lu_[k*n + j]*x[j];
+    }
+    for (size_t k= n; k > 0; ) {
+        --k;
+        for (size_t j= k + 1; j < n; ++j)
+            x[k]-= lu_[k*n + j]*x[j];
+        x[k]/= lu_[k*n + k];
+    }
+}
+
+void AMGPcCL::Cycle (size_t l, VectorCL& x, const VectorCL& b) const
+{
+    if (l == levels_.size()) {
+        SolveCoarse( x, b);
+        return;
+    }
+    const MatrixCL& A= l == 0 ? *A_ : levels_[l - 1].Ac;
+    const LevelCL& lvl= levels_[l];
+    x= 0.;
+    for (Uint i= 0; i < sm_; ++i)
+        SolveGSstep<false>( PreDummyCL<PB_SGS>(), A, x, b, 1.);
+    lvl.bc= lvl.R*VectorCL( b - A*x);
+    Cycle( l + 1, lvl.xc, lvl.bc);
+    x+= lvl.P*lvl.xc;
+    for (Uint i= 0; i < sm_; ++i)
+        SolveGSstep<false>( PreDummyCL<PB_SGS>(), A, x, b, 1.);
+}
+
+double AMGPcCL::GetOperatorComplexity () const
+{
+    if (A_ == 0 || A_->num_nonzeros() == 0)
+        return 1.;
+    double nnz= A_->num_nonzeros();
+    for (size_t l= 0; l < levels_.size(); ++l)
+        nnz+= levels_[l].Ac.num_nonzeros();
+    return nnz/A_->num_nonzeros();
+}
+
+} // end of namespace DROPS
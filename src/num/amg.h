@@ -0,0 +1,135 @@
+/// \file amg.h
+/// \brief smoothed aggregation algebraic multigrid preconditioner
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_AMG_H
+#define DROPS_AMG_H
+
+#include "num/spmat.h"
+#include "num/precond.h"
+#include <vector>
+
+namespace DROPS
+{
+
+// ***************************************************************************
+/// \brief Smoothed aggregation algebraic multigrid; Apply performs one V-cycle with start vector 0.
+///
+/// The hierarchy is built from the matrix alone, i.e. neither a hierarchy of triangulations
+/// nor ProlongationCL is required. On each level, strongly coupled dofs are grouped into
+/// aggregates; the tentative prolongation T is the piecewise constant interpolation from the
+/// aggregates, which is smoothed by one damped Jacobi step, P= (I - omega D^{-1}A) T. The coarse
+/// matrix is the Galerkin product P^T A P. Symmetric Gauss-Seidel is used as pre- and post-smoother
+/// and the coarsest matrix is factorized by dense LU-decomposition. Singular matrices, whose kernel
+/// is spanned by the constants (e.g. the pure Neumann Laplacian), can be used with consistent right
+/// hand sides.
+///
+/// The hierarchy is set up by SetDiag, if the matrix has been modified. If the sparsity pattern of
+/// the matrix is the same as in the last setup, e.g. in the next time step, the aggregates and the
+/// sparsity patterns of all levels are kept and only the values are recomputed.
+// ***************************************************************************
+class AMGPcCL : public PreBaseCL
+{
+  private:
+    /// \brief Transfer from the next coarser level and the coarse matrix
+    struct LevelCL
+    {
+        MatrixCL T,          ///< tentative prolongation
+                 P,          ///< smoothed prolongation
+                 R,          ///< restriction, R= P^T
+                 AP,         ///< A*P
+                 Ac;         ///< coarse matrix R*A*P
+        mutable VectorCL xc, ///< correction on the coarse level
+                         bc; ///< restricted residual
+    };
+
+    double theta_;        ///< threshold for strong couplings on the finest level; it is halved on each coarser level
+    Uint   sm_;           ///< number of symmetric Gauss-Seidel steps for pre- and post-smoothing
+    size_t coarse_size_;  ///< levels with at most coarse_size_ dofs are solved directly
+    Uint   max_levels_;   ///< maximal number of levels
+    bool   reuse_;        ///< keep the aggregates, if only the values of the matrix change
+
+    const MatrixCL*      A_;       ///< matrix on the finest level
+    std::vector<size_t>  rowbeg_,  ///< sparsity pattern of the finest matrix in the last setup
+                         colind_;
+    std::vector<LevelCL> levels_;  ///< levels_[l] contains the matrix of level l+1
+    std::vector<double>  lu_;      ///< dense LU-decomposition of the coarsest matrix
+    std::vector<size_t>  piv_;     ///< row permutation of the LU-decomposition
+    std::vector<char>    zeropiv_; ///< pivots, which vanish for singular matrices; the corresponding unknowns are set to 0
+    Uint                 num_setup_,
+                         num_update_;
+
+    /// \brief Group the dofs of A into aggregates; returns the number of aggregates. agg[i] is NoAgg for isolated dofs.
+    static size_t Aggregate (const MatrixCL& A, double theta, std::vector<size_t>& agg);
+    /// \brief Compute the values of the prolongation and the coarse matrix of a level from the fine matrix A
+    static void ComputeValues (const MatrixCL& A, LevelCL& lvl);
+
+    bool SamePattern (const MatrixCL& A) const;
+    void Setup ();
+    void Update ();
+    void Factorize ();
+    void SolveCoarse (VectorCL& x, const VectorCL& b) const;
+    void Cycle (size_t l, VectorCL& x, const VectorCL& b) const;
+
+  public:
+    static const size_t NoAgg= static_cast<size_t>( -1);
+
+    AMGPcCL (double theta= 0.08, Uint sm= 1, size_t coarse_size= 300, Uint max_levels= 10, std::ostream* output= 0)
+        : PreBaseCL( output), theta_( theta), sm_( sm), coarse_size_( coarse_size), max_levels_( max_levels),
+          reuse_( true), A_( 0), num_setup_( 0), num_update_( 0) {}
+
+    /// \brief Check if return preconditioned vectors are accumulated after calling Apply
+    bool RetAcc()   const { return false; }
+    /// \brief The hierarchy is set up in SetDiag
+    bool NeedDiag() const { return true; }
+
+    /// \brief Set up the hierarchy for A, if A has been modified since the last call
+    void SetMatrix (const MatrixCL& A);
+    template <typename Mat, typename ExT>
+    void SetDiag (const Mat& A, const ExT&) { SetMatrix( A); }
+    template <typename ExT>
+    void SetDiag (const MLMatrixCL& A, const ExT&) { SetMatrix( A.GetFinest()); }
+
+    /// \brief If reuse is false, each modification of the matrix leads to a new aggregation.
+    void SetReuse (bool reuse) { reuse_= reuse; }
+
+    /// \brief Apply preconditioner: one V-cycle with start vector 0
+    template <typename Mat, typename Vec, typename ExT>
+    void Apply (const Mat&, Vec& x, const Vec& b, const ExT&) const {
+        if (A_ == 0)
+            throw DROPSErrCL( "AMGPcCL::Apply: The hierarchy has not been set up.\n");
+        Cycle( 0, x, b);
+    }
+
+    Uint   GetNumLevels  () const { return levels_.size() + 1; }
+    /// \brief Number of setups with aggregation
+    Uint   GetNumSetups  () const { return num_setup_; }
+    /// \brief Number of setups, which reused the aggregates
+    Uint   GetNumUpdates () const { return num_update_; }
+    /// \brief Sum of the non-zeros on all levels divided by the non-zeros of the finest matrix
+    double GetOperatorComplexity () const;
+};
+
+} // end of namespace DROPS
+
+#endif
@@ -0,0 +1,426 @@
+/// \file bcsrmat.h
+/// \brief sparse matrix in block compressed row format with dense BxB-blocks
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_BCSRMAT_H
+#define DROPS_BCSRMAT_H
+
+#include "num/spmat.h"
+#include "num/precond.h"
+
+namespace DROPS
+{
+
+//*****************************************************************************
+//
+//  B C S R M a t B a s e C L :  block compressed row storage
+//
+//*****************************************************************************
+
+///\brief Sparse matrix, which consists of dense BxB-blocks (block compressed row storage).
+///
+/// The velocity matrices of the P2-discretizations couple all three components of two DoF with the same
+/// sparsity pattern. Storing one column index per 3x3-block instead of one per entry reduces the memory
+/// traffic for the indices in the matrix-vector products by a factor of 9 and the overall traffic by about 40%.
+///
+/// The matrix is set up from a SparseMatBaseCL by assign(); rows and columns are grouped in consecutive
+/// tuples of B. Blocks, which are only partially stored in the scalar matrix (e.g. the SDiagMatrixCL<3>-blocks
+/// of the mass matrix), are filled with zeros. The blocks are stored row-wise, the block columns in each block row
+/// are ascending.
+template <typename T, Uint B>
+class BCSRMatBaseCL
+{
+  public:
+    typedef T value_type;
+    static const Uint block_size= B; ///< Number of rows and columns of the blocks
+
+  private:
+    size_t block_rows_; ///< number of block rows
+    size_t block_cols_; ///< number of block columns
+    size_t num_blocks_; ///< number of stored blocks
+
+    size_t version_;    ///< All modifications increment this. Starts with 1.
+
+    std::valarray<size_t> rowbeg_; ///< (block_rows_+1 entries) index of the first block of each block row
+    std::valarray<size_t> colind_; ///< (num_blocks_ entries) block column of each block
+    std::valarray<T>      val_;    ///< (B*B*num_blocks_ entries) the entries of the blocks
+
+  public:
+    BCSRMatBaseCL ()
+        : block_rows_( 0), block_cols_( 0), num_blocks_( 0), version_( 1), rowbeg_( size_t(), 1) {}
+    explicit BCSRMatBaseCL (const SparseMatBaseCL<T>& A)
+        : block_rows_( 0), block_cols_( 0), num_blocks_( 0), version_( 1), rowbeg_( size_t(), 1) { assign( A); }
+
+    ///\brief Set up the block matrix from the scalar matrix A. The dimensions of A must be multiples of B.
+    void assign (const SparseMatBaseCL<T>& A);
+    ///\brief Copy the values of A into the blocks; A must have the sparsity pattern, from which the block pattern was computed.
+    void assign_values (const SparseMatBaseCL<T>& A);
+
+    size_t num_rows       () const { return B*block_rows_; }
+    size_t num_cols       () const { return B*block_cols_; }
+    size_t num_block_rows () const { return block_rows_; }
+    size_t num_block_cols () const { return block_cols_; }
+    size_t num_blocks     () const { return num_blocks_; }
+    size_t num_nonzeros   () const { return B*B*num_blocks_; }
+
+    const T*      raw_val() const { return Addr( val_); }
+    T*            raw_val()       { return Addr( val_); }
+    const size_t* raw_row() const { return Addr( rowbeg_); }
+    const size_t* raw_col() const { return Addr( colind_); }
+
+    size_t row_beg (size_t I) const { return rowbeg_[I]; }
+    size_t col_ind (size_t k) const { return colind_[k]; }
+    /// \brief Entries of block k, stored row-wise
+    const T* block (size_t k) const { return Addr( val_) + k*B*B; }
+
+    void IncrementVersion() { ++version_; }      ///< Increment modification version number
+    size_t Version() const  { return version_; } ///< Get modification version number
+
+    ///\brief Entry (i,j) of the matrix; zero, if it is not stored.
+    T operator() (size_t i, size_t j) const;
+
+    VectorBaseCL<T> GetDiag() const;
+
+    void clear () {
+        IncrementVersion();
+        block_rows_= block_cols_= num_blocks_= 0;
+        rowbeg_.resize( 1, 0);
+        colind_.resize( 0);
+        val_.resize( 0);
+    }
+};
+
+template <typename T, Uint B>
+void BCSRMatBaseCL<T, B>::assign (const SparseMatBaseCL<T>& A)
+{
+    if (A.num_rows()%B != 0 || A.num_cols()%B != 0)
+        throw DROPSErrCL( "BCSRMatBaseCL::assign: The dimensions of the matrix are not multiples of the block size.\n");
+
+    IncrementVersion();
+    block_rows_= A.num_rows()/B;
+    block_cols_= A.num_cols()/B;
+    rowbeg_.resize( block_rows_ + 1);
+    rowbeg_[0]= 0;
+
+    // Compute the block columns of each block row as union of the block columns of its B rows.
+    std::vector<std::vector<size_t> > cols( block_rows_);
+    for (size_t I= 0; I < block_rows_; ++I) {
+        std::vector<size_t>& c= cols[I];
+        c.reserve( A.row_beg( B*(I + 1)) - A.row_beg( B*I));
+        for (size_t nz= A.row_beg( B*I); nz < A.row_beg( B*(I + 1)); ++nz)
+            c.push_back( A.col_ind( nz)/B);
+        std::sort( c.begin(), c.end());
+        c.erase( std::unique( c.begin(), c.end()), c.end());
+        rowbeg_[I + 1]= rowbeg_[I] + c.size();
+    }
+    num_blocks_= rowbeg_[block_rows_];
+    colind_.resize( num_blocks_);
+    for (size_t I= 0; I < block_rows_; ++I)
+        std::copy( cols[I].begin(), cols[I].end(), Addr( colind_) + rowbeg_[I]);
+
+    val_.resize( B*B*num_blocks_);
+    assign_values( A);
+}
+
+template <typename T, Uint B>
+void BCSRMatBaseCL<T, B>::assign_values (const SparseMatBaseCL<T>& A)
+{
+    Assert( A.num_rows() == num_rows() && A.num_cols() == num_cols(),
+        DROPSErrCL( "BCSRMatBaseCL::assign_values: incompatible dimensions.\n"), DebugNumericC);
+
+    IncrementVersion();
+    val_= T();
+    const size_t* const col= Addr( colind_);
+    for (size_t i= 0; i < A.num_rows(); ++i) {
+        const size_t I= i/B, r= i%B;
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz) {
+            const size_t J= A.col_ind( nz)/B;
+            const size_t k= std::lower_bound( col + rowbeg_[I], col + rowbeg_[I + 1], J) - col;
+            val_[(k*B + r)*B + A.col_ind( nz)%B]= A.val( nz);
+        }
+    }
+}
+
+template <typename T, Uint B>
+T BCSRMatBaseCL<T, B>::operator() (size_t i, size_t j) const
+{
+    Assert( i < num_rows() && j < num_cols(), "BCSRMatBaseCL (): index out of bounds", DebugNumericC);
+    const size_t* const col= Addr( colind_);
+    const size_t* const end= col + rowbeg_[i/B + 1];
+    const size_t* pos= std::lower_bound( col + rowbeg_[i/B], end, j/B);
+    return (pos != end && *pos == j/B) ? val_[((pos - col)*B + i%B)*B + j%B] : T();
+}
+
+template <typename T, Uint B>
+VectorBaseCL<T> BCSRMatBaseCL<T, B>::GetDiag () const
+{
+    Assert( num_rows() == num_cols(), "BCSRMatBaseCL::GetDiag: no square Matrix", DebugNumericC);
+    VectorBaseCL<T> diag( num_rows());
+    const size_t* const col= Addr( colind_);
+    for (size_t I= 0; I < block_rows_; ++I) {
+        const size_t* pos= std::lower_bound( col + rowbeg_[I], col + rowbeg_[I + 1], I);
+        if (pos == col + rowbeg_[I + 1] || *pos != I)
+            continue;
+        const T* blk= block( pos - col);
+        for (Uint r= 0; r < B; ++r)
+            diag[B*I + r]= blk[r*B + r];
+    }
+    return diag;
+}
+
+
+//*****************************************************************************
+//
+//  Matrix-vector products
+//
+//*****************************************************************************
+
+/// \brief y= A*x for a matrix in block compressed row storage with BxB-blocks.
+/// Assumes, that none of the arrays involved do alias.
+template <Uint B, typename T>
+inline void
+y_Ax_block(T* __restrict y,
+     size_t num_block_rows,
+     const T* __restrict Aval,
+     const size_t* __restrict Arow,
+     const size_t* __restrict Acol,
+     const T* __restrict x)
+{
+#ifndef DROPS_WIN
+    size_t I;
+#else
+    int I;
+#endif
+
+#   pragma omp parallel for
+    for (I= 0; I < num_block_rows; ++I) {
+        T sum[B];
+        for (Uint r= 0; r < B; ++r)
+            sum[r]= T();
+        const size_t rowend= Arow[I + 1];
+        for (size_t k= Arow[I]; k < rowend; ++k) {
+            const T* const blk= Aval + k*B*B;
+            const T* const xb= x + B*Acol[k];
+            for (Uint r= 0; r < B; ++r)
+                for (Uint c= 0; c < B; ++c)
+                    sum[r]+= blk[r*B + c]*xb[c];
+        }
+        for (Uint r= 0; r < B; ++r)
+            y[B*I + r]= sum[r];
+    }
+}
+
+/// \brief y+= A^T*x for a matrix in block compressed row storage with BxB-blocks.
+/// Assumes, that none of the arrays involved do alias.
+template <Uint B, typename T>
+inline void
+y_ATx_block(T* __restrict y,
+     size_t num_block_rows,
+     const T* __restrict Aval,
+     const size_t* __restrict Arow,
+     const size_t* __restrict Acol,
+     const T* __restrict x)
+{
+    for (size_t I= 0; I < num_block_rows; ++I) {
+        const T* const xb= x + B*I;
+        for (size_t k= Arow[I]; k < Arow[I + 1]; ++k) {
+            const T* const blk= Aval + k*B*B;
+            T* const yb= y + B*Acol[k];
+            for (Uint r= 0; r < B; ++r)
+                for (Uint c= 0; c < B; ++c)
+                    yb[c]+= blk[r*B + c]*xb[r];
+        }
+    }
+}
+
+template <typename _MatEntry, Uint B, typename _VecEntry>
+VectorBaseCL<_VecEntry> operator * (const BCSRMatBaseCL<_MatEntry, B>& A, const VectorBaseCL<_VecEntry>& x)
+{
+    VectorBaseCL<_VecEntry> ret( A.num_rows());
+    Assert( A.num_cols()==x.size(), "BCSRMatBaseCL * VectorBaseCL: incompatible dimensions", DebugNumericC);
+    y_Ax_block<B>( &ret[0], A.num_block_rows(), A.raw_val(), A.raw_row(), A.raw_col(), Addr( x));
+    return ret;
+}
+
+template <typename _MatEntry, Uint B, typename _VecEntry>
+VectorBaseCL<_VecEntry> transp_mul (const BCSRMatBaseCL<_MatEntry, B>& A, const VectorBaseCL<_VecEntry>& x)
+{
+    VectorBaseCL<_VecEntry> ret( A.num_cols());
+    Assert( A.num_rows()==x.size(), "transp_mul: incompatible dimensions", DebugNumericC);
+    y_ATx_block<B>( &ret[0], A.num_block_rows(), A.raw_val(), A.raw_row(), A.raw_col(), Addr( x));
+    return ret;
+}
+
+
+//*****************************************************************************
+//
+//  Gauss-Seidel type methods
+//
+//*****************************************************************************
+
+/// \brief Row i= B*I + r of A*x without the diagonal entry, which is returned in aii.
+/// In the diagonal block, the current values of x are used; thus, called for ascending i, this is one Gauss-Seidel sweep.
+template <typename T, Uint B, typename Vec>
+inline T
+offdiag_row_sum (const BCSRMatBaseCL<T, B>& A, const Vec& x, size_t I, Uint r, T& aii)
+{
+    T sum= T();
+    for (size_t k= A.row_beg( I); k < A.row_beg( I + 1); ++k) {
+        const T* const blk= A.block( k) + r*B;
+        const size_t J= A.col_ind( k);
+        for (Uint c= 0; c < B; ++c)
+            if (J != I || c != r)
+                sum+= blk[c]*x[B*J + c];
+            else
+                aii= blk[c];
+    }
+    return sum;
+}
+
+/// \brief Row i= B*I + r of A*x restricted to the columns j < i (lower == true) or j > i (lower == false); the diagonal entry is returned in aii.
+template <typename T, Uint B, typename Vec>
+inline T
+triangular_row_sum (const BCSRMatBaseCL<T, B>& A, const Vec& x, size_t I, Uint r, bool lower, T& aii)
+{
+    const size_t i= B*I + r;
+    T sum= T();
+    for (size_t k= A.row_beg( I); k < A.row_beg( I + 1); ++k) {
+        const size_t J= A.col_ind( k);
+        if (lower ? J > I : J < I)
+            continue;
+        const T* const blk= A.block( k) + r*B;
+        for (Uint c= 0; c < B; ++c) {
+            const size_t j= B*J + c;
+            if (j == i)
+                aii= blk[c];
+            else if (lower ? j < i : j > i)
+                sum+= blk[c]*x[j];
+        }
+    }
+    return sum;
+}
+
+// One step of the Jacobi method with start vector x
+template <bool HasOmega, typename Vec, Uint B>
+void
+SolveGSstep(const PreDummyCL<PB_JAC>&, const BCSRMatBaseCL<double, B>& A, Vec& x, const Vec& b, double omega)
+{
+    Vec y( x.size());
+#ifndef DROPS_WIN
+    size_t I;
+#else
+    int I;
+#endif
+
+#   pragma omp parallel for
+    for (I= 0; I < A.num_block_rows(); ++I)
+        for (Uint r= 0; r < B; ++r) {
+            const size_t i= B*I + r;
+            double aii= 0.;
+            const double sum= b[i] - offdiag_row_sum( A, x, I, r, aii);
+            if (HasOmega)
+                y[i]= (1.-omega)*x[i]+omega*sum/aii;
+            else
+                y[i]= sum/aii;
+        }
+    std::swap( x, y);
+}
+
+// One step of the Gauss-Seidel/SOR method with start vector x
+template <bool HasOmega, typename Vec, Uint B>
+void
+SolveGSstep(const PreDummyCL<PB_GS>&, const BCSRMatBaseCL<double, B>& A, Vec& x, const Vec& b, double omega)
+{
+    double aii= 0.;
+    for (size_t I= 0; I < A.num_block_rows(); ++I)
+        for (Uint r= 0; r < B; ++r) {
+            const size_t i= B*I + r;
+            const double sum= b[i] - offdiag_row_sum( A, x, I, r, aii);
+            if (HasOmega)
+                x[i]= (1.-omega)*x[i]+omega*sum/aii;
+            else
+                x[i]= sum/aii;
+        }
+}
+
+// One step of the Symmetric-Gauss-Seidel/SSOR method with start vector x
+template <bool HasOmega, typename Vec, Uint B>
+void
+SolveGSstep(const PreDummyCL<PB_SGS>&, const BCSRMatBaseCL<double, B>& A, Vec& x, const Vec& b, double omega)
+{
+    SolveGSstep<HasOmega, Vec>( PreDummyCL<PB_GS>(), A, x, b, omega);
+    double aii= 0.;
+    for (size_t I= A.num_block_rows(); I > 0; ) {
+        --I;
+        for (Uint r= B; r > 0; ) {
+            --r;
+            const size_t i= B*I + r;
+            const double sum= b[i] - offdiag_row_sum( A, x, I, r, aii);
+            if (HasOmega)
+                x[i]= (1.-omega)*x[i]+omega*sum/aii;
+            else
+                x[i]= sum/aii;
+        }
+    }
+}
+
+// One step of the Symmetric-Gauss-Seidel/SSOR method with start vector 0
+template <bool HasOmega, typename Vec, Uint B>
+void
+SolveGSstep(const PreDummyCL<PB_SGS0>&, const BCSRMatBaseCL<double, B>& A, Vec& x, const Vec& b, double omega)
+{
+    double aii= 0.;
+    for (size_t I= 0; I < A.num_block_rows(); ++I)
+        for (Uint r= 0; r < B; ++r) {
+            const size_t i= B*I + r;
+            const double sum= b[i] - triangular_row_sum( A, x, I, r, true, aii);
+            if (HasOmega)
+                x[i]= omega*sum/aii;
+            else
+                x[i]= sum/aii;
+        }
+
+    for (size_t I= A.num_block_rows(); I > 0; ) {
+        --I;
+        for (Uint r= B; r > 0; ) {
+            --r;
+            const size_t i= B*I + r;
+            const double sum= -triangular_row_sum( A, x, I, r, false, aii);
+            if (HasOmega)
+                x[i]= (2.-omega)*x[i]+omega*sum/aii;
+            else
+                x[i]+= sum/aii;
+        }
+    }
+}
+
+
+//=============================================================================
+//  Typedefs
+//=============================================================================
+
+typedef BCSRMatBaseCL<double, 3> BCSRMatrixCL; ///< 3x3-blocks, e.g., for P2-velocity matrices
+
+} // end of namespace DROPS
+
+#endif
@@ -0,0 +1,179 @@
+/// \file cutcache.h
+/// \brief cache of the subtriangulations and composite quadrature domains of the tetras cut by the interface
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_CUTCACHE_H
+#define DROPS_CUTCACHE_H
+
+#include "num/quadrature.h"
+#include <map>
+
+namespace DROPS
+{
+
+/// \brief Subtriangulation and composite quadrature domains of one cut tetra, see InterfaceCutCacheCL.
+/// The members are computed on first use from the level set values on the vertices of the principal lattice.
+class CutDataCL
+{
+  private:
+    enum { PartitionC= 1, PatchC= 2, Quad2C= 4, Quad5C= 8, Quad5_2DC= 16 };
+
+    const PrincipalLatticeCL* lat_;
+    const TetraCL*            tet_;
+    std::valarray<double>     ls_;    ///< level set values on the vertices of the principal lattice
+    Ubyte                     valid_; ///< bit mask of the members, which have been computed for ls_
+    TetraPartitionCL          partition_;
+    SurfacePatchCL            patch_;
+    QuadDomainCL              q2dom_,
+                              q5dom_;
+    QuadDomain2DCL            q5dom2D_;
+
+    friend class InterfaceCutCacheCL;
+
+    /// sets the level set values; returns false, if they are the values of the last call
+    bool assign (const TetraCL& t, const PrincipalLatticeCL& lat, const std::valarray<double>& ls) {
+        tet_= &t;
+        if (lat_ == &lat && ls_.size() == ls.size()) {
+            size_t i= 0;
+            while (i < ls.size() && ls_[i] == ls[i])
+                ++i;
+            if (i == ls.size())
+                return false;
+        }
+        lat_= &lat;
+        ls_.resize( ls.size());
+        ls_= ls;
+        valid_= 0;
+        return true;
+    }
+
+  public:
+    CutDataCL () : lat_( 0), tet_( 0), valid_( 0) {}
+
+    const std::valarray<double>& ls_values () const { return ls_; }
+
+    /// partition of the principal lattice with SortedVertexPolicyCL and MergeCutPolicyCL
+    const TetraPartitionCL& partition () {
+        if (!(valid_ & PartitionC)) {
+            partition_.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( *lat_, ls_);
+            valid_|= PartitionC;
+        }
+        return partition_;
+    }
+    /// interface patch with MergeCutPolicyCL
+    const SurfacePatchCL& patch () {
+        if (!(valid_ & PatchC)) {
+            patch_.make_patch<MergeCutPolicyCL>( *lat_, ls_);
+            valid_|= PatchC;
+        }
+        return patch_;
+    }
+    /// see make_CompositeQuad2Domain
+    const QuadDomainCL& quad2_domain () {
+        if (!(valid_ & Quad2C)) {
+            make_CompositeQuad2Domain( q2dom_, partition());
+            valid_|= Quad2C;
+        }
+        return q2dom_;
+    }
+    /// see make_CompositeQuad5Domain
+    const QuadDomainCL& quad5_domain () {
+        if (!(valid_ & Quad5C)) {
+            make_CompositeQuad5Domain( q5dom_, partition());
+            valid_|= Quad5C;
+        }
+        return q5dom_;
+    }
+    /// see make_CompositeQuad5Domain2D
+    const QuadDomain2DCL& quad5_domain_2D () {
+        if (!(valid_ & Quad5_2DC)) {
+            make_CompositeQuad5Domain2D( q5dom2D_, patch(), *tet_);
+            valid_|= Quad5_2DC;
+        }
+        return q5dom2D_;
+    }
+};
+
+/// \brief Cache of the subtriangulations of the cut tetras for the routines of one time step.
+///
+/// Volume and area computations and the assembly of the two-phase and XFEM matrices all
+/// subtriangulate the same cut tetras. Get returns the entry of a tetra and a principal lattice,
+/// whose members are computed on first use and then shared by all callers.
+///
+/// The level set values on the lattice vertices are stored with each entry; if they differ from the
+/// values passed to Get, e.g. in the next fixed point iteration, the entry is recomputed. All entries
+/// are dropped by Validate, if the version of the multigrid or the time of the level set function
+/// have changed, i.e. after each refinement and at the beginning of each time step.
+///
+/// Get may be called by several threads, but each tetra must be used by one thread at a time, which
+/// holds for the colored accumulation.
+class InterfaceCutCacheCL
+{
+  private:
+    typedef std::map<std::pair<const TetraCL*, Uint>, CutDataCL> CacheT;
+
+    CacheT cache_;
+    size_t version_; ///< version of the multigrid
+    double t_;       ///< time of the level set function
+    size_t hits_,
+           misses_;
+
+  public:
+    InterfaceCutCacheCL () : version_( NoIdx), t_( 0.), hits_( 0), misses_( 0) {}
+
+    /// drops all entries, if the version of the multigrid or the time of the level set function have changed
+    void Validate (size_t mg_version, double t) {
+        if (mg_version == version_ && t == t_)
+            return;
+        Clear();
+        version_= mg_version;
+        t_= t;
+    }
+    void Clear () { cache_.clear(); }
+
+    /// \brief Returns the cut data of t for the level set values ls on the vertices of lat, or 0, if t is not cut.
+    CutDataCL* Get (const TetraCL& t, const PrincipalLatticeCL& lat, const std::valarray<double>& ls) {
+        if (equal_signs( ls))
+            return 0;
+        CutDataCL* d;
+#pragma omp critical(InterfaceCutCache)
+        {
+            d= &cache_[std::make_pair( &t, lat.num_intervals())];
+            if (d->assign( t, lat, ls))
+                ++misses_;
+            else
+                ++hits_;
+        }
+        return d;
+    }
+
+    size_t size () const { return cache_.size(); }
+    /// number of calls of Get for cut tetras, which found a valid entry
+    size_t GetHits   () const { return hits_; }
+    /// number of calls of Get for cut tetras, which needed a new subtriangulation
+    size_t GetMisses () const { return misses_; }
+};
+
+} // end of namespace DROPS
+
+#endif
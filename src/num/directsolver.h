@@ -57,7 +57,7 @@ public:
 
 /// store and factorize the matrix A
 DirectNonSymmSolverCL(const MatrixCL& A)
-: Apt(0), Ait(0), Axt(0)
+: Symbolic_(0), Numeric_(0), Apt(0), Ait(0), Axt(0)
 {
     // get the default control parameters
     umfpack_dl_defaults(Control_);
@@ -90,6 +90,8 @@ void Update(const MatrixCL& A)
     delete [] Apt;
     delete [] Ait;
     delete [] Axt;
+    umfpack_dl_free_symbolic (&Symbolic_);
+    umfpack_dl_free_numeric (&Numeric_);
 
     Apt = new UF_long [A.num_rows()+1];
     Ait = new UF_long [A.num_nonzeros()];
@@ -133,7 +135,7 @@ void Update(const MatrixCL& A)
 }
 
 /// solve Ax=b, NOTE: DROPS::CRS, UMFPACK: CCS
-void Solve(const MatrixCL, VectorCL &x, const VectorCL& b)
+void Solve(const MatrixCL&, VectorCL &x, const VectorCL& b)
 {
     int status;
     if (b.size() != num_cols_)
@@ -180,6 +182,7 @@ A_(0), L_(0)
 /// delete stored matrix and store/factorize the matrix A
 void Update(const MatrixCL& A)
 {
+    cholmod_l_free_factor (&L_, &c_);
     cholmod_l_free_sparse (&A_, &c_);
     A_= cholmod_l_allocate_sparse (A.num_rows(), A.num_cols(), A.num_nonzeros(), /*sorted*/ true,
            /*packed*/ true, /*upper left block used*/ 1, /*pattern*/ CHOLMOD_REAL, &c_);
@@ -199,7 +202,7 @@ void Update(const MatrixCL& A)
 }
 
 /// solve Ax=b
-void Solve(const MatrixCL, VectorCL &x, const VectorCL& b)
+void Solve(const MatrixCL&, VectorCL &x, const VectorCL& b)
 {
     cholmod_dense  *b_;
     cholmod_dense  *x_;
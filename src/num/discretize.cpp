@@ -25,6 +25,7 @@
 #include "num/discretize.h"
 #include "num/interfacePatch.h"
 #include "num/fe.h"
+#include <cstring>
 
 namespace DROPS
 {
@@ -432,6 +433,37 @@ void P2DiscCL::GetGradientsOnRef( Quad5CL<Point3DCL> GRef[10])
         }
 }
 
+void P2DiscCL::GetGradientsOnRef( SLocalP1CL<Point3DCL> GRef[10])
+{
+    for (int i= 0; i < 10; ++i)
+    {
+        GRef[i][0]= FE_P2CL::DHRef( i, 0,0,0);
+        GRef[i][1]= FE_P2CL::DHRef( i, 1,0,0);
+        GRef[i][2]= FE_P2CL::DHRef( i, 0,1,0);
+        GRef[i][3]= FE_P2CL::DHRef( i, 0,0,1);
+    }
+}
+
+void P2DiscCL::GetGradientsOnRef( SQuad2CL<Point3DCL> GRef[10])
+{
+    for (int i=0; i<10; ++i)
+        for (int j=0; j<Quad2DataCL::NumNodesC; ++j)
+        {
+            const BaryCoordCL& Node= Quad2DataCL::Node[j];
+            GRef[i][j]= FE_P2CL::DHRef( i, Node[1], Node[2], Node[3]);
+        }
+}
+
+void P2DiscCL::GetGradientsOnRef( SQuad5CL<Point3DCL> GRef[10])
+{
+    for (int i=0; i<10; ++i)
+        for (int j=0; j<Quad5DataCL::NumNodesC; ++j)
+        {
+            const BaryCoordCL& Node= Quad5DataCL::Node[j];
+            GRef[i][j]= FE_P2CL::DHRef( i, Node[1], Node[2], Node[3]);
+        }
+}
+
 void P2DiscCL::GetGradientsOnRef( Quad5_2DCL<Point3DCL> GRef[10],
     const BaryCoordCL* const p)
 {
@@ -463,6 +495,83 @@ void P2DiscCL::GetP2Basis( Quad5_2DCL<> p2[10], const BaryCoordCL* const p)
     }
 }
 
+void P2DiscCL::GetGradientProducts( SMatrixCL<3,3> GG[10][10], const SLocalP1CL<Point3DCL> G[10], const double m[4][4])
+{
+    // GG[i][j]= sum_{k,l} m[k][l] G[i][k] G[j][l]^T= sum_l mG[i][l] G[j][l]^T with mG[i][l]= sum_k m[l][k] G[i][k]
+    Point3DCL mG[10][4];
+    for (int i= 0; i < 10; ++i)
+        for (int l= 0; l < 4; ++l)
+            for (int r= 0; r < 3; ++r)
+                mG[i][l][r]= m[l][0]*G[i][0][r] + m[l][1]*G[i][1][r] + m[l][2]*G[i][2][r] + m[l][3]*G[i][3][r];
+    for (int i= 0; i < 10; ++i)
+        for (int j= 0; j <= i; ++j) {
+            SMatrixCL<3,3>& gg= GG[i][j];
+            for (int r= 0; r < 3; ++r)
+                for (int c= 0; c < 3; ++c)
+                    gg( r, c)= mG[i][0][r]*G[j][0][c] + mG[i][1][r]*G[j][1][c] + mG[i][2][r]*G[j][2][c] + mG[i][3][r]*G[j][3][c];
+        }
+}
+
+/// \brief Coefficients of the P2 stiffness matrix with respect to the products of the P1-gradients.
+///
+/// grad phi_i= sum_a p_ia grad lambda_a with linear p_ia; thus, int grad phi_i . grad phi_j dx= absdet*sum_{a<=b} K[ij][ab] grad lambda_a . grad lambda_b,
+/// where ij enumerates the pairs j <= i and ab the pairs a <= b; K[ij][ab] is the integral of p_ia p_jb + p_ib p_ja (a < b) or p_ia p_ja (a == b) on the reference tetra.
+class P2StiffnessOnRefCL
+{
+  public:
+    double K[55][10];
+
+    P2StiffnessOnRefCL ()
+    {
+        // p[i][a][k]: value of p_ia in vertex k
+        double p[10][4][4];
+        std::memset( p, 0, sizeof( p));
+        for (int i= 0; i < 4; ++i)
+            for (int k= 0; k < 4; ++k)
+                p[i][i][k]= k == i ? 3. : -1.;
+        for (int e= 0; e < 6; ++e) {
+            const int v0= VertOfEdge( e, 0), v1= VertOfEdge( e, 1);
+            p[e+4][v0][v1]= 4.;
+            p[e+4][v1][v0]= 4.;
+        }
+        // R[i][j][a][b]= int p_ia p_jb dx on the reference tetra
+        double R[10][10][4][4];
+        for (int i= 0; i < 10; ++i)
+            for (int j= 0; j < 10; ++j)
+                for (int a= 0; a < 4; ++a)
+                    for (int b= 0; b < 4; ++b) {
+                        R[i][j][a][b]= 0.;
+                        for (int k= 0; k < 4; ++k)
+                            for (int l= 0; l < 4; ++l)
+                                R[i][j][a][b]+= p[i][a][k]*p[j][b][l]*P1DiscCL::GetMass( k, l);
+                    }
+        for (int i= 0, ij= 0; i < 10; ++i)
+            for (int j= 0; j <= i; ++j, ++ij)
+                for (int a= 0, ab= 0; a < 4; ++a)
+                    for (int b= a; b < 4; ++b, ++ab)
+                        K[ij][ab]= a == b ? R[i][j][a][a] : R[i][j][a][b] + R[i][j][b][a];
+    }
+};
+
+static const P2StiffnessOnRefCL P2StiffnessOnRef;
+
+void P2DiscCL::GetStiffness( double A[10][10][TetraBlockSizeC], const double H[4][3][TetraBlockSizeC], const double absdet[TetraBlockSizeC])
+{
+    // D[ab][l]= H_a . H_b for a <= b
+    double D[10][TetraBlockSizeC];
+    for (int a= 0, ab= 0; a < 4; ++a)
+        for (int b= a; b < 4; ++b, ++ab)
+            for (Uint l= 0; l < TetraBlockSizeC; ++l)
+                D[ab][l]= H[a][0][l]*H[b][0][l] + H[a][1][l]*H[b][1][l] + H[a][2][l]*H[b][2][l];
+    for (int i= 0, ij= 0; i < 10; ++i)
+        for (int j= 0; j <= i; ++j, ++ij) {
+            const double* const K= P2StiffnessOnRef.K[ij];
+            for (Uint l= 0; l < TetraBlockSizeC; ++l)
+                A[i][j][l]= absdet[l]*(K[0]*D[0][l] + K[1]*D[1][l] + K[2]*D[2][l] + K[3]*D[3][l] + K[4]*D[4][l]
+                                     + K[5]*D[5][l] + K[6]*D[6][l] + K[7]*D[7][l] + K[8]*D[8][l] + K[9]*D[9][l]);
+        }
+}
+
 void P1DiscCL::GetP1Basis( Quad5_2DCL<> p1[4], const BaryCoordCL* const p)
 {
     BaryCoordCL NodeInTetra[Quad5_2DDataCL::NumNodesC];
@@ -390,6 +390,29 @@ class OuterProductExpressionCL
     value_type operator[] (size_t i) const { return outer_product( a_[i], b_[i]); }
 };
 
+/// \brief Represent the pointwise product of a scalar grid function a and a grid function b without computing it immediately.
+/// Like OuterProductExpressionCL, this avoids the temporary valarray in quad( a*b, ...).
+template <class GridFunAT, class GridFunBT>
+class ProductExpressionCL
+{
+    const GridFunAT& a_;
+    const GridFunBT& b_;
+
+  public:
+    typedef typename ValueHelperCL<GridFunBT>::value_type value_type;
+
+    ProductExpressionCL (const GridFunAT& a, const GridFunBT& b)
+        : a_( a), b_( b) {}
+    value_type operator[] (size_t i) const { return a_[i]*b_[i]; }
+};
+
+template <class GridFunAT, class GridFunBT>
+inline ProductExpressionCL<GridFunAT, GridFunBT>
+make_ProductExpression (const GridFunAT& a, const GridFunBT& b)
+{
+    return ProductExpressionCL<GridFunAT, GridFunBT>( a, b);
+}
+
 inline GridFunctionCL< SMatrixCL<3,3> >
 outer_product(const GridFunctionCL<Point3DCL>& a, const GridFunctionCL<Point3DCL>& b)
 {
@@ -963,6 +986,404 @@ DROPS_DEFINE_VALARRAY_DERIVATIVE(Quad5_2DCL, T, base_type)
 };
 
 
+// ======================================================
+//   Grid functions with a size known at compile time
+// ======================================================
+
+/// \brief Grid function with N values stored in the object itself.
+///
+/// GridFunctionCL and the classes derived from it are std::valarrays; each local object in visit( const TetraCL&) of an
+/// accumulator allocates its values on the heap. SGridFunctionCL and the classes derived from it hold the values in the object,
+/// i.e. on the stack or in the accumulator. The arithmetic consists of loops with a fixed number of iterations, which the
+/// compiler unrolls; for the at most 15 values of the quadrature rules no expression templates are needed.
+template <class T, Uint N>
+class SGridFunctionCL
+{
+  public:
+    typedef T value_type;
+    typedef value_type (*tetra_function)(const TetraCL&, const BaryCoordCL&, double);
+    typedef value_type (*instat_fun_ptr)(const Point3DCL&, double);
+
+    enum { SizeC= N };
+
+  protected:
+    typedef SGridFunctionCL<T, N> self_;
+
+    value_type val_[N];
+
+  public:
+    SGridFunctionCL () { std::fill_n( val_ + 0, N, value_type()); }
+    explicit SGridFunctionCL (const value_type& v) { std::fill_n( val_ + 0, N, v); }
+
+    size_t size () const { return N; }
+    value_type&       operator[] (size_t i)       { return val_[i]; }
+    const value_type& operator[] (size_t i) const { return val_[i]; }
+    value_type*       begin ()       { return val_ + 0; }
+    const value_type* begin () const { return val_ + 0; }
+    value_type*       end   ()       { return val_ + N; }
+    const value_type* end   () const { return val_ + N; }
+
+    value_type sum () const {
+        value_type s= val_[0];
+        for (Uint i= 1; i < N; ++i)
+            s+= val_[i];
+        return s;
+    }
+
+    template<typename FuncT>
+      self_& apply (FuncT fun) {
+          for (Uint i= 0; i < N; ++i)
+              val_[i]= fun( val_[i]);
+          return *this;
+      }
+    template<typename U, typename MemberFuncT>
+      self_& apply (U& obj, MemberFuncT fun) {
+          for (Uint i= 0; i < N; ++i)
+              val_[i]= (obj.*fun)( val_[i]);
+          return *this;
+      }
+
+    self_& operator= (const value_type& v) { std::fill_n( val_ + 0, N, v); return *this; }
+    self_& operator+= (const value_type& v) { for (Uint i= 0; i < N; ++i) val_[i]+= v; return *this; }
+    self_& operator-= (const value_type& v) { for (Uint i= 0; i < N; ++i) val_[i]-= v; return *this; }
+    self_& operator*= (double s) { for (Uint i= 0; i < N; ++i) val_[i]*= s; return *this; }
+    self_& operator/= (double s) { for (Uint i= 0; i < N; ++i) val_[i]/= s; return *this; }
+    self_& operator+= (const self_& a) { for (Uint i= 0; i < N; ++i) val_[i]+= a[i]; return *this; }
+    self_& operator-= (const self_& a) { for (Uint i= 0; i < N; ++i) val_[i]-= a[i]; return *this; }
+    self_& operator*= (const SGridFunctionCL<double, N>& a) { for (Uint i= 0; i < N; ++i) val_[i]*= a[i]; return *this; }
+    self_& operator/= (const SGridFunctionCL<double, N>& a) { for (Uint i= 0; i < N; ++i) val_[i]/= a[i]; return *this; }
+};
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator+ (const SGridFunctionCL<T, N>& a, const SGridFunctionCL<T, N>& b)
+{
+    SGridFunctionCL<T, N> ret( a);
+    return ret+= b;
+}
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator- (const SGridFunctionCL<T, N>& a, const SGridFunctionCL<T, N>& b)
+{
+    SGridFunctionCL<T, N> ret( a);
+    return ret-= b;
+}
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator* (const SGridFunctionCL<T, N>& a, double s)
+{
+    SGridFunctionCL<T, N> ret( a);
+    return ret*= s;
+}
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator* (double s, const SGridFunctionCL<T, N>& a)
+{
+    return a*s;
+}
+
+template <class T, Uint N>
+inline SGridFunctionCL<T, N>
+operator* (const SGridFunctionCL<T, N>& a, const SGridFunctionCL<double, N>& b)
+{
+    SGridFunctionCL<T, N> ret( a);
+    return ret*= b;
+}
+
+template <Uint D, Uint N>
+inline SGridFunctionCL<SVectorCL<D>, N>
+operator* (const SGridFunctionCL<double, N>& a, const SGridFunctionCL<SVectorCL<D>, N>& b)
+{
+    return b*a;
+}
+
+template <Uint D, Uint N>
+inline SGridFunctionCL<SVectorCL<D>, N>
+operator* (const SVectorCL<D>& a, const SGridFunctionCL<double, N>& b)
+{
+    SGridFunctionCL<SVectorCL<D>, N> ret( a);
+    return ret*= b;
+}
+
+template <Uint D, Uint N>
+inline SGridFunctionCL<SVectorCL<D>, N>
+operator* (const SMatrixCL<D,D>& A, const SGridFunctionCL<SVectorCL<D>, N>& b)
+{
+    SGridFunctionCL<SVectorCL<D>, N> ret;
+    for (Uint i= 0; i < N; ++i)
+        ret[i]= A*b[i];
+    return ret;
+}
+
+template <Uint D, Uint N>
+inline SGridFunctionCL<double, N>
+dot (const SGridFunctionCL<SVectorCL<D>, N>& a, const SGridFunctionCL<SVectorCL<D>, N>& b)
+{
+    SGridFunctionCL<double, N> ret;
+    for (Uint i= 0; i < N; ++i)
+        ret[i]= inner_prod( a[i], b[i]);
+    return ret;
+}
+
+template <Uint D, Uint N>
+inline SGridFunctionCL<double, N>
+dot (const SVectorCL<D>& a, const SGridFunctionCL<SVectorCL<D>, N>& b)
+{
+    SGridFunctionCL<double, N> ret;
+    for (Uint i= 0; i < N; ++i)
+        ret[i]= inner_prod( a, b[i]);
+    return ret;
+}
+
+template <Uint N>
+inline SGridFunctionCL<SMatrixCL<3,3>, N>
+outer_product (const SGridFunctionCL<Point3DCL, N>& a, const SGridFunctionCL<Point3DCL, N>& b)
+{
+    SGridFunctionCL<SMatrixCL<3,3>, N> ret;
+    for (Uint i= 0; i < N; ++i)
+        ret[i]= outer_product( a[i], b[i]);
+    return ret;
+}
+
+template <Uint N>
+inline SGridFunctionCL<double, N>
+trace (const SGridFunctionCL<SMatrixCL<3,3>, N>& a)
+{
+    SGridFunctionCL<double, N> ret;
+    for (Uint i= 0; i < N; ++i)
+        ret[i]= trace( a[i]);
+    return ret;
+}
+
+/// \brief LocalP1CL with the 4 values in the object.
+template <class T= double>
+class SLocalP1CL: public SGridFunctionCL<T, FE_P1CL::NumDoFC>
+{
+  public:
+    typedef SGridFunctionCL<T, FE_P1CL::NumDoFC> base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::instat_fun_ptr instat_fun_ptr;
+    typedef FE_P1CL FETYPE;
+
+  protected:
+    typedef SLocalP1CL<T> self_;
+
+  public:
+    SLocalP1CL () {}
+    SLocalP1CL (const value_type& t): base_type( t) {}
+    SLocalP1CL (const base_type& f): base_type( f) {}
+    SLocalP1CL (const TetraCL& s, instat_fun_ptr f, double t= 0.0) { this->assign( s, f, t); }
+    template<class BndDataT>
+      SLocalP1CL (const TetraCL& s, const VecDescCL& vd, const BndDataT& bnd) { this->assign( s, vd, bnd); }
+
+    inline self_&
+    assign (const TetraCL&, instat_fun_ptr, double= 0.0);
+    template<class BndDataT>
+      inline self_&
+      assign (const TetraCL&, const VecDescCL&, const BndDataT&);
+
+    // pointwise evaluation in barycentric coordinates
+    value_type operator() (const BaryCoordCL& p) const { return FE_P1CL::val( *this, p); }
+};
+
+/// \brief LocalP2CL with the 10 values in the object.
+template <class T= double>
+class SLocalP2CL: public SGridFunctionCL<T, FE_P2CL::NumDoFC>
+{
+  public:
+    typedef SGridFunctionCL<T, FE_P2CL::NumDoFC> base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::instat_fun_ptr instat_fun_ptr;
+    typedef FE_P2CL FETYPE;
+
+  protected:
+    typedef SLocalP2CL<T> self_;
+
+  public:
+    SLocalP2CL () {}
+    SLocalP2CL (const value_type& t): base_type( t) {}
+    SLocalP2CL (const base_type& f): base_type( f) {}
+    SLocalP2CL (const TetraCL& s, instat_fun_ptr f, double t= 0.0) { this->assign( s, f, t); }
+    template<class BndDataT>
+      SLocalP2CL (const TetraCL& s, const VecDescCL& vd, const BndDataT& bnd) { this->assign( s, vd, bnd); }
+
+    inline self_&
+    assign (const TetraCL&, instat_fun_ptr, double= 0.0);
+    /// The tetra must not be finer than the level of vd.
+    template<class BndDataT>
+      inline self_&
+      assign (const TetraCL&, const VecDescCL&, const BndDataT&);
+    inline self_&
+    assign (const LocalP2CL<T>&);
+
+    // pointwise evaluation in barycentric coordinates
+    value_type operator() (const BaryCoordCL& p) const { return FE_P2CL::val( *this, p); }
+};
+
+/// \brief Base of the quadrature rules on a tetrahedron with the values in the object.
+///
+/// QuadDataT is one of the data classes Quad2DataCL, Quad3DataCL, Quad5DataCL; it provides the number of nodes, the nodes and the weights.
+template <class T, class QuadDataT>
+class SQuadBaseCL: public SGridFunctionCL<T, QuadDataT::NumNodesC>
+{
+  public:
+    typedef SGridFunctionCL<T, QuadDataT::NumNodesC> base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::instat_fun_ptr instat_fun_ptr;
+    typedef typename base_type::tetra_function tetra_function;
+    typedef QuadDataT DataClass;
+
+  protected:
+    typedef SQuadBaseCL<T, QuadDataT> self_;
+
+  public:
+    SQuadBaseCL () {}
+    SQuadBaseCL (const value_type& t): base_type( t) {}
+    SQuadBaseCL (const base_type& f): base_type( f) {}
+
+    inline self_&
+    assign (const TetraCL&, instat_fun_ptr, double= 0.0);
+    inline self_&
+    assign (const TetraCL&, tetra_function, double= 0.0);
+    /// Evaluates a local FE-function or any other function of the barycentric coordinates in the nodes.
+    template <class LocalFunT>
+      inline self_&
+      assign (const LocalFunT&);
+    /// Evaluates a P2-function in the nodes with the tabulated values of the P2-basis; QuadDataT must provide P2_Val.
+    inline self_&
+    assign (const LocalP2CL<value_type>&);
+    inline self_&
+    assign (const SLocalP2CL<value_type>&);
+
+    T quad (double absdet) const {
+        T sum= QuadDataT::Weight[0]*(*this)[0];
+        for (Uint i= 1; i < QuadDataT::NumNodesC; ++i)
+            sum+= QuadDataT::Weight[i]*(*this)[i];
+        return sum*absdet;
+    }
+
+    // Quadraturformel zur Annaeherung von \int f*phi, phi = P2-Hutfunktion; QuadDataT must provide P2_Val.
+    T quadP2 (int i, double absdet) const {
+        T sum= (QuadDataT::Weight[0]*QuadDataT::P2_Val[i][0])*(*this)[0];
+        for (Uint k= 1; k < QuadDataT::NumNodesC; ++k)
+            sum+= (QuadDataT::Weight[k]*QuadDataT::P2_Val[i][k])*(*this)[k];
+        return sum*absdet;
+    }
+};
+
+/// \brief Quad2CL with the values in the object.
+template <class T= double>
+class SQuad2CL: public SQuadBaseCL<T, Quad2DataCL>
+{
+  public:
+    typedef SQuadBaseCL<T, Quad2DataCL> base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::instat_fun_ptr instat_fun_ptr;
+
+  protected:
+    typedef SQuad2CL<T> self_;
+
+  public:
+    SQuad2CL () {}
+    SQuad2CL (const value_type& t): base_type( t) {}
+    SQuad2CL (const SGridFunctionCL<T, Quad2DataCL::NumNodesC>& f): base_type( f) {}
+    SQuad2CL (const TetraCL& s, instat_fun_ptr f, double t= 0.0) { this->assign( s, f, t); }
+    template <class LocalFunT>
+      SQuad2CL (const LocalFunT& f) { this->assign( f); }
+
+    using base_type::assign;
+    /// The first four nodes are the vertices.
+    inline self_&
+    assign (const LocalP2CL<value_type>&);
+    inline self_&
+    assign (const SLocalP2CL<value_type>&);
+
+    // Die Spezialformeln nutzen die spezielle Lage der Stuetzstellen aus
+    T quadP1 (int i, double absdet) const
+      { return ((1./120.)*(*this)[i] + (1./30.)*(*this)[4])*absdet; }
+    T quadP2 (int i, double absdet) const
+    {
+        return (i<4 ? (1./360.)*(*this)[i] - (1./90.)*(*this)[4]
+                    : (1./180.)*((*this)[VertOfEdge(i-4,0)]+(*this)[VertOfEdge(i-4,1)]) + (1./45.)*(*this)[4]
+               )*absdet;
+    }
+};
+
+/// \brief Quad3CL with the values in the object.
+template <class T= double>
+class SQuad3CL: public SQuadBaseCL<T, Quad3DataCL>
+{
+  public:
+    typedef SQuadBaseCL<T, Quad3DataCL> base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::instat_fun_ptr instat_fun_ptr;
+
+  public:
+    SQuad3CL () {}
+    SQuad3CL (const value_type& t): base_type( t) {}
+    SQuad3CL (const SGridFunctionCL<T, Quad3DataCL::NumNodesC>& f): base_type( f) {}
+    SQuad3CL (const TetraCL& s, instat_fun_ptr f, double t= 0.0) { this->assign( s, f, t); }
+    template <class LocalFunT>
+      SQuad3CL (const LocalFunT& f) { this->assign( f); }
+};
+
+/// \brief Quad5CL with the values in the object.
+template <class T= double>
+class SQuad5CL: public SQuadBaseCL<T, Quad5DataCL>
+{
+  public:
+    typedef SQuadBaseCL<T, Quad5DataCL> base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::instat_fun_ptr instat_fun_ptr;
+
+  public:
+    SQuad5CL () {}
+    SQuad5CL (const value_type& t): base_type( t) {}
+    SQuad5CL (const SGridFunctionCL<T, Quad5DataCL::NumNodesC>& f): base_type( f) {}
+    SQuad5CL (const TetraCL& s, instat_fun_ptr f, double t= 0.0) { this->assign( s, f, t); }
+    template <class LocalFunT>
+      SQuad5CL (const LocalFunT& f) { this->assign( f); }
+};
+
+/// \brief Quad5_2DCL with the values in the object.
+template <class T= double>
+class SQuad5_2DCL: public SGridFunctionCL<T, Quad5_2DDataCL::NumNodesC>
+{
+  public:
+    typedef SGridFunctionCL<T, Quad5_2DDataCL::NumNodesC> base_type;
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::instat_fun_ptr instat_fun_ptr;
+
+  protected:
+    typedef SQuad5_2DCL<T> self_;
+
+  public:
+    SQuad5_2DCL () {}
+    SQuad5_2DCL (const value_type& t): base_type( t) {}
+    SQuad5_2DCL (const base_type& f): base_type( f) {}
+    SQuad5_2DCL (const TetraCL& s, const BaryCoordCL* const p, instat_fun_ptr f, double t= 0.0) { this->assign( s, p, f, t); }
+    template <class LocalFunT>
+      SQuad5_2DCL (const LocalFunT& f, const BaryCoordCL* const p) { this->assign( f, p); }
+
+    // The 2nd argument points to the barycentric coordinates of the 3 vertices of the triangle.
+    inline self_&
+    assign (const TetraCL&, const BaryCoordCL* const, instat_fun_ptr, double= 0.0);
+    template <class LocalFunT>
+      inline self_&
+      assign (const LocalFunT&, const BaryCoordCL* const);
+
+    T quad (double absdet) const {
+        T sum= Quad5_2DDataCL::Weight[0]*(*this)[0];
+        for (Uint i= 1; i < Quad5_2DDataCL::NumNodesC; ++i)
+            sum+= Quad5_2DDataCL::Weight[i]*(*this)[i];
+        return sum*absdet;
+    }
+};
+
+
 /// \brief Contains the nodes and weights of a positive quadrature rule on the reference pentatope. It uses 5 nodes an is exact up to degree 3.
 ///
 /// The data is initialized exactly once on program-startup by the global object in num/discretize.cpp.
@@ -1142,6 +1563,8 @@ class P1DiscCL
     static inline double Quad(const TetraCL&, instat_scalar_fun_ptr, Uint, Uint, double= 0.0);
     // cubatur formula for int f(x)*phi_i*phi_j dx, exact up to degree 1
     static inline double Quad(const TetraCL&, scalar_tetra_function, Uint, Uint, double= 0.0);
+    // the same for the values f[0..3] in the vertices and f[4] in the barycenter
+    static inline double Quad(const double f[5], Uint, Uint);
     // cubatur formula for int f(x)*phi_i over face, exact up to degree 1
     static inline double Quad2D(const TetraCL&, Uint face, instat_scalar_fun_ptr, Uint, double= 0.0);
     static inline SVectorCL<3> Quad2D(const TetraCL&, Uint face, instat_vector_fun_ptr, Uint, double= 0.0);
@@ -1157,6 +1580,8 @@ class P1DiscCL
     static inline void   GetGradients( Point3DCL H[4],    double& det, const TetraCL& t);
     static inline void   GetGradients( SMatrixCL<3,4>& H, double& det, const Point3DCL pt[4]);
     static inline void   GetGradients( Point3DCL H[4], const SMatrixCL<3,3>& T);
+    /// the gradients H[i][.][l] of the tetra l of a block from GetTrafoTr for blocks (see AccumulatorCL::visit_block)
+    static inline void   GetGradients( double H[4][3][TetraBlockSizeC], const double T[3][3][TetraBlockSizeC]);
     static void GetP1Basis( Quad5_2DCL<> p1[4], const BaryCoordCL* const p);
 };
 
@@ -1195,6 +1620,9 @@ class P2DiscCL
     static void GetGradientsOnRef( LocalP1CL<Point3DCL> GRef[10]);
     static void GetGradientsOnRef( Quad2CL<Point3DCL> GRef[10]);
     static void GetGradientsOnRef( Quad5CL<Point3DCL> GRef[10]);
+    static void GetGradientsOnRef( SQuad2CL<Point3DCL> GRef[10]);
+    static void GetGradientsOnRef( SQuad5CL<Point3DCL> GRef[10]);
+    static void GetGradientsOnRef( SLocalP1CL<Point3DCL> GRef[10]);
     // The 2nd arg points to 3 vertices of the triangle
     static void GetGradientsOnRef( Quad5_2DCL<Point3DCL> GRef[10], const BaryCoordCL* const);
     // p2[i] contains a Quad5_2DCL-object that is initialized with FE_P2CL::Hi
@@ -1208,6 +1636,12 @@ class P2DiscCL
     { for (int i=0; i<10; ++i) for (int j=0; j<Quad5DataCL::NumNodesC; ++j) G[i][j]= T*GRef[i][j]; }
     static void GetGradients( Quad5_2DCL<Point3DCL> G[10], Quad5_2DCL<Point3DCL> GRef[10], const SMatrixCL<3,3> &T)
     { for (int i=0; i<10; ++i) for (int j=0; j<Quad5_2DDataCL::NumNodesC; ++j) G[i][j]= T*GRef[i][j]; }
+    static void GetGradients( SQuad2CL<Point3DCL> G[10], const SQuad2CL<Point3DCL> GRef[10], const SMatrixCL<3,3> &T)
+    { for (int i=0; i<10; ++i) for (int j=0; j<Quad2DataCL::NumNodesC; ++j) G[i][j]= T*GRef[i][j]; }
+    static void GetGradients( SQuad5CL<Point3DCL> G[10], const SQuad5CL<Point3DCL> GRef[10], const SMatrixCL<3,3> &T)
+    { for (int i=0; i<10; ++i) for (int j=0; j<Quad5DataCL::NumNodesC; ++j) G[i][j]= T*GRef[i][j]; }
+    static void GetGradients( SLocalP1CL<Point3DCL> G[10], const SLocalP1CL<Point3DCL> GRef[10], const SMatrixCL<3,3> &T)
+    { for (int i=0; i<10; ++i) for (int j=0; j<4; ++j) G[i][j]= T*GRef[i][j]; }
     static void GetGradient( Quad2CL<Point3DCL> &G, Quad2CL<Point3DCL> &GRef, const SMatrixCL<3,3> &T)
     { for (int j=0; j<5; ++j) G[j]= T*GRef[j]; }
     static void GetGradient( Quad5CL<Point3DCL> &G, Quad5CL<Point3DCL> &GRef, const SMatrixCL<3,3> &T)
@@ -1225,6 +1659,15 @@ class P2DiscCL
     static inline double GetMass( int i, int j);
     // returns int phi_i dx
     static inline double GetLumpedMass( int i) { return i<4 ? -1./120. : 1./30.; }
+    /// \brief Computes GG[i][j]= int_D grad phi_i (grad phi_j)^T dx for j <= i from the gradients G (see GetGradients) and m[k][l]= int_D lambda_k lambda_l dx.
+    ///
+    /// As the gradients are linear, the P1 mass matrix m of the domain D determines the integrals exactly. For D= K, m is absdet*P1DiscCL::GetMass;
+    /// for a part of a cut tetra, m is a sum over the few quadrature points of the part.
+    static void GetGradientProducts( SMatrixCL<3,3> GG[10][10], const SLocalP1CL<Point3DCL> G[10], const double m[4][4]);
+    /// \brief Computes A[i][j][l]= int grad phi_i . grad phi_j dx for j <= i on the tetra l of a block (see AccumulatorCL::visit_block).
+    ///
+    /// H are the P1-gradients from P1DiscCL::GetGradients for blocks. The integrals are linear combinations of the products of the P1-gradients with coefficients from the reference tetra.
+    static void GetStiffness( double A[10][10][TetraBlockSizeC], const double H[4][3][TetraBlockSizeC], const double absdet[TetraBlockSizeC]);
 };
 
 class P2RidgeDiscCL
@@ -1406,6 +1849,24 @@ inline double P1DiscCL::Quad( const TetraCL& s, scalar_tetra_function coeff, Uin
     }
 }
 
+inline double P1DiscCL::Quad( const double f[5], Uint i, Uint j)
+{
+    double f_Other= 0;
+
+    if (i==j)
+    {
+        for (Uint k=0; k<4; ++k)
+            if (k!=i) f_Other+= f[k];
+        return 43./7560.*f[i] + f_Other/7560. + 2./189.*f[4];
+    }
+    else
+    {
+        for (Uint k=0; k<4; ++k)
+            if (k!=i && k!=j) f_Other+= f[k];
+        return 11./7560.*(f[i] + f[j]) + f_Other/15120. + f[4]/189.;
+    }
+}
+
 inline double P1DiscCL::Quad2D(const TetraCL& t, Uint face, instat_scalar_fun_ptr bfun, Uint vert, double time)
 // Integrate neu_val() * phi_vert over face
 {
@@ -1513,6 +1974,17 @@ inline void P1DiscCL::GetGradients( Point3DCL H[4], const SMatrixCL<3,3>& T)
         H[i]= T*FE_P1CL::DHRef( i);
 }
 
+inline void P1DiscCL::GetGradients( double H[4][3][TetraBlockSizeC], const double T[3][3][TetraBlockSizeC])
+{
+    for (int r= 0; r < 3; ++r)
+        for (Uint l= 0; l < TetraBlockSizeC; ++l) {
+            H[1][r][l]= T[r][0][l];
+            H[2][r][l]= T[r][1][l];
+            H[3][r][l]= T[r][2][l];
+            H[0][r][l]= -H[1][r][l] - H[2][r][l] - H[3][r][l];
+        }
+}
+
 inline void P1DiscCL::GetGradients (SMatrixCL<3,4>& H, double& det, const Point3DCL pt[4])
 {
     SMatrixCL<3 ,3> M;
@@ -886,4 +886,201 @@ template<class T>
 }
 
 
+
+//**************************************************************************
+// Class:   SLocalP1CL                                                     *
+//**************************************************************************
+template<class T>
+  inline SLocalP1CL<T>&
+  SLocalP1CL<T>::assign(const TetraCL& s, instat_fun_ptr f, double t)
+{
+    for (Uint i= 0; i< NumVertsC; ++i)
+        (*this)[i]= f( s.GetVertex( i)->GetCoord(), t);
+    return *this;
+}
+
+template<class T>
+  template<class BndDataT>
+    inline SLocalP1CL<T>&
+    SLocalP1CL<T>::assign(const TetraCL& s,
+        const VecDescCL& vd, const BndDataT& bnd)
+{
+    typedef VecDescCL::DataType VecT;
+    typedef DoFHelperCL<value_type, VecT> DoFT;
+    const VecT& v= vd.Data;
+    const Uint idx= vd.RowIdx->GetIdx();
+    for (Uint i= 0; i< NumVertsC; ++i)
+        (*this)[i]= !bnd.IsOnDirBnd( *s.GetVertex( i))
+            ? DoFT::get( v, s.GetVertex( i)->Unknowns( idx))
+            : bnd.GetDirBndValue( *s.GetVertex( i), vd.t);
+    return *this;
+}
+
+//**************************************************************************
+// Class:   SLocalP2CL                                                     *
+//**************************************************************************
+template<class T>
+  inline SLocalP2CL<T>&
+  SLocalP2CL<T>::assign(const TetraCL& s, instat_fun_ptr f, double t)
+{
+    for (Uint i= 0; i< NumVertsC; ++i)
+        (*this)[i]= f( s.GetVertex( i)->GetCoord(), t);
+    for (Uint i= 0; i< NumEdgesC; ++i)
+        (*this)[i+NumVertsC]= f( GetBaryCenter( *s.GetEdge( i)), t);
+    return *this;
+}
+
+template<class T>
+  template<class BndDataT>
+    inline SLocalP2CL<T>&
+    SLocalP2CL<T>::assign(const TetraCL& s,
+        const VecDescCL& vd, const BndDataT& bnd)
+{
+    typedef VecDescCL::DataType VecT;
+    typedef DoFHelperCL<value_type, VecT> DoFT;
+    const VecT& v= vd.Data;
+    const Uint idx= vd.RowIdx->GetIdx();
+    if (vd.RowIdx->IsDG()) {
+        Uint first= s.Unknowns( idx);
+        for (Uint i= 0; i < 10; ++i)
+            (*this)[i]= DoFT::get( v, first++);
+        return *this;
+    }
+    const Uint tlvl= s.GetLevel();
+    const Uint vlvl= vd.GetLevel();
+    if (tlvl == vlvl) {
+        for (Uint i= 0; i< NumVertsC; ++i)
+            (*this)[i]= !bnd.IsOnDirBnd( *s.GetVertex( i))
+                ? DoFT::get( v, s.GetVertex( i)->Unknowns( idx))
+                : bnd.GetDirBndValue( *s.GetVertex( i), vd.t);
+        for (Uint i= 0; i< NumEdgesC; ++i)
+            (*this)[i+NumVertsC]= !bnd.IsOnDirBnd( *s.GetEdge( i))
+                ? DoFT::get( v, s.GetEdge( i)->Unknowns( idx))
+                : bnd.GetDirBndValue( *s.GetEdge( i), vd.t);
+    }
+    else {
+        if (tlvl < vlvl) RestrictP2( s, vd, bnd, *this);
+        else throw DROPSErrCL( "SLocalP2CL::Assign: Prolongation not implemented.\n");
+    }
+    return *this;
+}
+
+template<class T>
+  inline SLocalP2CL<T>&
+  SLocalP2CL<T>::assign(const LocalP2CL<T>& f)
+{
+    for (Uint i= 0; i < 10; ++i)
+        (*this)[i]= f[i];
+    return *this;
+}
+
+//**************************************************************************
+// Class:   SQuadBaseCL                                                    *
+//**************************************************************************
+template<class T, class QuadDataT>
+  inline SQuadBaseCL<T, QuadDataT>&
+  SQuadBaseCL<T, QuadDataT>::assign(const TetraCL& s, instat_fun_ptr f, double t)
+{
+    const Point3DCL& v0= s.GetVertex( 0)->GetCoord(), & v1= s.GetVertex( 1)->GetCoord(),
+                   & v2= s.GetVertex( 2)->GetCoord(), & v3= s.GetVertex( 3)->GetCoord();
+    for (Uint i= 0; i < QuadDataT::NumNodesC; ++i) {
+        const BaryCoordCL& b= QuadDataT::Node[i];
+        (*this)[i]= f( b[0]*v0 + b[1]*v1 + b[2]*v2 + b[3]*v3, t);
+    }
+    return *this;
+}
+
+template<class T, class QuadDataT>
+  inline SQuadBaseCL<T, QuadDataT>&
+  SQuadBaseCL<T, QuadDataT>::assign(const TetraCL& s, tetra_function f, double t)
+{
+    for (Uint i= 0; i < QuadDataT::NumNodesC; ++i)
+        (*this)[i]= f( s, QuadDataT::Node[i], t);
+    return *this;
+}
+
+template<class T, class QuadDataT>
+  template <class LocalFunT>
+    inline SQuadBaseCL<T, QuadDataT>&
+    SQuadBaseCL<T, QuadDataT>::assign(const LocalFunT& f)
+{
+    for (Uint i= 0; i < QuadDataT::NumNodesC; ++i)
+        (*this)[i]= f( QuadDataT::Node[i]);
+    return *this;
+}
+
+template<class T, class QuadDataT>
+  inline SQuadBaseCL<T, QuadDataT>&
+  SQuadBaseCL<T, QuadDataT>::assign(const LocalP2CL<value_type>& f)
+{
+    for (Uint i= 0; i < QuadDataT::NumNodesC; ++i) {
+        (*this)[i]= QuadDataT::P2_Val[0][i]*f[0];
+        for (Uint j= 1; j < 10; ++j)
+            (*this)[i]+= QuadDataT::P2_Val[j][i]*f[j];
+    }
+    return *this;
+}
+
+template<class T, class QuadDataT>
+  inline SQuadBaseCL<T, QuadDataT>&
+  SQuadBaseCL<T, QuadDataT>::assign(const SLocalP2CL<value_type>& f)
+{
+    for (Uint i= 0; i < QuadDataT::NumNodesC; ++i) {
+        (*this)[i]= QuadDataT::P2_Val[0][i]*f[0];
+        for (Uint j= 1; j < 10; ++j)
+            (*this)[i]+= QuadDataT::P2_Val[j][i]*f[j];
+    }
+    return *this;
+}
+
+//**************************************************************************
+// Class:   SQuad2CL                                                       *
+//**************************************************************************
+template<class T>
+  inline SQuad2CL<T>&
+  SQuad2CL<T>::assign(const LocalP2CL<value_type>& f)
+{
+    for (Uint i= 0; i < 4; ++i)
+        (*this)[i]= f[i];
+    (*this)[4]= f( BaryCoordCL( 0.25));
+    return *this;
+}
+
+template<class T>
+  inline SQuad2CL<T>&
+  SQuad2CL<T>::assign(const SLocalP2CL<value_type>& f)
+{
+    for (Uint i= 0; i < 4; ++i)
+        (*this)[i]= f[i];
+    (*this)[4]= f( BaryCoordCL( 0.25));
+    return *this;
+}
+
+//**************************************************************************
+// Class:   SQuad5_2DCL                                                    *
+//**************************************************************************
+template<class T>
+  inline SQuad5_2DCL<T>&
+  SQuad5_2DCL<T>::assign(const TetraCL& s, const BaryCoordCL* const p, instat_fun_ptr f, double t)
+{
+    Point3DCL v[3];
+    for (Uint k= 0; k < 3; ++k)
+        v[k]= GetWorldCoord(s, p[k]);
+    for (Uint i= 0; i < Quad5_2DDataCL::NumNodesC; ++i)
+        (*this)[i]= f( Quad5_2DDataCL::Node[i][0]*v[0]+Quad5_2DDataCL::Node[i][1]*v[1]+Quad5_2DDataCL::Node[i][2]*v[2], t);
+    return *this;
+}
+
+template<class T>
+  template <class LocalFunT>
+    inline SQuad5_2DCL<T>&
+    SQuad5_2DCL<T>::assign(const LocalFunT& f, const BaryCoordCL* const p)
+{
+    BaryCoordCL NodeInTetra[Quad5_2DDataCL::NumNodesC];
+    Quad5_2DDataCL::SetInterface( p, NodeInTetra);
+    for (Uint i= 0; i < Quad5_2DDataCL::NumNodesC; ++i)
+        (*this)[i]= f( NodeInTetra[i]);
+    return *this;
+}
+
 } // end of namespace DROPS
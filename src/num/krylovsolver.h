@@ -26,6 +26,7 @@
 #define DROPS_SOLVER_H
 
 #include <vector>
+#include <algorithm>
 #include "misc/container.h"
 #include "num/spmat.h"
 #include "num/spblockmat.h"
@@ -178,6 +179,102 @@ bool PCG(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX,
 }
 
 
+/// \brief Pipelined preconditioned CG-Algorithm (Ghysels, Vanroose)
+///
+/// Mathematically equivalent to PCG, but the three inner products of an iteration are
+/// reduced over all processes with a single non-blocking reduction, which is overlapped
+/// with the application of the preconditioner, the matrix-vector product and the
+/// accumulation of its result. The residual is updated by recurrences, which need one
+/// additional matrix-vector product per iteration; thus, this pays off only if the
+/// global reductions dominate, e.g., on many processes.
+template <typename Mat, typename Vec, typename PreCon, typename ExCL>
+bool PipelinedPCG(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX,
+            PreCon& M, int& max_iter, double& tol, bool measure_relative_tol=false,
+            std::ostream* output=0)
+    /// \param[in]     A                    local distributed coefficients-matrix of the linear equation system
+    /// \param[in,out] x_acc                start vector and the solution in accumulated form
+    /// \param[in]     b                    rhs of the linear equation system (distributed form)
+    /// \param[in]     ExX                  ExchangeCL corresponding to the RowIdx of x and the ColIdx of A
+    /// \param[in,out] M                    Preconditioner
+    /// \param[in,out] max_iter             IN: maximal iterations, OUT: used iterations
+    /// \param[in,out] tol                  IN: tolerance for the residual, OUT: residual
+    /// \param[in]     measure_relative_tol measure relative residual
+    /// \return                             convergence within max_iter iterations
+{
+    if (M.NeedDiag())
+        M.SetDiag(A, ExX);
+
+    const size_t n= x_acc.size();
+    // r, s are only needed in accumulated form; w, z in both forms and u, m, p, q are accumulated.
+    Vec r( b - A*x_acc), r_acc( n), u( n), w( n), w_acc( n), m( n), nv( n), nv_acc( n),
+        z( n), z_acc( n), q( n), s_acc( n), p( n);
+
+    double normb= ExX.Norm( b, false),
+           resid= ExX.Norm( r, false, &r_acc);
+    if (normb == 0.0 || measure_relative_tol == false)
+        normb= 1.0;
+    resid= resid/normb;
+    if (resid<=tol){
+        tol= resid;
+        max_iter= 0;
+        return true;
+    }
+
+    M.Apply(A, u, r, ExX);
+    if (!M.RetAcc())
+        ExX.Accumulate( u);
+    w= A*u;
+    w_acc= ExX.GetAccumulate( w);
+
+    double sums[3], gamma_old= 1.0, alpha= 1.0;
+    for (int i=0; i<=max_iter; ++i)
+    {
+        sums[0]= ExX.LocalDot( r_acc, true, u, true);      // gamma= (r,u)
+        sums[1]= ExX.LocalDot( w_acc, true, u, true);      // delta= (w,u)
+        sums[2]= ExX.LocalNorm_sq( r_acc, true);           // |r|^2
+        ExX.StartGlobalSum( sums, 3);
+
+        M.Apply(A, m, w, ExX);                             // m= M^{-1} w
+        if (!M.RetAcc())
+            ExX.Accumulate( m);
+        nv= A*m;
+        nv_acc= nv;
+        ExX.Accumulate( nv_acc);
+
+        ExX.WaitGlobalSum();
+        resid= std::sqrt( sums[2])/normb;
+        if (output)
+            (*output) << "PipelinedPCG: " << i << " resid " << resid << std::endl;
+        if (resid<=tol){
+            tol= resid;
+            max_iter= i;
+            return true;
+        }
+        if (i == max_iter)
+            break;
+
+        const double gamma= sums[0], delta= sums[1];
+        const double beta= i == 0 ? 0.0 : gamma/gamma_old;
+        alpha= i == 0 ? gamma/delta : gamma/(delta - beta*gamma/alpha);
+        gamma_old= gamma;
+
+        z_xpay( z, nv, beta, z);                           // z= n + beta*z
+        z_xpay( z_acc, nv_acc, beta, z_acc);
+        z_xpay( q, m, beta, q);                            // q= m + beta*q
+        z_xpay( s_acc, w_acc, beta, s_acc);                // s= w + beta*s
+        z_xpay( p, u, beta, p);                            // p= u + beta*p
+
+        axpy(  alpha, p, x_acc);                           // x+= alpha*p
+        axpy( -alpha, s_acc, r_acc);                       // r-= alpha*s
+        axpy( -alpha, q, u);                               // u-= alpha*q
+        axpy( -alpha, z, w);                               // w-= alpha*z
+        axpy( -alpha, z_acc, w_acc);
+    }
+    tol= resid;
+    return false;
+}
+
+
 /// \brief PCGNE: Preconditioned CG for the normal equations (error-minimization)
 ///
 /// Solve A*A^T x = b with left preconditioner M. This is more stable than PCG with
@@ -292,7 +389,7 @@ void GMRES_Update(Vec &x, int k, const Mat &H, const Vec &s, const std::vector<V
     }
 
     for ( int i=0; i<=k; ++i )
-        x += y[i] * v[i];
+        axpy( y[i], v[i], x);
 }
 enum PreMethGMRES { RightPreconditioning, LeftPreconditioning};
 
@@ -368,12 +465,11 @@ GMRES(const Mat& A, Vec& x, const Vec& b, const ExT& ex, PreCon& M,
                 w=A*w;
             }
             else M.Apply( A, w, A*v[i], ex);
-            for (int k= 0; k <= i; ++k ) {
-                H( k, i)= dot( w, v[k]);
-                w-= H( k, i)*v[k];
-            }
-
-            H( i + 1, i)= norm( w);
+            // Modified Gram-Schmidt; each update of w is fused with the next inner product.
+            H( 0, i)= dot( w, v[0]);
+            for (int k= 0; k < i; ++k)
+                H( k + 1, i)= axpy_dot( -H( k, i), v[k], w, v[k + 1]);
+            H( i + 1, i)= std::sqrt( axpy_norm_sq( -H( i, i), v[i], w));
             v[i + 1]= w*(1.0/H( i + 1, i));
 
             for (int k= 0; k < i; ++k)
@@ -895,6 +991,138 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
 }
 #endif
 
+/// \brief Orthogonalize the accumulated vector w against v[0..i] by classical Gram-Schmidt
+///
+/// The inner products with all v[k] and the squared norm of w are reduced over all
+/// processes at once by a blocking reduction; the norm of the orthogonalized vector is obtained by Pythagoras.
+/// If this indicates cancellation, i.e., w lost more than half of its squared norm,
+/// the orthogonalization is repeated once ("twice is enough"). Hence, there is one
+/// synchronization point in the usual case instead of i+2 for modified Gram-Schmidt.
+/// \param H    Hessenberg matrix; the coefficients are stored in column i
+/// \param w    accumulated vector to orthogonalize
+/// \param v    accumulated orthonormal vectors
+/// \param i    index of the last vector in v used for orthogonalization
+/// \param ex   class to compute parallel inner products
+/// \param sums buffer for the local sums with at least i+2 entries
+/// \return     norm of the orthogonalized w
+template <typename Vec, typename ExCL>
+double CGS2Orthogonalize(DMatrixCL<double>& H, Vec& w, const std::vector<Vec>& v, int i, const ExCL& ex,
+                         std::vector<double>& sums)
+{
+    for (int pass= 0; pass < 2; ++pass) {
+        for (int k= 0; k <= i; ++k)
+            sums[k]= ex.LocalDot( w, true, v[k], true);
+        sums[i + 1]= ex.LocalNorm_sq( w, true);
+        ex.GlobalSum( &sums[0], i + 2);
+
+        double norm_sq= sums[i + 1];
+        for (int k= 0; k <= i; ++k) {
+            H( k, i)= (pass == 0 ? 0. : H( k, i)) + sums[k];
+            axpy( -sums[k], v[k], w);
+            norm_sq-= sums[k]*sums[k];
+        }
+        if (norm_sq > 0.5*sums[i + 1])
+            return std::sqrt( norm_sq);
+    }
+    return ex.Norm( w, true); // the value of Pythagoras is not reliable after the second pass
+}
+
+/// \brief GMRES with left preconditioning and CGS2Orthogonalize
+///
+/// Same algorithm as GMRES with LeftPreconditioning, but the Arnoldi vectors are kept in
+/// accumulated form and orthogonalized by CGS2Orthogonalize. Thus, an iteration needs a
+/// single global reduction in the usual case, which pays off on many processes. The
+/// reduction is not overlapped with other work. Works in the serial and in the parallel version.
+template <typename Mat, typename Vec, typename PreCon, typename ExCL>
+bool CGS2GMRES(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX, PreCon& M,
+               int m, int& max_iter, double& tol, bool measure_relative_tol=true, std::ostream* output=0)
+    /// \param[in]     A                    local distributed coefficients-matrix of the linear equation system
+    /// \param[in,out] x_acc                start vector and the solution in accumulated form
+    /// \param[in]     b                    rhs of the linear equation system (distributed form)
+    /// \param[in]     ExX                  ExchangeCL corresponding to the RowIdx of x and the ColIdx of A
+    /// \param[in,out] M                    Preconditioner
+    /// \param[in]     m                    number of steps after a restart is performed
+    /// \param[in,out] max_iter             IN: maximal iterations, OUT: used iterations
+    /// \param[in,out] tol                  IN: tolerance for the residual, OUT: residual
+    /// \param[in]     measure_relative_tol if true stop if |M^(-1)(b-Ax)|/|M^(-1)b| <= tol, else stop if |M^(-1)(b-Ax)|<=tol
+    /// \return  convergence within max_iter iterations
+{
+    if (M.NeedDiag())
+        M.SetDiag(A, ExX);
+
+    m= (m <= max_iter) ? m : max_iter; // m > max_iter only wastes memory.
+
+    DMatrixCL<double>   H( m, m);
+    Vec                 s( m), cs( m), sn( m), w( b.size()), r( b.size());
+    std::vector<Vec>    v( m);
+    std::vector<double> sums( m + 1);
+    for (int i= 0; i < m; ++i)
+        v[i].resize( b.size());
+
+    M.Apply( A, w, b, ExX);
+    double normb= ExX.Norm( w, M.RetAcc());
+    M.Apply( A, r, Vec( b - A*x_acc), ExX);
+    if (!M.RetAcc())
+        ExX.Accumulate( r);
+    double beta= ExX.Norm( r, true);
+    if (normb == 0.0 || measure_relative_tol == false) normb= 1.0;
+
+    double resid= beta/normb;
+    if (resid <= tol) {
+        tol= resid;
+        max_iter= 0;
+        return true;
+    }
+
+    int j= 1;
+    while (j <= max_iter) {
+        v[0]= r*(1.0/beta);
+        s= 0.0;
+        s[0]= beta;
+
+        int i;
+        for (i= 0; i < m - 1 && j <= max_iter; ++i, ++j) {
+            M.Apply( A, w, A*v[i], ExX);
+            if (!M.RetAcc())
+                ExX.Accumulate( w);
+            H( i + 1, i)= CGS2Orthogonalize( H, w, v, i, ExX, sums);
+            if (H( i + 1, i) != 0.0) // otherwise, the Krylov space is invariant and the residual vanishes.
+                v[i + 1]= w*(1.0/H( i + 1, i));
+
+            for (int k= 0; k < i; ++k)
+                GMRES_ApplyPlaneRotation( H(k,i), H(k + 1, i), cs[k], sn[k]);
+
+            GMRES_GeneratePlaneRotation( H(i,i), H(i+1,i), cs[i], sn[i]);
+            GMRES_ApplyPlaneRotation( H(i,i), H(i+1,i), cs[i], sn[i]);
+            GMRES_ApplyPlaneRotation( s[i], s[i+1], cs[i], sn[i]);
+
+            resid= std::abs( s[i+1])/normb;
+            if (output)
+                (*output) << "CGS2GMRES: " << j << " resid " << resid << std::endl;
+            if (resid <= tol) {
+                GMRES_Update( x_acc, i, H, s, v);
+                tol= resid;
+                max_iter= j;
+                return true;
+            }
+        }
+
+        GMRES_Update( x_acc, i - 1, H, s, v);
+        M.Apply( A, r, Vec( b - A*x_acc), ExX);
+        if (!M.RetAcc())
+            ExX.Accumulate( r);
+        beta= ExX.Norm( r, true);
+        resid= beta/normb;
+        if (resid <= tol) {
+            tol= resid;
+            max_iter= j;
+            return true;
+        }
+    }
+    tol= resid;
+    return false;
+}
+
 /** One recursive step of Lanzcos' algorithm for computing an ONB (q1, q2, q3,...)
  * of the Krylovspace of A for a given starting vector r.
  *
@@ -1195,26 +1423,26 @@ bool BICGSTAB( const Mat& A, Vec& x, const Vec& b, const ExT& ex,
             p= r;
         else {
             beta= (rho_1/rho_2)*(alpha/omega);
-            p= r + beta*(p - omega*v);
+            z_xpaypby2( p, r, beta, p, -beta*omega, v); // p= r + beta*(p - omega*v);
         }
         M.Apply( A, phat, p, ex);
         v= A*phat;
         alpha= rho_1/dot( rtilde, v);
-        s= r - alpha*v;
-        if ((resid= norm( s)/normb) < tol) {
-            x+= alpha*phat;
+        if ((resid= std::sqrt( z_xpay_norm_sq( s, r, -alpha, v))/normb) < tol) { // s= r - alpha*v;
+            axpy( alpha, phat, x);
             tol= resid;
             max_iter= i;
             return true;
         }
         M.Apply( A, shat, s, ex);
         t= A*shat;
-        omega= dot( t, s)/dot( t, t);
-        x+= alpha*phat + omega*shat;
-        r= s - omega*t;
+        double ts, tt;
+        dot2( t, s, t, ts, tt);
+        omega= ts/tt;
+        z_xpaypby2( x, x, alpha, phat, omega, shat); // x+= alpha*phat + omega*shat;
 
         rho_2= rho_1;
-        if ((resid= norm( r)/normb) < tol) {
+        if ((resid= std::sqrt( z_xpay_norm_sq( r, s, -omega, t))/normb) < tol) { // r= s - omega*t;
             tol= resid;
             max_iter= i;
             return true;
@@ -1418,9 +1646,9 @@ bool GCR(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
 //            const double alpha= ExX.ParDot( vn, false, v[i], false);
             const double alpha= ExX.ParDot( vnacc, true, vacc[i], true);
             a[i]= alpha;
-            vn-= alpha*v[i];
-            vnacc-= alpha*vacc[i];  // memory usage vs communication overhead
-            sn-= alpha*s[i];
+            axpy( -alpha, v[i], vn);
+            axpy( -alpha, vacc[i], vnacc);  // memory usage vs communication overhead
+            axpy( -alpha, s[i], sn);
         }
 //        const double beta= ExX.Norm( vn, false, &vnacc);
         const double beta= ExX.Norm( vnacc, true);
@@ -1429,11 +1657,11 @@ bool GCR(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
         sn/= beta;
         const double gamma= ExX.ParDot( racc, true, vnacc, true);
         if (!M.RetAcc())
-            x+= gamma*ExX.GetAccumulate(sn);
+            axpy( gamma, ExX.GetAccumulate(sn), x);
         else
-            x+= gamma*sn;
-        r-= gamma*vn;
-        racc -= gamma*vnacc;
+            axpy( gamma, sn, x);
+        axpy( -gamma, vn, r);
+        axpy( -gamma, vnacc, racc);
         resid= ExX.Norm( racc, true)/normb;
         if (k < m) {
             s.push_back( sn);
@@ -1460,6 +1688,216 @@ bool GCR(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
 }
 
 
+/// \brief Harmonic Ritz space of A with respect to the directions s; v= A*s must be orthonormal, both are accumulated
+///
+/// G= V^T S is the projection of A^{-1} onto span(V). The invariant subspace of G for its k eigenvalues of
+/// largest modulus, i.e., for the k smallest harmonic Ritz values of A, is approximated by subspace iteration
+/// starting with the directions s[start[l]]; U is set to the corresponding linear combinations of the s.
+/// This needs s.size()^2 inner products, which are reduced over all processes at once.
+template <typename Vec, typename ExCL>
+void GCRHarmonicRitzSpace (const std::vector<Vec>& s, const std::vector<Vec>& vacc, const ExCL& ex,
+    const std::vector<size_t>& start, std::vector<Vec>& U, int numiter= 20)
+{
+    const size_t j= s.size(), k= start.size();
+    U.resize( k);
+    if (k == 0)
+        return;
+
+    std::vector<double> G( j*j), Q( j*k, 0.), Z( j*k); // Q, Z column-wise
+    for (size_t p= 0; p < j; ++p)
+        for (size_t q= 0; q < j; ++q)
+            G[p*j + q]= ex.LocalDot( vacc[p], true, s[q], true);
+    ex.StartGlobalSum( &G[0], j*j);
+    ex.WaitGlobalSum();
+
+    for (size_t l= 0; l < k; ++l)
+        Q[l*j + start[l]]= 1.;
+    for (int it= 0; it < numiter; ++it) {
+        for (size_t l= 0; l < k; ++l)   // Z= G*Q
+            for (size_t p= 0; p < j; ++p) {
+                double sum= 0.;
+                for (size_t q= 0; q < j; ++q)
+                    sum+= G[p*j + q]*Q[l*j + q];
+                Z[l*j + p]= sum;
+            }
+        for (size_t l= 0; l < k; ++l) { // Q= orthonormalized Z (modified Gram-Schmidt)
+            double* z= &Z[l*j];
+            for (size_t i= 0; i < l; ++i) {
+                const double* qi= &Q[i*j];
+                double alpha= 0.;
+                for (size_t p= 0; p < j; ++p)
+                    alpha+= z[p]*qi[p];
+                for (size_t p= 0; p < j; ++p)
+                    z[p]-= alpha*qi[p];
+            }
+            double nrm= 0.;
+            for (size_t p= 0; p < j; ++p)
+                nrm+= z[p]*z[p];
+            nrm= std::sqrt( nrm);
+            for (size_t p= 0; p < j; ++p)
+                Q[l*j + p]= nrm > 0. ? z[p]/nrm : 0.;
+        }
+    }
+
+    for (size_t l= 0; l < k; ++l) {
+        U[l].resize( s[0].size());
+        U[l]= 0.;
+        for (size_t q= 0; q < j; ++q)
+            axpy( Q[l*j + q], s[q], U[l]);
+    }
+}
+
+
+//*****************************************************************
+// RecycleGCR
+//
+// GCR, which recycles search directions between the solution of a
+// sequence of similar systems (in the spirit of GCRO-DR).
+//
+// U -- on entry: directions kept from the last solve (accumulated form);
+//     they are conjugated with respect to the current matrix A and the
+//     residual of the initial guess is projected onto A*span(U) before
+//     the iteration starts; all new directions are orthogonalized against
+//     these, too. If the size of U does not fit, U is discarded.
+//     On exit: a basis of the (at most) k-dimensional harmonic Ritz space
+//     for the smallest harmonic Ritz values of A with respect to all
+//     directions of this solve, see GCRHarmonicRitzSpace.
+// m -- truncation parameter for the new directions, see GCR; the new
+//     direction with the smallest contribution to the residual reduction
+//     is overwritten.
+// max_iter -- on exit, the number of iterations, i.e., of applications
+//     of the preconditioner; the projection onto the recycled directions
+//     counts as one iteration. Thus, a solve with 0 iterations does not
+//     modify x.
+// The other parameters are the same as for GCR.
+//*****************************************************************
+template <typename Mat, typename Vec, typename PreCon, typename ExCL>
+bool RecycleGCR(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
+    int m, std::vector<Vec>& U, int k, int& max_iter, double& tol, bool measure_relative_tol=true, std::ostream* output=0)
+{
+    if (M.NeedDiag())
+        M.SetDiag(A, ExX);
+
+    m= (m <= max_iter) ? m : max_iter; // m > max_iter only wastes memory.
+    if (!U.empty() && U.front().size() != x.size())
+        U.clear();
+
+    Vec r( b - A*x);
+    Vec racc( r.size());
+    double normb= ExX.Norm( b, false);
+    if (normb == 0.0 || measure_relative_tol == false) normb= 1.0;
+    double resid= ExX.Norm( r, false, &racc)/normb;
+    if (resid < tol) {
+        tol= resid;
+        max_iter= 0;
+        return true;
+    }
+
+    // search directions s (accumulated) and v= A*s (distributed and accumulated), the v are orthonormal;
+    // the first nrec directions are the recycled ones. a contains the coefficients of the residual update.
+    std::vector<Vec> s, v, vacc;
+    std::vector<double> a;
+    Vec sn( b.size()), vn( b.size()), vnacc( b.size());
+
+    for (size_t j= 0; j < U.size(); ++j) {
+        sn= U[j];
+        vn= A*sn;
+        vnacc= ExX.GetAccumulate( vn);
+        const double norm0= ExX.Norm( vnacc, true);
+        for (size_t i= 0; i < s.size(); ++i) {
+            const double alpha= ExX.ParDot( vnacc, true, vacc[i], true);
+            axpy( -alpha, v[i], vn);
+            axpy( -alpha, vacc[i], vnacc);
+            axpy( -alpha, s[i], sn);
+        }
+        const double beta= ExX.Norm( vnacc, true);
+        if (!(beta > 1e-10*norm0)) // U[j] is numerically in the span of the previous directions.
+            continue;
+        s.push_back( sn/=beta);
+        v.push_back( vn/=beta);
+        vacc.push_back( vnacc/=beta);
+    }
+    const size_t nrec= s.size();
+    a.resize( nrec);
+    for (size_t i= 0; i < nrec; ++i) {
+        const double gamma= ExX.ParDot( racc, true, vacc[i], true);
+        a[i]= gamma;
+        axpy( gamma, s[i], x);
+        axpy( -gamma, v[i], r);
+        axpy( -gamma, vacc[i], racc);
+    }
+    if (nrec > 0) {
+        if (output)
+            (*output) << "RecycleGCR: " << nrec << " recycled directions reduced the residual from " << resid;
+        resid= ExX.Norm( racc, true)/normb;
+        if (output)
+            (*output) << " to " << resid << std::endl;
+    }
+
+    int k_it= nrec > 0 ? 1 : 0;
+    for (; ; ++k_it) {
+        if (k_it%10==0 && output)
+            (*output) << "RecycleGCR: k: " << k_it << "\tresidual: " << resid << std::endl;
+        if (resid < tol || k_it >= max_iter)
+            break;
+        M.Apply( A, sn, r, ExX);
+        if (!M.RetAcc())
+            ExX.Accumulate( sn);
+        vn= A*sn;
+        vnacc= ExX.GetAccumulate( vn);
+        for (size_t i= 0; i < s.size(); ++i) {
+            const double alpha= ExX.ParDot( vnacc, true, vacc[i], true);
+            axpy( -alpha, v[i], vn);
+            axpy( -alpha, vacc[i], vnacc);
+            axpy( -alpha, s[i], sn);
+        }
+        const double beta= ExX.Norm( vnacc, true);
+        vn/= beta;
+        vnacc/= beta;
+        sn/= beta;
+        const double gamma= ExX.ParDot( racc, true, vnacc, true);
+        axpy( gamma, sn, x);
+        axpy( -gamma, vn, r);
+        axpy( -gamma, vnacc, racc);
+        resid= ExX.Norm( racc, true)/normb;
+        if (s.size() < nrec + m) {
+            s.push_back( sn);
+            v.push_back( vn);
+            vacc.push_back( vnacc);
+            a.push_back( gamma);
+        }
+        else {
+            size_t min_idx= nrec;
+            for (size_t i= nrec + 1; i < s.size(); ++i)
+                if (std::fabs( a[i]) < std::fabs( a[min_idx]))
+                    min_idx= i;
+            if (std::fabs( gamma) > std::fabs( a[min_idx])) {
+                s[min_idx]= sn;
+                v[min_idx]= vn;
+                vacc[min_idx]= vnacc;
+                a[min_idx]= gamma;
+            }
+        }
+    }
+
+    // The subspace iteration for the new recycle space starts with the directions with the largest coefficients.
+    std::vector<std::pair<double, size_t> > order( s.size());
+    for (size_t i= 0; i < s.size(); ++i)
+        order[i]= std::make_pair( -std::fabs( a[i]), i);
+    const size_t numkeep= std::min( s.size(), static_cast<size_t>( std::max( k, 0)));
+    std::partial_sort( order.begin(), order.begin() + numkeep, order.end());
+    std::vector<size_t> start( numkeep);
+    for (size_t i= 0; i < numkeep; ++i)
+        start[i]= order[i].second;
+    GCRHarmonicRitzSpace( s, vacc, ExX, start, U);
+
+    const bool converged= resid < tol;
+    tol= resid;
+    max_iter= k_it;
+    return converged;
+}
+
+
 //*****************************************************************
 // GMRESR
 //
@@ -1615,18 +2053,19 @@ bool IDRS( const Mat& A, Vec& x, const Vec& rhs, const ExT& ex, PC& pc, int& max
                 c[j]= cs/M(k+j,k+j);
             }
             v= resid;
-            for (int j=0; j < s-k; j++) v-= c[j]*G[k+j];
+            for (int j=0; j < s-k; j++) axpy( -c[j], G[k+j], v);
             pc.Apply( A, v, v, ex);
 
             // Compute new U(:,k) and G(:,k), G(:,k) is in space G_j
-            U[k]= c[0]*U[k] + omega*v;
-            for (int j=1; j < s-k; j++) U[k]+= c[j]*U[k+j];
+            U[k]*= c[0];
+            axpy( omega, v, U[k]);
+            for (int j=1; j < s-k; j++) axpy( c[j], U[k+j], U[k]);
             G[k]= A * U[k];
             // Bi-Orthogonalize the new basis vectors
             for (int i= 0; i < k; i++) {
                 ElementTyp alpha= dot (P[i], G[k])/M(i,i);
-                G[k]-= alpha*G[i];
-                U[k]-= alpha*U[i];
+                axpy( -alpha, G[i], G[k]);
+                axpy( -alpha, U[i], U[k]);
             }
             // compute new column of M (first k-1 entries are zero)
             for (int j=0; j < s-k; j++) M(k+j,k)= dot (P[k+j], G[k]);
@@ -1637,9 +2076,8 @@ bool IDRS( const Mat& A, Vec& x, const Vec& rhs, const ExT& ex, PC& pc, int& max
 
             //    make  R orthogonal to  G
             ElementTyp beta = f[k] / M(k,k);
-            resid-= beta*G[k];
-            x+= beta*U[k];
-            normres= norm(resid);
+            normres= std::sqrt( axpy_norm_sq( -beta, G[k], resid));
+            axpy( beta, U[k], x);
             it++;
             if ( normres/normb <= tol)   break;
             if ( k+1 < s ) {
@@ -1651,15 +2089,17 @@ bool IDRS( const Mat& A, Vec& x, const Vec& rhs, const ExT& ex, PC& pc, int& max
         // Entering  G+
         pc.Apply( A, v, resid, ex);
         t= A*v;
-        double tn = norm(t), tr = dot(t, resid);
+        double tn, tr;
+        dot2( t, t, resid, tn, tr);
+        tn= std::sqrt( tn);
         omega= tr/(tn*tn);
         ElementTyp rho= std::abs(tr)/(tn*normres);
         if ( rho < omega_bound )  omega*= omega_bound/rho;
         if ( omega == 0 ) {
             throw DROPSErrCL( "IDR(s): omega ==0");
         }
-        resid-= omega*t;  x+= omega*v;
-        normres= norm(resid);
+        normres= std::sqrt( axpy_norm_sq( -omega, t, resid));
+        axpy( omega, v, x);
         it++;
     }
     if (tol > normres/normb) {
@@ -1783,6 +2223,9 @@ class SolverBaseCL
     virtual bool   GetRelError() const { return rel_; }
 
     virtual void   SetOutput( std::ostream* os) { output_=os; }
+
+    /// \brief Drop information kept from previous solves; only recycling solvers keep such information
+    virtual void   ClearRecycleSpace() {}
 };
 
 /// Bare CG solver
@@ -1838,6 +2281,36 @@ class PCGSolverCL : public SolverBaseCL
     }
 };
 
+/// Pipelined CG with preconditioner; one non-blocking global reduction per iteration, see PipelinedPCG
+template <typename PC>
+class PipelinedPCGSolverCL : public SolverBaseCL
+{
+  private:
+    PC& pc_;
+
+  public:
+    PipelinedPCGSolverCL(PC& pc, int maxiter, double tol, bool rel= false, std::ostream* output = 0)
+        : SolverBaseCL(maxiter, tol, rel, output), pc_(pc) {}
+
+    PC&       GetPc ()       { return pc_; }
+    const PC& GetPc () const { return pc_; }
+
+    template <typename Mat, typename Vec, typename ExT>
+    void Solve(const Mat& A, Vec& x, const Vec& b, const ExT& ex)
+    {
+        res_=  tol_;
+        iter_= maxiter_;
+        PipelinedPCG(A, x, b, ex, pc_, iter_, res_, rel_, output_);
+    }
+    template <typename Mat, typename Vec, typename ExT>
+    void Solve(const Mat& A, Vec& x, const Vec& b, const ExT& ex, int& numIter, double& resid) const
+    {
+        resid=   tol_;
+        numIter= maxiter_;
+        PipelinedPCG(A, x, b, ex, pc_, numIter, resid, rel_, output_);
+    }
+};
+
 ///\brief Solver for A*A^Tx=b with Craig's method and left preconditioning.
 ///
 /// A preconditioned CG version for matrices of the form A*A^T. Note that *A* must be
@@ -1979,6 +2452,38 @@ class GMResSolverCL : public SolverBaseCL
     }
 };
 
+/// GMRES with left preconditioning, whose inner products are fused into one blocking reduction per iteration, see CGS2GMRES
+template <typename PC>
+class CGS2GMResSolverCL : public SolverBaseCL
+{
+  private:
+    PC& pc_;
+    int restart_;
+
+  public:
+    CGS2GMResSolverCL( PC& pc, int restart, int maxiter, double tol, bool relative= true, std::ostream* output=0)
+        : SolverBaseCL( maxiter, tol, relative, output), pc_(pc), restart_(restart) {}
+
+    PC&       GetPc      ()       { return pc_; }
+    const PC& GetPc      () const { return pc_; }
+    int       GetRestart () const { return restart_; }
+
+    template <typename Mat, typename Vec, typename ExT>
+    void Solve(const Mat& A, Vec& x, const Vec& b, const ExT& ex)
+    {
+        res_=  tol_;
+        iter_= maxiter_;
+        CGS2GMRES(A, x, b, ex, pc_, restart_, iter_, res_, rel_, output_);
+    }
+    template <typename Mat, typename Vec, typename ExT>
+    void Solve(const Mat& A, Vec& x, const Vec& b, const ExT& ex, int& numIter, double& resid) const
+    {
+        resid=   tol_;
+        numIter= maxiter_;
+        CGS2GMRES(A, x, b, ex, pc_, restart_, numIter, resid, rel_, output_);
+    }
+};
+
 
 /// BiCGStab
 template <typename PC>
@@ -2059,6 +2564,70 @@ class GCRSolverCL : public SolverBaseCL
     }
 };
 
+/// GCR, which keeps up to recycle search directions for the next call of Solve, see RecycleGCR
+///
+/// Successive systems with the same numbering of the unknowns, e.g., the Oseen systems of a
+/// coupling iteration and of the following time steps, profit from the directions of the
+/// previous solves. The iteration counts of all solves are summed up to judge the savings.
+template <typename PC>
+class RecycleGCRSolverCL : public SolverBaseCL
+{
+  private:
+    PC& pc_;
+    int truncate_;
+    int recycle_;
+
+    mutable std::vector<VectorCL> U_;   ///< directions recycled in the next solve
+    mutable int numSolves_,
+                totalIter_;
+
+  public:
+    RecycleGCRSolverCL( PC& pc, int truncate, int recycle, int maxiter, double tol,
+        bool relative= true, std::ostream* output= 0)
+        : SolverBaseCL( maxiter, tol, relative, output), pc_( pc),
+          truncate_( truncate), recycle_( recycle), numSolves_( 0), totalIter_( 0) {}
+
+    PC&       GetPc      ()       { return pc_; }
+    const PC& GetPc      () const { return pc_; }
+    int       GetTruncate() const { return truncate_; }
+    int       GetRecycle () const { return recycle_; }
+
+    /// \brief Number of directions, which are recycled in the next solve
+    size_t GetRecycleDim () const { return U_.size(); }
+    /// \brief Drop the recycled directions, e.g., if the numbering of the unknowns has changed
+    void   ClearRecycleSpace () { U_.clear(); }
+    /// \name Statistics over all solves since the last call of ResetStatistics
+    //@{
+    int    GetNumSolves () const { return numSolves_; }
+    int    GetTotalIter () const { return totalIter_; }
+    void   ResetStatistics () { numSolves_= 0; totalIter_= 0; }
+    //@}
+
+    template <typename Mat, typename Vec, typename ExT>
+    void Solve(const Mat& A, Vec& x, const Vec& b, const ExT& ex)
+    {
+        res_=  tol_;
+        iter_= maxiter_;
+        const size_t recycled= U_.size();
+        RecycleGCR( A, x, b, ex, pc_, truncate_, U_, recycle_, iter_, res_, rel_, output_);
+        ++numSolves_;
+        totalIter_+= iter_;
+        if (output_ != 0)
+            *output_ << "RecycleGCRSolverCL: iterations: " << GetIter()
+                     << "\tresidual: " << GetResid() << "\trecycled directions: " << recycled
+                     << "\taverage iterations: " << double( totalIter_)/numSolves_ << std::endl;
+    }
+    template <typename Mat, typename Vec, typename ExT>
+    void Solve(const Mat& A, Vec& x, const Vec& b, const ExT& ex, int& numIter, double& resid) const
+    {
+        resid=   tol_;
+        numIter= maxiter_;
+        RecycleGCR( A, x, b, ex, pc_, truncate_, U_, recycle_, numIter, resid, rel_, output_);
+        ++numSolves_;
+        totalIter_+= numIter;
+    }
+};
+
 /// GMRESR
 template <typename PC>
 class GMResRSolverCL : public SolverBaseCL
@@ -58,6 +58,7 @@ class NSSolverBaseCL : public SolverBaseCL
     virtual double   GetResid ()           const { return solver_.GetResid(); }
     virtual int      GetIter  ()           const { return solver_.GetIter(); }
     StokesSolverBaseCL& GetStokesSolver () const { return solver_; }
+    virtual void     ClearRecycleSpace ()        { solver_.ClearRecycleSpace(); }
     virtual const MLMatrixCL* GetAN()            { return &NS_.A.Data; }
 
     /// solves the system   A v + BT p = b
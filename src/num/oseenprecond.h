@@ -24,6 +24,7 @@
 
 #include "num/precond.h"
 #include "num/MGsolver.h"
+#include "num/amg.h"
 #include "num/spblockmat.h"
 #include "misc/scopetimer.h"
 
@@ -91,6 +92,7 @@ class SchurPreBaseCL
 //
 // A_ is the pressure-Poisson-Matrix for natural boundary-conditions, M_ the
 // pressure-mass-matrix.
+// With SetFloat( true), the SSOR-steps use single precision copies of A_ and M_.
 //**************************************************************************
 class ISPreCL : public SchurPreBaseCL
 {
@@ -98,14 +100,19 @@ class ISPreCL : public SchurPreBaseCL
     MatrixCL& A_;
     MatrixCL& M_;
     SSORPcCL  ssor_;
+    bool      float_;
+    FloatSSORPcCL fssorA_, fssorM_;
 
   public:
     ISPreCL( MatrixCL& A_pr, MatrixCL& M_pr,
         double kA= 0., double kM= 1., double om= 1.)
-        : SchurPreBaseCL( kA, kM), A_( A_pr), M_( M_pr), ssor_( om)  {}
+        : SchurPreBaseCL( kA, kM), A_( A_pr), M_( M_pr), ssor_( om), float_( false), fssorA_( om), fssorM_( om)  {}
     ISPreCL( MLMatrixCL& A_pr, MLMatrixCL& M_pr,
              double kA= 0., double kM= 1., double om= 1.)
-    : SchurPreBaseCL( kA, kM), A_( A_pr.GetFinest()), M_( M_pr.GetFinest()), ssor_( om)  {}
+    : SchurPreBaseCL( kA, kM), A_( A_pr.GetFinest()), M_( M_pr.GetFinest()), ssor_( om), float_( false), fssorA_( om), fssorM_( om)  {}
+
+    /// \brief Use single precision copies of the matrices in the SSOR-steps
+    void SetFloat( bool f) { float_= f; }
 
     /// \brief Apply preconditioner
     template <typename Mat, typename Vec, typename ExT>
@@ -125,14 +132,20 @@ void ISPreCL::Apply(const Mat&, Vec& p, const Vec& c, const ExT&, const ExT& pr_
 {
 //    double new_res;
 //    double old_res= norm( c);
-    ssor_.Apply( A_, p, c, pr_ex);
+    if (float_)
+        fssorA_.Apply( A_, p, c, pr_ex);
+    else
+        ssor_.Apply( A_, p, c, pr_ex);
 //    std::cout << " residual: " <<  (new_res= norm( A_*p - c)) << '\t';
 //    std::cout << " reduction: " << new_res/old_res << '\t';
     p*= kA_;
 //    double mnew_res;
 //    double mold_res= norm( c);
     Vec p2_( c.size());
-    ssor_.Apply( M_, p2_, c, pr_ex);
+    if (float_)
+        fssorM_.Apply( M_, p2_, c, pr_ex);
+    else
+        ssor_.Apply( M_, p2_, c, pr_ex);
 //    std::cout << " residual: " <<  (mnew_res= norm( M_*p2_ - c)) << '\t';
 //    std::cout << " reduction: " << mnew_res/mold_res << '\n';
     p+= kM_*p2_;
@@ -447,15 +460,20 @@ class ISMGPreCL : public SchurPreBaseCL
     DROPS::Uint iter_prA_;
     DROPS::Uint iter_prM_;
     mutable std::vector<DROPS::VectorCL> ones_;
+    bool amg_;                  ///< If amg_ is true, AMG V-cycles on the finest level replace the geometric multigrid; P_ is not used.
+    mutable AMGPcCL amgA_, amgM_;
 
     void MaybeInitOnes() const;
+    /// \brief x= result of iter AMG V-cycles for A x= b with start vector 0
+    template <typename Vec, typename ExT>
+    static void AMGIterations (AMGPcCL& pc, const MatrixCL& A, Vec& x, const Vec& b, DROPS::Uint iter, const ExT& ex);
 
   public:
     ISMGPreCL(DROPS::MLMatrixCL& A_pr, DROPS::MLMatrixCL& M_pr,
                     double kA, double kM, const MLIdxDescCL& idx, DROPS::Uint iter_prA=1,
                     DROPS::Uint iter_prM = 1)
         : SchurPreBaseCL( kA, kM), sm( 1), lvl( -1), omega( 1.0), smoother( omega), solver( directpc, 200, 1e-12),
-          Apr_( A_pr), Mpr_( M_pr), idx_(idx), iter_prA_( iter_prA), iter_prM_( iter_prM), ones_(0)
+          Apr_( A_pr), Mpr_( M_pr), idx_(idx), iter_prA_( iter_prA), iter_prM_( iter_prM), ones_(0), amg_( false)
     {
         smoother.resize( idx.size(), SmootherT(omega));
     }
@@ -472,8 +490,25 @@ class ISMGPreCL : public SchurPreBaseCL
 
     using SchurPreBaseCL::Apply;
     ProlongationT* GetProlongation() { return &P_; }
+    /// \brief Use smoothed aggregation AMG instead of the geometric multigrid; no hierarchy of triangulations is needed.
+    void SetAMG (bool amg) { amg_= amg; }
 };
 
+template<class ProlongationT>
+template <typename Vec, typename ExT>
+void ISMGPreCL<ProlongationT>::AMGIterations (AMGPcCL& pc, const MatrixCL& A, Vec& x, const Vec& b, DROPS::Uint iter, const ExT& ex)
+{
+    pc.SetDiag( A, ex);
+    Vec r( b), e( b.size());
+    x= 0.;
+    for (DROPS::Uint i= 0; i < iter; ++i) {
+        pc.Apply( A, e, r, ex);
+        x+= e;
+        if (i + 1 < iter)
+            r= b - A*x;
+    }
+}
+
 template<class ProlongationT>
 void ISMGPreCL<ProlongationT>::MaybeInitOnes() const
 {
@@ -489,11 +524,19 @@ void ISMGPreCL<ProlongationT>::MaybeInitOnes() const
 
 template<class ProlongationT>
 template <typename Mat, typename Vec, typename ExT>
-void ISMGPreCL<ProlongationT>::Apply(const Mat& /*A*/, Vec& p, const Vec& c, const ExT&, const ExT&) const
+void ISMGPreCL<ProlongationT>::Apply(const Mat& /*A*/, Vec& p, const Vec& c, const ExT&, const ExT& pr_ex) const
 {
     MaybeInitOnes();
     p= 0.0;
     const Vec c2_( c - dot( ones_.back(), c));
+    if (amg_) {
+        AMGIterations( amgA_, Apr_.GetFinest(), p, c2_, iter_prA_, pr_ex);
+        p*= kA_;
+        Vec p2( p.size());
+        AMGIterations( amgM_, Mpr_.GetFinest(), p2, c, iter_prM_, pr_ex);
+        p+= kM_*p2;
+        return;
+    }
     typename ProlongationT::const_iterator finestP = --P_.end();
     MLIdxDescCL::const_iterator finestIdx = idx_.GetFinestIter();
     MLSmootherCL<SmootherT>::const_iterator smootherit = smoother.GetFinestIter();
@@ -562,6 +605,11 @@ class ISBBTPreCL : public SchurPreBaseCL
     mutable PCGNESolverCL<PCSolver1T> solver_;                  ///< solver for BB^T
     mutable PCGSolverCL<PCSolver2T> solver2_;                   ///< solver for M
 
+    bool amg_;                                                  ///< If amg_ is true, BB^T is assembled and solved by PCG with AMGPcCL instead of solver_.
+    mutable MatrixCL BBT_;                                      ///< Bs*Bs^T, if amg_ is true
+    mutable AMGPcCL amgpc_;
+    mutable PCGSolverCL<AMGPcCL> amgsolver_;                    ///< solver for BB^T, if amg_ is true
+
     const IdxDescCL* pr_idx_;                                   ///< used to determine, how to represent the kernel of BB^T in case of pure Dirichlet-BCs.
     double regularize_;                                         ///< If regularize_==0. no regularization is performed. Otherwise, a column is attached to Bs.
     template <typename ExT>
@@ -575,6 +623,7 @@ class ISBBTPreCL : public SchurPreBaseCL
           PCsolver1_(), PCsolver2_(),
           solver_( PCsolver1_, 800, tolA_, /*relative*/ true),
           solver2_( PCsolver2_, 500, tolM_, /*relative*/ true),
+          amg_( false), amgsolver_( amgpc_, 800, tolA_, /*relative*/ true),
           pr_idx_( &pr_idx), regularize_( regularize) {}
     ISBBTPreCL (const ISBBTPreCL& pc)
         : SchurPreBaseCL( pc.kA_, pc.kM_), B_( pc.B_), Bs_( pc.Bs_ == 0 ? 0 : new MatrixCL( *pc.Bs_)),
@@ -585,6 +634,7 @@ class ISBBTPreCL : public SchurPreBaseCL
           PCsolver1_(), PCsolver2_(),
           solver_( PCsolver1_, 800, tolA_, /*relative*/ true),
           solver2_( PCsolver2_, 500, tolM_, /*relative*/ true),
+          amg_( pc.amg_), BBT_( pc.BBT_), amgsolver_( amgpc_, 800, tolA_, /*relative*/ true),
           pr_idx_( pc.pr_idx_), regularize_( pc.regularize_){}
 
     ISBBTPreCL& operator= (const ISBBTPreCL&) {
@@ -613,6 +663,8 @@ class ISBBTPreCL : public SchurPreBaseCL
         pr_idx_= pr_idx;
         Bversion_ = 0;
     }
+    /// \brief Solve BB^T by PCG with smoothed aggregation AMG instead of PCGNE; BB^T is assembled explicitly.
+    void SetAMG (bool amg) { amg_= amg; Bversion_= 0; }
 };
 
 template<typename ExT>
@@ -636,6 +688,12 @@ void ISBBTPreCL::Update(const ExT& vel_ex, const ExT& p_ex) const
     if (regularize_ != 0.)
         Regularize( *Bs_, *pr_idx_, Dprsqrt, PCsolver1_, regularize_, vel_ex, p_ex);
 #endif
+    if (amg_) {
+        MatrixCL BsT;
+        transpose( *Bs_, BsT);
+        // If the pattern of B is unchanged, so is the pattern of BB^T and amgpc_ only updates the values of its hierarchy.
+        mat_mul( *Bs_, BsT, BBT_);
+    }
 }
 
 template <typename Mat, typename Vec, typename ExT>
@@ -647,14 +705,18 @@ void ISBBTPreCL::Apply(const Mat&, Vec& p, const Vec& c, const ExT& vel_ex, cons
 
     p= 0.0;
     if (kA_ != 0.0) {
-        solver_.Solve( *Bs_, p, VectorCL( Dprsqrtinv_*c), vel_ex, p_ex);
-        if (solver_.GetIter() == solver_.GetMaxIter()){
-            std::cout << "ISBBTPreCL::Apply: BBT-solve: " << solver_.GetIter()
-                    << " (max)\t" << solver_.GetResid() << '\n';
+        SolverBaseCL* solver= amg_ ? static_cast<SolverBaseCL*>( &amgsolver_) : static_cast<SolverBaseCL*>( &solver_);
+        if (amg_)
+            amgsolver_.Solve( BBT_, p, VectorCL( Dprsqrtinv_*c), p_ex);
+        else
+            solver_.Solve( *Bs_, p, VectorCL( Dprsqrtinv_*c), vel_ex, p_ex);
+        if (solver->GetIter() == solver->GetMaxIter()){
+            std::cout << "ISBBTPreCL::Apply: BBT-solve: " << solver->GetIter()
+                    << " (max)\t" << solver->GetResid() << '\n';
         }
         else if (output_)
-            *output_ << "ISBBTPreCL BBT-solve: iterations: " << solver_.GetIter()
-                     << "\tresidual: " <<  solver_.GetResid();
+            *output_ << "ISBBTPreCL BBT-solve: iterations: " << solver->GetIter()
+                     << "\tresidual: " <<  solver->GetResid();
         p= kA_*(Dprsqrtinv_*p);
     }
     if (kM_ != 0.0) {
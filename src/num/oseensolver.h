@@ -203,6 +203,7 @@ class BlockMatrixSolverCL: public StokesSolverBaseCL
     double GetResid   () const { return solver_.GetResid(); }
     int    GetIter    () const { return solver_.GetIter(); }
     bool   GetRelError() const { return solver_.GetRelError(); }
+    void   ClearRecycleSpace()     { solver_.ClearRecycleSpace(); }
 #ifdef _PAR
     template <typename Mat, typename Vec>
     void
@@ -199,7 +199,16 @@ PoissonSolverFactoryCL<ProlongationT>::
         PCGSolverJAC_( JACPc_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr")),
         PCGSolverSSOR_( SSORPc_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr")),
         PCGSolverChebychev_( ChebyPc_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"))
-        {}
+{
+    // Reuse the multigrid setup over several solves, cf. MGSolverCL::SetReuse.
+    const double mgreuse= P.get<double>("Poisson.MGReuse", 0.);
+    MGSolversymmJOR_.SetReuse( mgreuse);
+    MGSolversymmGS_.SetReuse( mgreuse);
+    MGSolversymmSGS_.SetReuse( mgreuse);
+    MGSolversymmSOR_.SetReuse( mgreuse);
+    MGSolversymmSSOR_.SetReuse( mgreuse);
+    MGSolversymmChebychev_.SetReuse( mgreuse);
+}
 
 template <class ProlongationT>
 PoissonSolverBaseCL* PoissonSolverFactoryCL<ProlongationT>::CreatePoissonSolver()
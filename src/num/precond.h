@@ -98,19 +98,24 @@ enum PreMethGS
     P_SSOR0_D, //  9 P_SSOR0 using SparseMatDiagCL
     P_DUMMY,   // 10 identity
     P_GS0,     // 11 Gauss-Seidel with initial vector 0
-    P_JAC0     // 12 Jacobi with initial vector 0
+    P_JAC0,    // 12 Jacobi with initial vector 0
+    P_MCSOR,   // 13 P_SOR in multicolor ordering, threaded
+    P_MCSSOR,  // 14 P_SSOR in multicolor ordering, threaded
+    P_MCSSOR0  // 15 P_SSOR0 in multicolor ordering, threaded
 };
 
 // Base methods
-enum PreBaseGS { PB_JAC, PB_GS, PB_SGS, PB_SGS0, PB_DUMMY, PB_GS0, PB_JAC0 };
+enum PreBaseGS { PB_JAC, PB_GS, PB_SGS, PB_SGS0, PB_DUMMY, PB_GS0, PB_JAC0, PB_MCGS, PB_MCSGS, PB_MCSGS0 };
 
 // Properties of the methods
 template <PreMethGS PM> struct PreTraitsCL
 {
     static const PreBaseGS BaseMeth= PreBaseGS(PM<8 ? PM%4
-                                     : (PM==10 ? PB_DUMMY : (PM==11 ? PB_GS0 : (PM==12 ? PB_JAC0 : PB_SGS0))) );
-    static const bool      HasOmega= (PM>=4 && PM<8) || PM==9 || PM==11 || PM==12;
+                                     : (PM==10 ? PB_DUMMY : (PM==11 ? PB_GS0 : (PM==12 ? PB_JAC0
+                                     : (PM>=13 ? PM-13+PB_MCGS : PB_SGS0)))) );
+    static const bool      HasOmega= (PM>=4 && PM<8) || PM==9 || PM>=11;
     static const bool      HasDiag=  PM==8 || PM==9;
+    static const bool      MultiColor= PM>=13;
 };
 
 // Used to make a distinct type from each method
@@ -122,9 +127,9 @@ template <PreBaseGS> class PreDummyCL {};
 //=============================================================================
 
 // One step of the Jacobi method with start vector x
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_JAC>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_JAC>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     Vec          y(x.size());
@@ -150,9 +155,9 @@ SolveGSstep(const PreDummyCL<PB_JAC>&, const MatrixCL& A, Vec& x, const Vec& b,
 }
 
 // One step of the Jacobi method with start vector 0
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_JAC0>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_JAC0>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     size_t nz;
@@ -169,9 +174,9 @@ SolveGSstep(const PreDummyCL<PB_JAC0>&, const MatrixCL& A, Vec& x, const Vec& b,
 }
 
 // One step of the Gauss-Seidel/SOR method with start vector x
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_GS>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_GS>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     double aii, sum;
@@ -192,9 +197,9 @@ SolveGSstep(const PreDummyCL<PB_GS>&, const MatrixCL& A, Vec& x, const Vec& b, d
 }
 
 // One step of the Gauss-Seidel/SOR method with start vector x
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_GS0>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_GS0>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     double aii, sum;
@@ -242,9 +247,9 @@ SolveGSDiag0step(const PreDummyCL<PB_GS0>&, const MatrixCL& A, Vec& x, const Vec
 
 
 // One step of the Symmetric-Gauss-Seidel/SSOR method with start vector x
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_SGS>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_SGS>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
     double aii, sum;
@@ -283,9 +288,9 @@ SolveGSstep(const PreDummyCL<PB_SGS>&, const MatrixCL& A, Vec& x, const Vec& b,
 
 
 // One step of the Symmetric-Gauss-Seidel/SSOR method with start vector 0
-template <bool HasOmega, typename Vec>
+template <bool HasOmega, typename Vec, typename T>
 void
-SolveGSstep(const PreDummyCL<PB_SGS0>&, const MatrixCL& A, Vec& x, const Vec& b, double omega)
+SolveGSstep(const PreDummyCL<PB_SGS0>&, const SparseMatBaseCL<T>& A, Vec& x, const Vec& b, double omega)
 {
     const size_t n= A.num_rows();
 
@@ -316,6 +321,68 @@ SolveGSstep(const PreDummyCL<PB_SGS0>&, const MatrixCL& A, Vec& x, const Vec& b,
 }
 
 
+// One sweep over the colors of the multicolor Gauss-Seidel/SOR method, forward or backward;
+// the rows of each color are updated in parallel.
+template <bool HasOmega, typename Vec>
+void
+MultiColorGSsweep(const MatrixCL& A, Vec& x, const Vec& b, const SparseMatColoringCL& col, bool forward, double omega)
+{
+#ifndef DROPS_WIN
+    size_t r;
+#else
+    int r;
+#endif
+
+#   pragma omp parallel private(r)
+    for (size_t k= 0; k < col.num_colors(); ++k) {
+        const size_t  c= forward ? k : col.num_colors() - 1 - k;
+        const size_t* rows= col.color_begin( c);
+        const size_t  n= col.color_end( c) - rows;
+#       pragma omp for
+        for (r= 0; r < n; ++r) {
+            const size_t i= rows[r];
+            double aii= 0, sum= b[i];
+            for (size_t nz= A.row_beg( i), end= A.row_beg( i+1); nz<end; ++nz)
+                if (A.col_ind( nz) != i)
+                    sum-= A.val( nz)*x[A.col_ind( nz)];
+                else
+                    aii= A.val( nz);
+            if (HasOmega)
+                x[i]= (1.-omega)*x[i]+omega*sum/aii;
+            else
+                x[i]= sum/aii;
+        }
+    }
+}
+
+// One step of the multicolor Gauss-Seidel/SOR method with start vector x
+template <bool HasOmega, typename Vec>
+void
+SolveGSstep(const PreDummyCL<PB_MCGS>&, const MatrixCL& A, Vec& x, const Vec& b, const SparseMatColoringCL& col, double omega)
+{
+    MultiColorGSsweep<HasOmega>( A, x, b, col, true, omega);
+}
+
+// One step of the multicolor Symmetric-Gauss-Seidel/SSOR method with start vector x
+template <bool HasOmega, typename Vec>
+void
+SolveGSstep(const PreDummyCL<PB_MCSGS>&, const MatrixCL& A, Vec& x, const Vec& b, const SparseMatColoringCL& col, double omega)
+{
+    MultiColorGSsweep<HasOmega>( A, x, b, col, true, omega);
+    MultiColorGSsweep<HasOmega>( A, x, b, col, false, omega);
+}
+
+// One step of the multicolor Symmetric-Gauss-Seidel/SSOR method with start vector 0;
+// in contrast to PB_SGS0, the forward sweep uses the full rows, which yields the same result for x == 0.
+template <bool HasOmega, typename Vec>
+void
+SolveGSstep(const PreDummyCL<PB_MCSGS0>&, const MatrixCL& A, Vec& x, const Vec& b, const SparseMatColoringCL& col, double omega)
+{
+    x= 0.;
+    SolveGSstep<HasOmega, Vec>( PreDummyCL<PB_MCSGS>(), A, x, b, col, omega);
+}
+
+
 // One step of the Symmetric-Gauss-Seidel/SSOR method with start vector 0,
 // uses SparseMatDiagCL for the location of the diagonal
 template <bool HasOmega, typename Vec>
@@ -396,12 +463,12 @@ SolveGSstep(const PreDummyCL<PBT>& pd, const MLMatrixCL& A, Vec& x, const Vec& b
 // TODO: Init ueberdenken.
 
 // Preconditioners without own matrix
-template <PreMethGS PM, bool HasDiag= PreTraitsCL<PM>::HasDiag> class PreGSCL;
+template <PreMethGS PM, bool HasDiag= PreTraitsCL<PM>::HasDiag, bool MultiColor= PreTraitsCL<PM>::MultiColor> class PreGSCL;
 template <PreMethGS PM, bool HasDiag= PreTraitsCL<PM>::HasDiag> class PreGSDiag0CL;
 
 // Simple preconditioners
 template <PreMethGS PM>
-class PreGSCL<PM,false>
+class PreGSCL<PM,false,false>
 {
   private:
     double _omega;
@@ -429,7 +496,7 @@ class PreGSCL<PM,false>
 
 // Preconditioner with SparseMatDiagCL
 template <PreMethGS PM>
-class PreGSCL<PM,true>
+class PreGSCL<PM,true,false>
 {
   private:
     const SparseMatDiagCL* _diag;
@@ -467,6 +534,55 @@ class PreGSCL<PM,true>
     //@}
 };
 
+// Multicolor preconditioners; the rows of each color are updated in parallel.
+// The coloring is recomputed, if the sparsity pattern of the matrix changes.
+template <PreMethGS PM>
+class PreGSCL<PM,false,true>
+{
+  private:
+    mutable SparseMatColoringCL coloring_;
+    mutable const void*         Aaddr_;    ///< only used to validate, that the coloring is for the correct matrix.
+    mutable size_t              Aversion_;
+    double                      _omega;
+
+    void Update(const MatrixCL& A) const
+    {
+        if (&A == Aaddr_ && A.Version() == Aversion_)
+            return;
+        if (!coloring_.SamePattern( A))
+            coloring_.assign( A);
+        Aaddr_= &A;
+        Aversion_= A.Version();
+    }
+
+  public:
+    PreGSCL (double om= 1.0) : Aaddr_( 0), Aversion_( 0), _omega( om) {}
+
+    template <typename Vec, typename ExT>
+    void Apply(const MatrixCL& A, Vec& x, const Vec& b, const ExT&) const
+    {
+        Update( A);
+        SolveGSstep<PreTraitsCL<PM>::HasOmega,Vec>(PreDummyCL<PreTraitsCL<PM>::BaseMeth>(), A, x, b, coloring_, _omega);
+    }
+    template <typename Vec, typename ExT>
+    void Apply(const MLMatrixCL& A, Vec& x, const Vec& b, const ExT& ex) const
+    {
+        Apply( A.GetFinest(), x, b, ex);
+    }
+    /// \brief The coloring of the matrix of the last call of Apply
+    const SparseMatColoringCL& GetColoring() const { return coloring_; }
+    /// \brief Check if return preconditioned vectors are accumulated after calling Apply
+    bool RetAcc()   const { return false; }
+    /// \brief Check if the diagonal of the matrix is needed
+    bool NeedDiag() const { return false; }
+    /// \name Set diagonal of the matrix for consistency
+    //@{
+    void SetDiag(const VectorCL&) {}         // just for consistency
+    template<typename Mat, typename ExT>
+    void SetDiag(const Mat&, const ExT&) {}  // just for consistency
+    //@}
+};
+
 template <PreMethGS PM>
 class PreGSDiag0CL<PM,false>
 {
@@ -878,6 +994,62 @@ typedef PreGSCL<P_SSOR0>   SSORPcCL;
 typedef PreGSCL<P_SSOR0_D> SSORDiagPcCL;
 typedef PreGSCL<P_GS0>     GSPcCL;
 typedef PreGSDiag0CL<P_GS0>	GSDiag0PcCL;
+// Set DROPS_MULTICOLOR_SMOOTHERS to 1 to use the multicolor variants in the Stokes solver factory.
+typedef PreGSCL<P_MCSOR>    MCSORsmoothCL;
+typedef PreGSCL<P_MCSSOR>   MCSSORsmoothCL;
+typedef PreGSCL<P_MCSSOR0>  MCSSORPcCL;
+
+// Mixed precision: the sweeps of the Gauss-Seidel type preconditioners read the values of a
+// single precision copy of the matrix; the vectors and all sums stay in double precision.
+template <class PcT>
+class FloatPcCL
+{
+  private:
+    PcT                            pc_;
+    mutable SparseMatBaseCL<float> Af_;
+    mutable const void*            Aaddr_;    ///< matrix, whose copy is stored in Af_
+    mutable size_t                 Aversion_;
+
+    void Update(const MatrixCL& A) const
+    {
+        if (&A == Aaddr_ && A.Version() == Aversion_)
+            return;
+        convert( A, Af_);
+        Aaddr_= &A;
+        Aversion_= A.Version();
+    }
+
+  public:
+    FloatPcCL (double om= 1.0) : pc_( om), Aaddr_( 0), Aversion_( 0) {}
+
+    template <typename Vec, typename ExT>
+    void Apply(const MatrixCL& A, Vec& x, const Vec& b, const ExT& ex) const
+    {
+        Update( A);
+        pc_.Apply( Af_, x, b, ex);
+    }
+    template <typename Vec, typename ExT>
+    void Apply(const MLMatrixCL& A, Vec& x, const Vec& b, const ExT& ex) const
+    {
+        Apply( A.GetFinest(), x, b, ex);
+    }
+    /// \brief The single precision copy of the matrix of the last call of Apply
+    const SparseMatBaseCL<float>& GetFloatMatrix() const { return Af_; }
+    /// \brief Check if return preconditioned vectors are accumulated after calling Apply
+    bool RetAcc()   const { return pc_.RetAcc(); }
+    /// \brief Check if the diagonal of the matrix is needed
+    bool NeedDiag() const { return false; }
+    /// \name Set diagonal of the matrix for consistency
+    //@{
+    void SetDiag(const VectorCL&) {}         // just for consistency
+    template<typename Mat, typename ExT>
+    void SetDiag(const Mat&, const ExT&) {}  // just for consistency
+    //@}
+};
+
+typedef FloatPcCL<SSORsmoothCL> FloatSSORsmoothCL;
+typedef FloatPcCL<SGSsmoothCL>  FloatSGSsmoothCL;
+typedef FloatPcCL<SSORPcCL>     FloatSSORPcCL;
 
 /// fwd decl from num/stokessolver.h
 template<typename, typename, typename>
@@ -1228,6 +1400,16 @@ class ParJacNEG0CL : public JACPcCL
 
 #endif
 
+/// \brief Set the version check of preconditioners derived from PreBaseCL; the other preconditioners store no matrix version.
+inline void SetCheckMatVersion (PreBaseCL* pc, bool check)
+{
+    if (check)
+        pc->CheckMatVersion();
+    else
+        pc->DoNotCheckMatVersion();
+}
+inline void SetCheckMatVersion (const void*, bool) {}
+
 // ********************************************************************************
 ///\brief Multilevel Smoother
 // ********************************************************************************
@@ -1237,8 +1419,9 @@ class MLSmootherCL : public MLDataCL<SmootherT> {
   private:
     typedef MLDataCL<SmootherT> base_;
     double omega_;
+    bool   check_mat_version_;
   public:
-    MLSmootherCL( const double omega = 1.0) : omega_(omega) {}
+    MLSmootherCL( const double omega = 1.0) : omega_(omega), check_mat_version_( true) {}
 
     template<class Mat>
     void SetDiag( const MLDataCL<Mat>& A, const MLIdxDescCL& idx) {
@@ -1246,10 +1429,19 @@ class MLSmootherCL : public MLDataCL<SmootherT> {
         this->resize(A.size(), SmootherT(omega_));
         typename MLDataCL<Mat>::const_iterator Ait = A.begin();
         MLIdxDescCL::const_iterator ExIt = idx.begin();
-        for ( typename MLSmootherCL::iterator Sit = this->begin(); Sit != this->end(); ++Sit, ++Ait, ++ExIt)
+        for ( typename MLSmootherCL::iterator Sit = this->begin(); Sit != this->end(); ++Sit, ++Ait, ++ExIt) {
+            SetCheckMatVersion( &*Sit, check_mat_version_);
             Sit->SetDiag(*Ait, ExIt->GetEx());
+        }
     }
     bool NeedDiag() const { return false;}
+    /// \brief Switch the version check of the smoothers on or off; it must be off, if the smoothers are used for modified matrices without calling SetDiag.
+    /// The setting also applies to the smoothers created by later calls of SetDiag.
+    void CheckMatVersion( bool check) {
+        check_mat_version_= check;
+        for ( typename MLSmootherCL::iterator Sit = this->begin(); Sit != this->end(); ++Sit)
+            SetCheckMatVersion( &*Sit, check);
+    }
 };
 
 //***************************************************************************
@@ -0,0 +1,444 @@
+/// \file sparsedirect.cpp
+/// \brief sparse direct solvers (LU and LDL^T) without external libraries, e.g. for coarse grids
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/sparsedirect.h"
+#include "num/renumber.h"
+#include <algorithm>
+#include <cmath>
+
+namespace DROPS
+{
+
+//=============================================================================
+//  nested dissection
+//=============================================================================
+
+namespace {
+
+/// \brief Recursive bisection of the graph (gbeg, gadj) for nested_dissection
+class DissectionCL
+{
+  private:
+    const std::vector<size_t>& gbeg_;
+    const std::vector<size_t>& gadj_;
+    const size_t               leafsize_;
+    std::vector<size_t>        part_,  ///< id of the subgraph, which contains the vertex
+                               level_; ///< level of the vertex in the last breadth first search
+    size_t                     id_;    ///< last id of a subgraph
+    std::vector<size_t>        queue_;
+
+    /// breadth first search in the subgraph id from v; the vertices are in queue_ ordered by levels; returns the number of levels
+    size_t BFS (size_t v, size_t id, const std::vector<size_t>& V) {
+        for (size_t i= 0; i < V.size(); ++i)
+            level_[V[i]]= NoIdx;
+        queue_.clear();
+        queue_.push_back( v);
+        level_[v]= 0;
+        for (size_t q= 0; q < queue_.size(); ++q) {
+            const size_t w= queue_[q];
+            for (size_t e= gbeg_[w]; e < gbeg_[w + 1]; ++e) {
+                const size_t u= gadj_[e];
+                if (part_[u] == id && level_[u] == NoIdx) {
+                    level_[u]= level_[w] + 1;
+                    queue_.push_back( u);
+                }
+            }
+        }
+        return level_[queue_.back()] + 1;
+    }
+
+    size_t Degree (size_t v) const { return gbeg_[v + 1] - gbeg_[v]; }
+
+  public:
+    std::vector<size_t> order; ///< the vertices in the new order
+
+    DissectionCL (const std::vector<size_t>& gbeg, const std::vector<size_t>& gadj, size_t leafsize)
+        : gbeg_( gbeg), gadj_( gadj), leafsize_( std::max( leafsize, size_t( 1))),
+          part_( gbeg.size() - 1, NoIdx), level_( gbeg.size() - 1, NoIdx), id_( 0) { order.reserve( gbeg.size() - 1); }
+
+    /// appends the vertices in V to order, the separators after the parts they separate
+    void Dissect (std::vector<size_t> V) {
+        while (true) {
+            if (V.size() <= leafsize_) {
+                order.insert( order.end(), V.begin(), V.end());
+                return;
+            }
+            const size_t id= ++id_;
+            for (size_t i= 0; i < V.size(); ++i)
+                part_[V[i]]= id;
+
+            // Pseudo-peripheral vertex: restart from a vertex of minimal degree in the last level, until the number of levels does not grow.
+            size_t v= V[0],
+                   numlevels= BFS( v, id, V);
+            for (int iter= 0; iter < 5; ++iter) {
+                size_t w= queue_.back();
+                for (size_t q= queue_.size(); q > 0 && level_[queue_[q - 1]] + 1 == numlevels; --q)
+                    if (Degree( queue_[q - 1]) < Degree( w))
+                        w= queue_[q - 1];
+                const size_t nl= BFS( w, id, V);
+                if (nl <= numlevels) {
+                    if (nl < numlevels)
+                        BFS( v, id, V);
+                    break;
+                }
+                v= w;
+                numlevels= nl;
+            }
+
+            std::vector<size_t> P1, P2, S;
+            if (queue_.size() < V.size()) { // The component of v is ordered independently of the rest.
+                P1= queue_;
+                for (size_t i= 0; i < V.size(); ++i)
+                    if (level_[V[i]] == NoIdx)
+                        P2.push_back( V[i]);
+                Dissect( P1);
+                V.swap( P2);
+                continue;
+            }
+            if (numlevels < 3) { // nearly complete graph
+                order.insert( order.end(), V.begin(), V.end());
+                return;
+            }
+
+            // The separator is the first level, up to which at least half of the vertices are numbered.
+            size_t m= 0;
+            for (size_t q= 0; q < queue_.size() && 2*(q + 1) < queue_.size(); ++q)
+                m= level_[queue_[q + 1]];
+            m= std::min( std::max( m, size_t( 1)), numlevels - 2);
+            for (size_t q= 0; q < queue_.size(); ++q) {
+                const size_t w= queue_[q];
+                if (level_[w] < m)
+                    P1.push_back( w);
+                else if (level_[w] > m)
+                    P2.push_back( w);
+                else {
+                    bool sep= false;
+                    for (size_t e= gbeg_[w]; e < gbeg_[w + 1] && !sep; ++e)
+                        sep= part_[gadj_[e]] == id && level_[gadj_[e]] == m + 1;
+                    (sep ? S : P1).push_back( w);
+                }
+            }
+            Dissect( P1);
+            Dissect( P2);
+            order.insert( order.end(), S.begin(), S.end());
+            return;
+        }
+    }
+};
+
+} // end of anonymous namespace
+
+void nested_dissection (const MatrixCL& A, PermutationT& p, size_t leafsize)
+{
+    if (A.num_rows() != A.num_cols())
+        throw DROPSErrCL( "nested_dissection: Matrix is not square.\n");
+    const size_t n= A.num_rows();
+
+    // graph of A + A^T without loops
+    std::vector<size_t> gbeg( n + 1, 0);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t e= A.row_beg( i); e < A.row_beg( i + 1); ++e)
+            if (A.col_ind( e) != i) {
+                ++gbeg[i + 1];
+                ++gbeg[A.col_ind( e) + 1];
+            }
+    for (size_t i= 0; i < n; ++i)
+        gbeg[i + 1]+= gbeg[i];
+    std::vector<size_t> gadj( gbeg[n]), pos( gbeg.begin(), gbeg.end() - 1);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t e= A.row_beg( i); e < A.row_beg( i + 1); ++e)
+            if (A.col_ind( e) != i) {
+                gadj[pos[i]++]= A.col_ind( e);
+                gadj[pos[A.col_ind( e)]++]= i;
+            }
+    // remove duplicate edges
+    size_t nz= 0;
+    for (size_t i= 0; i < n; ++i) {
+        const size_t b= gbeg[i];
+        std::sort( gadj.begin() + b, gadj.begin() + gbeg[i + 1]);
+        gbeg[i]= nz;
+        for (size_t e= b; e < gbeg[i + 1]; ++e)
+            if (e == b || gadj[e] != gadj[e - 1])
+                gadj[nz++]= gadj[e];
+    }
+    gbeg[n]= nz;
+    gadj.resize( nz);
+
+    DissectionCL nd( gbeg, gadj, leafsize);
+    std::vector<size_t> V( n);
+    for (size_t i= 0; i < n; ++i)
+        V[i]= i;
+    nd.Dissect( V);
+
+    p.resize( n);
+    for (size_t i= 0; i < n; ++i)
+        p[nd.order[i]]= i;
+}
+
+//=============================================================================
+//  SparseDirectSolverBaseCL
+//=============================================================================
+
+size_t SparseDirectSolverBaseCL::Analyse (const MatrixCL& A, const PermutationT& p)
+{
+    const size_t n= A.num_rows();
+    const size_t* rb= A.raw_row();
+    const size_t* ci= A.raw_col();
+
+    // Collect the entries of the reordered matrix for each new row k: a_kj with j <= k in Arow_, a_jk with j < k in Acol_.
+    Abeg_.assign( n + 1, 0);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t e= rb[i]; e < rb[i + 1]; ++e)
+            if (!symm_ || ci[e] <= i)
+                ++Abeg_[std::max( p[i], p[ci[e]]) + 1];
+    for (size_t k= 0; k < n; ++k)
+        Abeg_[k + 1]+= Abeg_[k];
+    Aj_.resize( Abeg_[n]);
+    Arow_.assign( Abeg_[n], NoIdx);
+    Acol_.assign( Abeg_[n], NoIdx);
+    std::vector<size_t> pos( Abeg_.begin(), Abeg_.end() - 1);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t e= rb[i]; e < rb[i + 1]; ++e) {
+            if (symm_ && ci[e] > i)
+                continue;
+            const size_t r= p[i], c= p[ci[e]];
+            if (c <= r) {
+                Aj_[pos[r]]= c;
+                Arow_[pos[r]++]= e;
+            }
+            else {
+                Aj_[pos[c]]= r;
+                Acol_[pos[c]++]= e;
+            }
+        }
+    // Merge a_kj and a_jk into one entry.
+    std::vector<size_t> last( n, NoIdx);
+    size_t nz= 0;
+    for (size_t k= 0; k < n; ++k) {
+        const size_t b= Abeg_[k];
+        Abeg_[k]= nz;
+        for (size_t e= b; e < Abeg_[k + 1]; ++e) {
+            const size_t j= Aj_[e];
+            if (last[j] != NoIdx && last[j] >= Abeg_[k]) {
+                if (Arow_[e] != NoIdx) Arow_[last[j]]= Arow_[e];
+                if (Acol_[e] != NoIdx) Acol_[last[j]]= Acol_[e];
+                continue;
+            }
+            last[j]= nz;
+            Aj_[nz]= j; Arow_[nz]= Arow_[e]; Acol_[nz]= Acol_[e];
+            ++nz;
+        }
+    }
+    Abeg_[n]= nz;
+    Aj_.resize( nz); Arow_.resize( nz); Acol_.resize( nz);
+
+    // elimination tree with path compression
+    parent_.assign( n, NoIdx);
+    std::vector<size_t> ancestor( n, NoIdx);
+    for (size_t k= 0; k < n; ++k)
+        for (size_t e= Abeg_[k]; e < Abeg_[k + 1]; ++e)
+            for (size_t i= Aj_[e]; i != NoIdx && i < k; ) {
+                const size_t next= ancestor[i];
+                ancestor[i]= k;
+                if (next == NoIdx)
+                    parent_[i]= k;
+                i= next;
+            }
+
+    // column counts of L
+    std::vector<size_t> s( n), flag( n, NoIdx);
+    Lbeg_.assign( n + 1, 0);
+    for (size_t k= 0; k < n; ++k)
+        for (size_t t= EReach( k, s, flag); t < n; ++t)
+            ++Lbeg_[s[t] + 1];
+    for (size_t k= 0; k < n; ++k)
+        Lbeg_[k + 1]+= Lbeg_[k];
+    return Lbeg_[n];
+}
+
+size_t SparseDirectSolverBaseCL::EReach (size_t k, std::vector<size_t>& s, std::vector<size_t>& flag) const
+{
+    const size_t n= parent_.size();
+    size_t top= n;
+    flag[k]= k;
+    for (size_t e= Abeg_[k]; e < Abeg_[k + 1]; ++e) {
+        size_t len= 0;
+        for (size_t i= Aj_[e]; flag[i] != k; i= parent_[i]) {
+            s[len++]= i;
+            flag[i]= k;
+        }
+        while (len > 0)
+            s[--top]= s[--len];
+    }
+    return top;
+}
+
+void SparseDirectSolverBaseCL::Symbolic (const MatrixCL& A)
+{
+    const size_t n= A.num_rows();
+    switch (ordering_) {
+      case NaturalOrdering:
+        p_.resize( n);
+        for (size_t i= 0; i < n; ++i)
+            p_[i]= i;
+        break;
+      case RCMOrdering:
+        reverse_cuthill_mckee( A, p_, false);
+        break;
+      case NestedDissectionOrdering: {
+        PermutationT prcm;
+        reverse_cuthill_mckee( A, prcm, false);
+        const size_t nzrcm= Analyse( A, prcm);
+        nested_dissection( A, p_);
+        if (Analyse( A, p_) > nzrcm)
+            p_.swap( prcm);
+        break;
+      }
+      default:
+        throw DROPSErrCL( "SparseDirectSolverBaseCL::Symbolic: Unknown ordering.\n");
+    }
+    const size_t nzL= Analyse( A, p_);
+    Lind_.resize( nzL);
+    L_.resize( nzL);
+    U_.resize( symm_ ? 0 : nzL);
+    D_.resize( n);
+    rowbeg_.assign( A.raw_row(), A.raw_row() + n + 1);
+    colind_.assign( A.raw_col(), A.raw_col() + A.num_nonzeros());
+    ++num_symbolic_;
+}
+
+void SparseDirectSolverBaseCL::Numeric (const MatrixCL& A)
+{
+    const size_t n= A.num_rows();
+    const double* val= A.raw_val();
+    double amax= 0.;
+    for (size_t e= 0; e < A.num_nonzeros(); ++e)
+        amax= std::max( amax, std::fabs( val[e]));
+    const double minpiv= amax > 0. ? pivtol_*amax : 1.;
+
+    std::vector<double> x( n, 0.), y( symm_ ? 0 : n, 0.);
+    std::vector<size_t> s( n), flag( n, NoIdx), next( Lbeg_.begin(), Lbeg_.end() - 1);
+    num_perturbed_= 0;
+    for (size_t k= 0; k < n; ++k) {
+        // x: column k of U, y: row k of L (scaled by the diagonal of U)
+        double d= 0.;
+        for (size_t e= Abeg_[k]; e < Abeg_[k + 1]; ++e) {
+            const size_t j= Aj_[e];
+            const double akj= Arow_[e] != NoIdx ? val[Arow_[e]] : 0.,
+                         ajk= Acol_[e] != NoIdx ? val[Acol_[e]] : 0.;
+            if (j == k)
+                d= akj;
+            else if (symm_)
+                x[j]= Arow_[e] != NoIdx ? akj : ajk;
+            else {
+                x[j]= ajk;
+                y[j]= akj;
+            }
+        }
+        for (size_t t= EReach( k, s, flag); t < n; ++t) {
+            const size_t i= s[t];
+            const double u= x[i],
+                         l= (symm_ ? u : y[i])/D_[i];
+            x[i]= 0.;
+            if (symm_)
+                for (size_t e= Lbeg_[i]; e < next[i]; ++e)
+                    x[Lind_[e]]-= L_[e]*u;
+            else {
+                y[i]= 0.;
+                for (size_t e= Lbeg_[i]; e < next[i]; ++e) {
+                    x[Lind_[e]]-= L_[e]*u;
+                    y[Lind_[e]]-= U_[e]*l;
+                }
+            }
+            d-= l*u;
+            const size_t e= next[i]++;
+            Lind_[e]= k;
+            L_[e]= l;
+            if (!symm_)
+                U_[e]= u;
+        }
+        if (std::fabs( d) < minpiv) {
+            d= d < 0. ? -minpiv : minpiv;
+            ++num_perturbed_;
+        }
+        D_[k]= d;
+    }
+    ++num_numeric_;
+}
+
+void SparseDirectSolverBaseCL::Update (const MatrixCL& A)
+{
+    if (A.num_rows() != A.num_cols())
+        throw DROPSErrCL( "SparseDirectSolverBaseCL::Update: Matrix is not square.\n");
+    const size_t n= A.num_rows();
+    if (num_symbolic_ == 0 || rowbeg_.size() != n + 1 || colind_.size() != A.num_nonzeros()
+        || !std::equal( rowbeg_.begin(), rowbeg_.end(), A.raw_row())
+        || !std::equal( colind_.begin(), colind_.end(), A.raw_col()))
+        Symbolic( A);
+    Numeric( A);
+}
+
+void SparseDirectSolverBaseCL::SolveFactorized (VectorCL& x, const VectorCL& b) const
+{
+    const size_t n= D_.size();
+    z_.resize( n);
+    for (size_t i= 0; i < n; ++i)
+        z_[p_[i]]= b[i];
+    for (size_t j= 0; j < n; ++j) {
+        const double zj= z_[j];
+        for (size_t e= Lbeg_[j]; e < Lbeg_[j + 1]; ++e)
+            z_[Lind_[e]]-= L_[e]*zj;
+    }
+    const std::vector<double>& U= symm_ ? L_ : U_;
+    if (symm_)
+        for (size_t j= 0; j < n; ++j)
+            z_[j]/= D_[j];
+    for (size_t j= n; j > 0; --j) {
+        double sum= z_[j - 1];
+        for (size_t e= Lbeg_[j - 1]; e < Lbeg_[j]; ++e)
+            sum-= U[e]*z_[Lind_[e]];
+        z_[j - 1]= symm_ ? sum : sum/D_[j - 1];
+    }
+    x.resize( n);
+    for (size_t i= 0; i < n; ++i)
+        x[i]= z_[p_[i]];
+}
+
+void SparseDirectSolverBaseCL::Solve (const MatrixCL& A, VectorCL& x, const VectorCL& b) const
+{
+    if (num_numeric_ == 0)
+        throw DROPSErrCL( "SparseDirectSolverBaseCL::Solve: No factorization.\n");
+    SolveFactorized( x, b);
+    if (num_perturbed_ == 0)
+        return;
+    VectorCL dx( x.size());
+    for (Uint i= 0; i < refine_; ++i) {
+        r_.resize( b.size());
+        r_= b - A*x;
+        SolveFactorized( dx, r_);
+        x+= dx;
+    }
+}
+
+} // end of namespace DROPS
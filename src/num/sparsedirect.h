@@ -0,0 +1,147 @@
+/// \file sparsedirect.h
+/// \brief sparse direct solvers (LU and LDL^T) without external libraries, e.g. for coarse grids
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_SPARSEDIRECT_H
+#define DROPS_SPARSEDIRECT_H
+
+#include "num/spmat.h"
+#include <vector>
+
+namespace DROPS
+{
+
+/// \brief Fill reducing orderings of the sparse direct solvers.
+enum SparseOrderingT {
+    NaturalOrdering,         ///< the numbering of the matrix
+    RCMOrdering,             ///< reverse Cuthill-McKee, see reverse_cuthill_mckee
+    NestedDissectionOrdering ///< nested dissection, see nested_dissection; reverse Cuthill-McKee is used, if it produces less fill
+};
+
+/// \brief Nested dissection ordering of the graph of A + A^T.
+///
+/// The graph is bisected recursively by level structures: A breadth first search from a
+/// pseudo-peripheral vertex is split at the middle level, which is the separator. The separator
+/// is numbered after both parts. Separator vertices without neighbors in the second part are moved
+/// to the first part. Connected components are ordered independently. Subgraphs with at most
+/// leafsize vertices are not dissected further.
+/// \param A Interpreted as adjacency matrix of the graph.
+/// \param p Contains for each unknown i its new number p[i].
+void nested_dissection (const MatrixCL& A, PermutationT& p, size_t leafsize= 32);
+
+// ***************************************************************************
+/// \brief Base class of SparseLUSolverCL and SparseCholeskySolverCL.
+///
+/// The matrix is reordered symmetrically to reduce the fill. The sparsity pattern of the
+/// factors is computed from the elimination tree of the symmetrized pattern of the reordered
+/// matrix. The numerical factorization is up-looking, i.e. row k of L and column k of U are
+/// computed by sparse triangular solves along the elimination tree.
+///
+/// There is no row pivoting: Pivots with modulus below pivtol*max|a_ij| are replaced by this
+/// value (static pivoting). If this happens, Solve performs some steps of iterative refinement.
+/// Singular matrices, e.g. the pure Neumann Laplacian, can be used with consistent right hand sides.
+///
+/// Update reuses the ordering and the symbolic factorization, if the sparsity pattern of the
+/// matrix is the same as in the last factorization.
+// ***************************************************************************
+class SparseDirectSolverBaseCL
+{
+  private:
+    bool            symm_;     ///< LDL^T-factorization
+    SparseOrderingT ordering_;
+    double          pivtol_;   ///< relative threshold for static pivoting
+    Uint            refine_;   ///< maximal number of steps of iterative refinement
+
+    std::vector<size_t> rowbeg_,   ///< sparsity pattern of the matrix in the last symbolic factorization
+                        colind_;
+    PermutationT        p_;        ///< p_[i] is the new number of unknown i
+    std::vector<size_t> parent_;   ///< elimination tree of the reordered matrix
+    std::vector<size_t> Abeg_,     ///< for each new row k the entries j <= k of the symmetrized pattern ...
+                        Aj_,       ///< ... their column j, ...
+                        Arow_,     ///< ... the position of a_kj in the values of the matrix or NoIdx, ...
+                        Acol_;     ///< ... and the position of a_jk in the values of the matrix or NoIdx
+    std::vector<size_t> Lbeg_,     ///< columns of the strict lower triangle of L; the row indices increase
+                        Lind_;
+    std::vector<double> L_,        ///< values of L
+                        U_,        ///< values of the strict upper triangle of U, stored by rows with the pattern of L^T
+                        D_;        ///< diagonal of U
+    mutable VectorCL    z_,        ///< work vectors of Solve
+                        r_;
+    size_t              num_symbolic_,
+                        num_numeric_,
+                        num_perturbed_;
+
+    /// computes the symmetrized pattern of the reordered matrix, the elimination tree and the pattern of L; returns the number of nonzeros of L
+    size_t Analyse (const MatrixCL& A, const PermutationT& p);
+    void Symbolic (const MatrixCL& A);
+    void Numeric  (const MatrixCL& A);
+    /// computes the rows, which are reached from row k in the elimination tree, in topological order in s[top..n-1]; returns top
+    size_t EReach (size_t k, std::vector<size_t>& s, std::vector<size_t>& flag) const;
+    /// solves with the factors
+    void SolveFactorized (VectorCL& x, const VectorCL& b) const;
+
+  protected:
+    SparseDirectSolverBaseCL (bool symm, SparseOrderingT ordering, double pivtol, Uint refine)
+        : symm_( symm), ordering_( ordering), pivtol_( pivtol), refine_( refine),
+          num_symbolic_( 0), num_numeric_( 0), num_perturbed_( 0) {}
+
+  public:
+    /// factorizes A; the symbolic factorization is reused, if the sparsity pattern has not changed
+    void Update (const MatrixCL& A);
+    /// solves Ax= b with the last factorization of A
+    void Solve (const MatrixCL& A, VectorCL& x, const VectorCL& b) const;
+
+    SparseOrderingT GetOrdering () const { return ordering_; }
+    /// the permutation of the last symbolic factorization; p[i] is the new number of unknown i
+    const PermutationT& GetPermutation () const { return p_; }
+    /// number of nonzeros of the factors
+    size_t GetFactorNonzeros () const { return (symm_ ? 1 : 2)*L_.size() + D_.size(); }
+    size_t GetNumSymbolic () const { return num_symbolic_; }
+    size_t GetNumNumeric () const { return num_numeric_; }
+    /// number of pivots, which were replaced in the last factorization
+    size_t GetNumPerturbedPivots () const { return num_perturbed_; }
+};
+
+/// \brief Sparse LU-factorization for nonsymmetric matrices with symmetric (or nearly symmetric) sparsity pattern.
+/// The interface is the one of DirectNonSymmSolverCL in num/directsolver.h, thus it can be used
+/// with MGDirectCoarseSolverCL in MGsolver.h.
+class SparseLUSolverCL : public SparseDirectSolverBaseCL
+{
+  public:
+    SparseLUSolverCL (const MatrixCL& A, SparseOrderingT ordering= NestedDissectionOrdering, double pivtol= 1e-12, Uint refine= 3)
+        : SparseDirectSolverBaseCL( false, ordering, pivtol, refine) { Update( A); }
+};
+
+/// \brief Sparse LDL^T-factorization for symmetric matrices; the diagonal of D need not be positive.
+/// Only the lower triangle of the matrix is used. The interface is the one of DirectSymmSolverCL in
+/// num/directsolver.h, thus it can be used with MGDirectCoarseSolverCL in MGsolver.h.
+class SparseCholeskySolverCL : public SparseDirectSolverBaseCL
+{
+  public:
+    SparseCholeskySolverCL (const MatrixCL& A, SparseOrderingT ordering= NestedDissectionOrdering, double pivtol= 1e-12, Uint refine= 3)
+        : SparseDirectSolverBaseCL( true, ordering, pivtol, refine) { Update( A); }
+};
+
+} // end of namespace DROPS
+
+#endif
@@ -120,12 +120,302 @@ T& VectorBaseCL<T>::operator[](size_t s)
 }
 #endif
 
+//*****************************************************************************
+//
+//  BLAS-1 kernels for VectorBaseCL
+//
+//*****************************************************************************
+
+/// \brief Vectors with less components are processed by one thread in the
+/// BLAS-1 kernels below; for such vectors, opening a parallel region costs
+/// more than it saves.
+const size_t OMPMinVectorSizeC= 4096;
+
+/// \brief Computes the part [t_begin, t_end) of [0, n), which is processed by thread tid of num_threads.
+/// The threads [0, n%num_threads) obtain one additional element.
+inline void static_chunk (size_t n, size_t num_threads, size_t tid, size_t& t_begin, size_t& t_end)
+{
+    const size_t chunk_size= n/num_threads,
+                 remainder = n%num_threads;
+    t_begin= tid*chunk_size + (tid < remainder ? tid : remainder);
+    t_end= t_begin + chunk_size + (tid < remainder ? 1 : 0);
+}
+
+/// \brief Number of threads used by the BLAS-1 kernels for vectors of size n.
+inline Uint blas1_num_threads (size_t n)
+{
+#ifdef _OPENMP
+    return n < OMPMinVectorSizeC ? 1 : omp_get_max_threads();
+#else
+    (void)n;
+    return 1;
+#endif
+}
+
+/// \brief Applies the element-wise kernel k to [0, n) in parallel.
+///
+/// KernelT must provide void operator() (size_t begin, size_t end) const, which processes the components [begin, end).
+template <class KernelT>
+inline void blas1_map (const KernelT& k, size_t n)
+{
+    const Uint num_threads= blas1_num_threads( n);
+    if (num_threads == 1) {
+        k( 0, n);
+        return;
+    }
+#ifdef _OPENMP
+#   pragma omp parallel num_threads( num_threads)
+    {
+        size_t t_begin, t_end;
+        static_chunk( n, omp_get_num_threads(), omp_get_thread_num(), t_begin, t_end);
+        k( t_begin, t_end);
+    }
+#endif
+}
+
+/// \brief Summation strategy of the reductions in the BLAS-1 kernels.
+enum BLAS1ReductionT {
+    FastReduction,        ///< one partial result per thread, summed up in the order of the threads; reproducible for a fixed number of threads
+    ReproducibleReduction ///< partial results of blocks of fixed size, combined by pairwise summation; bitwise identical for any number of threads
+};
+
+/// \brief Size of the blocks of the ReproducibleReduction; it does not depend on the number of threads.
+const size_t ReproducibleBlockSizeC= 1024;
+
+/// \brief The reduction mode of the BLAS-1 kernels; the default is FastReduction.
+inline BLAS1ReductionT& blas1_reduction_mode ()
+{
+    static BLAS1ReductionT mode= FastReduction;
+    return mode;
+}
+
+/// \brief Select the reduction mode of the BLAS-1 kernels (dot, norm_sq, ..., KahanInnerProd) for the whole program.
+/// The reduction over the MPI-processes is not affected.
+inline void SetBLAS1Reduction (BLAS1ReductionT mode) { blas1_reduction_mode()= mode; }
+/// \brief Returns the reduction mode of the BLAS-1 kernels.
+inline BLAS1ReductionT GetBLAS1Reduction () { return blas1_reduction_mode(); }
+
+/// \brief Pairwise summation of v[i*stride], i in [0, n). The order of the additions depends only on n.
+template <typename T>
+T pairwise_sum (const T* v, size_t n, size_t stride= 1)
+{
+    if (n == 0)
+        return T();
+    if (n == 1)
+        return v[0];
+    const size_t n_half= n/2;
+    return pairwise_sum( v, n_half, stride) + pairwise_sum( v + n_half*stride, n - n_half, stride);
+}
+
+/// \brief Implements blas1_reduce for ReproducibleReduction.
+///
+/// [0, n) is split into blocks of ReproducibleBlockSizeC components. The partial results of the blocks are
+/// computed by the kernel serially and are combined by pairwise_sum. The threads only decide, who computes
+/// which block; thus the result does not depend on the number of threads.
+template <typename T, class KernelT>
+void blas1_reduce_reproducible (const KernelT& k, size_t n, T* result)
+{
+    const size_t num_blocks= (n + ReproducibleBlockSizeC - 1)/ReproducibleBlockSizeC;
+    if (num_blocks <= 1) {
+        k( 0, n, result);
+        return;
+    }
+    std::vector<T> b_res( num_blocks*KernelT::num_results);
+    const Uint num_threads= blas1_num_threads( n);
+    if (num_threads == 1)
+        for (size_t b= 0; b < num_blocks; ++b)
+            k( b*ReproducibleBlockSizeC, std::min( n, (b + 1)*ReproducibleBlockSizeC), &b_res[b*KernelT::num_results]);
+#ifdef _OPENMP
+    else {
+#       pragma omp parallel num_threads( num_threads)
+        {
+            size_t t_begin, t_end;
+            static_chunk( num_blocks, omp_get_num_threads(), omp_get_thread_num(), t_begin, t_end);
+            for (size_t b= t_begin; b < t_end; ++b)
+                k( b*ReproducibleBlockSizeC, std::min( n, (b + 1)*ReproducibleBlockSizeC), &b_res[b*KernelT::num_results]);
+        }
+    }
+#endif
+    for (Uint j= 0; j < KernelT::num_results; ++j)
+        result[j]= pairwise_sum( &b_res[j], num_blocks, KernelT::num_results);
+}
+
+/// \brief Applies the reduction kernel k to [0, n) in parallel and stores the KernelT::num_results results in result.
+///
+/// KernelT must provide a static constant num_results and void operator() (size_t begin, size_t end, T* res) const,
+/// which stores the num_results partial results for the components [begin, end) in res.
+/// With FastReduction, the thread-local partial results are summed up in the order of the thread-numbers. Hence, for a fixed
+/// number of threads, the result is reproducible from run to run. With ReproducibleReduction, the result is
+/// independent of the number of threads, see blas1_reduce_reproducible.
+template <typename T, class KernelT>
+inline void blas1_reduce (const KernelT& k, size_t n, T* result)
+{
+    if (GetBLAS1Reduction() == ReproducibleReduction) {
+        blas1_reduce_reproducible( k, n, result);
+        return;
+    }
+    const Uint num_threads= blas1_num_threads( n);
+    if (num_threads == 1) {
+        k( 0, n, result);
+        return;
+    }
+#ifdef _OPENMP
+    std::vector<T> t_res( num_threads*KernelT::num_results);
+    Uint used_threads= num_threads;
+#   pragma omp parallel num_threads( num_threads)
+    {
+        const Uint tid= omp_get_thread_num();
+        size_t t_begin, t_end;
+#       pragma omp single
+        used_threads= omp_get_num_threads();
+        static_chunk( n, used_threads, tid, t_begin, t_end);
+        k( t_begin, t_end, &t_res[tid*KernelT::num_results]);
+    }
+    for (Uint j= 0; j < KernelT::num_results; ++j) {
+        T sum= T();
+        for (Uint t= 0; t < used_threads; ++t)
+            sum+= t_res[t*KernelT::num_results + j];
+        result[j]= sum;
+    }
+#endif
+}
+
+///\brief Kernels for the BLAS-1 operations below; each works on raw arrays.
+///@{
+template <typename T>
+struct DotKernelCL
+{
+    static const Uint num_results= 1;
+    const T* x;
+    const T* y;
+
+    DotKernelCL (const T* xx, const T* yy) : x( xx), y( yy) {}
+    void operator() (size_t begin, size_t end, T* res) const {
+        T sum= T();
+        for (size_t i= begin; i < end; ++i)
+            sum+= x[i]*y[i];
+        res[0]= sum;
+    }
+};
+
+/// \brief Two inner products (x,y1), (x,y2) in one pass over x.
+template <typename T>
+struct Dot2KernelCL
+{
+    static const Uint num_results= 2;
+    const T* x;
+    const T* y1;
+    const T* y2;
+
+    Dot2KernelCL (const T* xx, const T* yy1, const T* yy2) : x( xx), y1( yy1), y2( yy2) {}
+    void operator() (size_t begin, size_t end, T* res) const {
+        T sum1= T(), sum2= T();
+        for (size_t i= begin; i < end; ++i) {
+            sum1+= x[i]*y1[i];
+            sum2+= x[i]*y2[i];
+        }
+        res[0]= sum1;
+        res[1]= sum2;
+    }
+};
+
+template <typename T>
+struct SupNormKernelCL
+{
+    static const Uint num_results= 1;
+    const T* x;
+
+    SupNormKernelCL (const T* xx) : x( xx) {}
+    void operator() (size_t begin, size_t end, T* res) const {
+        T ret= T();
+        for (size_t i= begin; i < end; ++i) {
+            const T t= std::abs( x[i]);
+            if (t > ret) ret= t;
+        }
+        res[0]= ret;
+    }
+};
+
+/// \brief y+= a*x; if w != 0, (y,w) is computed for the updated y, where w == y is allowed.
+template <typename T>
+struct AxpyDotKernelCL
+{
+    static const Uint num_results= 1;
+    T a;
+    const T* x;
+    T* y;
+    const T* w;
+
+    AxpyDotKernelCL (T aa, const T* xx, T* yy, const T* ww= 0) : a( aa), x( xx), y( yy), w( ww) {}
+    void operator() (size_t begin, size_t end) const {
+        for (size_t i= begin; i < end; ++i)
+            y[i]+= a*x[i];
+    }
+    void operator() (size_t begin, size_t end, T* res) const {
+        T sum= T();
+        for (size_t i= begin; i < end; ++i) {
+            y[i]+= a*x[i];
+            sum+= y[i]*w[i];
+        }
+        res[0]= sum;
+    }
+};
+
+/// \brief z= x + a*y + b*y2; if b == 0, y2 is not accessed. If norm is requested, |z|^2 is computed.
+/// z may alias x, y or y2.
+template <typename T>
+struct ZXpaypby2KernelCL
+{
+    static const Uint num_results= 1;
+    T* z;
+    const T* x;
+    T a;
+    const T* y;
+    T b;
+    const T* y2;
+
+    ZXpaypby2KernelCL (T* zz, const T* xx, T aa, const T* yy, T bb= T(), const T* yy2= 0)
+        : z( zz), x( xx), a( aa), y( yy), b( bb), y2( yy2) {}
+    void operator() (size_t begin, size_t end) const {
+        if (y2 == 0)
+            for (size_t i= begin; i < end; ++i)
+                z[i]= x[i] + a*y[i];
+        else
+            for (size_t i= begin; i < end; ++i)
+                z[i]= x[i] + a*y[i] + b*y2[i];
+    }
+    void operator() (size_t begin, size_t end, T* res) const {
+        T sum= T();
+        for (size_t i= begin; i < end; ++i) {
+            const T zi= y2 == 0 ? x[i] + a*y[i] : x[i] + a*y[i] + b*y2[i];
+            z[i]= zi;
+            sum+= zi*zi;
+        }
+        res[0]= sum;
+    }
+};
+///@}
+
 template <class T>
   inline T
   dot(const VectorBaseCL<T>& v, const VectorBaseCL<T>& w)
 {
     Assert( v.size()==w.size(), "dot: incompatible dimensions", DebugNumericC);
-    return std::inner_product( Addr( v), Addr( v) + v.size(), Addr( w), T());
+    T ret= T();
+    blas1_reduce( DotKernelCL<T>( Addr( v), Addr( w)), v.size(), &ret);
+    return ret;
+}
+
+/// \brief Computes (x,y1) and (x,y2) in one pass over x.
+template <class T>
+  inline void
+  dot2(const VectorBaseCL<T>& x, const VectorBaseCL<T>& y1, const VectorBaseCL<T>& y2, T& xy1, T& xy2)
+{
+    Assert( x.size()==y1.size() && x.size()==y2.size(), "dot2: incompatible dimensions", DebugNumericC);
+    T ret[2];
+    blas1_reduce( Dot2KernelCL<T>( Addr( x), Addr( y1), Addr( y2)), x.size(), ret);
+    xy1= ret[0];
+    xy2= ret[1];
 }
 
 template <class VT>
@@ -139,6 +429,15 @@ template <class VT>
     return ret;
 }
 
+template <class T>
+  inline T
+  norm_sq(const VectorBaseCL<T>& v)
+{
+    T ret= T();
+    blas1_reduce( DotKernelCL<T>( Addr( v), Addr( v)), v.size(), &ret);
+    return ret;
+}
+
 template <class VT>
   inline typename VT::value_type
   norm(const VT& v)
@@ -160,12 +459,52 @@ template <class VT>
     return ret;
 }
 
+template <class T>
+  inline T
+  supnorm(const VectorBaseCL<T>& v)
+{
+    const Uint num_threads= blas1_num_threads( v.size());
+    std::vector<T> t_res( num_threads);
+    if (num_threads == 1)
+        SupNormKernelCL<T>( Addr( v))( 0, v.size(), &t_res[0]);
+#ifdef _OPENMP
+    else {
+#       pragma omp parallel num_threads( num_threads)
+        {
+            size_t t_begin, t_end;
+            static_chunk( v.size(), omp_get_num_threads(), omp_get_thread_num(), t_begin, t_end);
+            SupNormKernelCL<T>( Addr( v))( t_begin, t_end, &t_res[omp_get_thread_num()]);
+        }
+    }
+#endif
+    return *std::max_element( t_res.begin(), t_res.end());
+}
+
 template <typename T>
   inline void
   axpy(T a, const VectorBaseCL<T>& x, VectorBaseCL<T>& y)
 {
     Assert(x.size()==y.size(), "axpy: incompatible dimensions", DebugNumericC);
-    y+= a*x;
+    blas1_map( AxpyDotKernelCL<T>( a, Addr( x), Addr( y)), y.size());
+}
+
+/// \brief y+= a*x; returns (y,w) for the updated y in the same pass; w may be y.
+template <typename T>
+  inline T
+  axpy_dot(T a, const VectorBaseCL<T>& x, VectorBaseCL<T>& y, const VectorBaseCL<T>& w)
+{
+    Assert(x.size()==y.size() && x.size()==w.size(), "axpy_dot: incompatible dimensions", DebugNumericC);
+    T ret= T();
+    blas1_reduce( AxpyDotKernelCL<T>( a, Addr( x), Addr( y), Addr( w)), y.size(), &ret);
+    return ret;
+}
+
+/// \brief y+= a*x; returns the squared norm of the updated y in the same pass.
+template <typename T>
+  inline T
+  axpy_norm_sq(T a, const VectorBaseCL<T>& x, VectorBaseCL<T>& y)
+{
+    return axpy_dot( a, x, y, y);
 }
 
 template <typename T>
@@ -174,7 +513,19 @@ template <typename T>
 {
     Assert(z.size()==x.size() && z.size()==y.size(),
         "z_xpay: incompatible dimensions", DebugNumericC);
-    z= x + a*y;
+    blas1_map( ZXpaypby2KernelCL<T>( Addr( z), Addr( x), a, Addr( y)), z.size());
+}
+
+/// \brief z= x + a*y; returns the squared norm of z in the same pass.
+template <typename T>
+  inline T
+  z_xpay_norm_sq(VectorBaseCL<T>& z, const VectorBaseCL<T>& x, T a, const VectorBaseCL<T>& y)
+{
+    Assert(z.size()==x.size() && z.size()==y.size(),
+        "z_xpay_norm_sq: incompatible dimensions", DebugNumericC);
+    T ret= T();
+    blas1_reduce( ZXpaypby2KernelCL<T>( Addr( z), Addr( x), a, Addr( y)), z.size(), &ret);
+    return ret;
 }
 
 template <typename T>
@@ -184,7 +535,7 @@ template <typename T>
 {
     Assert(z.size()==x.size() && z.size()==y.size() && z.size()==y2.size(),
         "z_xpaypby2: incompatible dimensions", DebugNumericC);
-    z= x + a*y + b*y2;
+    blas1_map( ZXpaypby2KernelCL<T>( Addr( z), Addr( x), a, Addr( y), b, Addr( y2)), z.size());
 }
 
 
@@ -265,22 +616,40 @@ KahanInnerProd( Iterator first1, const Iterator& end1, Iterator first2, const T
     }
     return sum;
 }
-template <class ValueT, template<class> class VecT>
-inline ValueT
+/// \brief Kernel for blas1_reduce: Kahan's algorithm on each chunk; the compensation is added to the partial result.
+template <typename T>
+struct KahanDotKernelCL
+{
+    static const Uint num_results= 1;
+    const T* x;
+    const T* y;
+
+    KahanDotKernelCL (const T* xx, const T* yy) : x( xx), y( yy) {}
+    void
 #if GCC_VERSION > 40305 && !__INTEL_COMPILER
     __attribute__((optimize("no-associative-math")))
 #endif
+    operator() (size_t begin, size_t end, T* res) const {
+        T sum= T(), c= T(), t, z;
+        for (size_t i= begin; i < end; ++i) {
+            z  = x[i]*y[i] - c;
+            t  = sum + z;
+            c  = (t-sum)-z;
+            sum= t;
+        }
+        res[0]= sum - c;
+    }
+};
+
+/// \brief Kahan's inner product of two vectors; for long vectors, each thread sums up a contiguous chunk.
+template <class ValueT, template<class> class VecT>
+inline ValueT
 KahanInnerProd( const VecT<ValueT>& first, const VecT<ValueT>& second, const ValueT init=(ValueT)0)
 {
     Assert(first.size() == second.size(), "KahanInnerProd: sizes don't match", DebugNumericC);
-    ValueT sum= init, c=ValueT(0), t, y;
-    for (size_t i = 0; i<first.size(); ++i) {
-        y  = first[i]*second[i] - c;
-        t  = sum + y;
-        c  = (t-sum)-y;
-        sum= t;
-    }
-    return sum;
+    ValueT sum= ValueT();
+    blas1_reduce( KahanDotKernelCL<ValueT>( Addr( first), Addr( second)), first.size(), &sum);
+    return init + sum;
 }
 
 /// \brief Use Kahan's algorithm to perform an inner product on given indices
@@ -326,10 +695,10 @@ void inplace_parallel_partial_sum (iterator begin, iterator end,
 #endif
 
     // Compute the part of [begin, end) to be considered in the current thread.
-    const size_t chunk_size= (end - begin)/num_threads;
-    const size_t remainder = (end - begin)%num_threads; // The threads [0,remainder) will have chunks of size chunk_size+1.
-    const iterator t_begin= begin + tid*chunk_size + (tid < remainder ? tid : remainder);
-    const iterator t_end= t_begin + chunk_size + (tid < remainder ? 1 : 0);
+    size_t chunk_begin, chunk_end;
+    static_chunk( end - begin, num_threads, tid, chunk_begin, chunk_end);
+    const iterator t_begin= begin + chunk_begin;
+    const iterator t_end= begin + chunk_end;
 
     // Compute the sum for each chunk in parallel
     typedef typename std::iterator_traits<iterator>::value_type value_type;
@@ -375,6 +744,7 @@ struct BlockTraitsCL
 {
     typedef BlockT block_type; ///< The data-blocks used in the builder (e.g. double, SMatrixCL<3,3>)
     typedef std::pair<size_t, block_type*> sort_pair_type; ///< Type used for sorting the rows when using hash-maps
+    typedef block_type& reference; ///< Type returned by SparseMatBuilderCL::operator()
 
     static const Uint num_rows= BlockT::num_rows; ///< Number of rows of one block
     static const Uint num_cols= BlockT::num_cols; ///< Number of columns of one block
@@ -387,15 +757,19 @@ struct BlockTraitsCL
     static inline void insert_block_row (Iter, Iter, const size_t*, size_t*, double*); // not defined
     ///\brief Creates a pair for sorting the rows from a key-value pari stored in the hash-map.
     static inline sort_pair_type pair_copy (const std::pair<size_t, double>& p); // not defined
-    ///\brief Return an entry, if the sparsity pattern is reused (only for block_type == double).
-    static inline block_type& get_entry_reuse (const size_t*, const size_t*, size_t, double*); // not defined
+    ///\brief Return an entry, if the sparsity pattern is reused: The arguments are the row-begin-array starting at the first row of the block-row, the column-indices, the first column of the block and the values.
+    static inline reference get_entry_reuse (const size_t*, const size_t*, size_t, double*); // not defined
 };
 
+template <class BlockT>
+class BlockRefCL;
+
 template <>
 struct BlockTraitsCL<double>
 {
     typedef double block_type;
     typedef std::pair<size_t, double> sort_pair_type;
+    typedef double& reference;
 
     static const Uint num_rows= 1;
     static const Uint num_cols= 1;
@@ -413,10 +787,10 @@ struct BlockTraitsCL<double>
     static inline sort_pair_type pair_copy (const std::pair<size_t, double>& p)
         { return p; }
 
-    static inline double& get_entry_reuse (const size_t* col_idx_begin, const size_t* col_idx_end, size_t j, double* val) {
-        const size_t* pos= std::lower_bound( col_idx_begin, col_idx_end, j);
-        Assert( pos != col_idx_end, "SparseMatBuilderCL (): no such index", DebugNumericC);
-        return val[pos - col_idx_begin];
+    static inline double& get_entry_reuse (const size_t* rb, const size_t* colind, size_t j, double* val) {
+        const size_t* pos= std::lower_bound( colind + rb[0], colind + rb[1], j);
+        Assert( pos != colind + rb[1] && *pos == j, "SparseMatBuilderCL (): no such index", DebugNumericC);
+        return val[pos - colind];
     }
 };
 
@@ -425,10 +799,11 @@ struct BlockTraitsCL< SMatrixCL<Rows, Cols> >
 {
     typedef SMatrixCL<Rows, Cols> block_type;
     typedef std::pair<size_t, block_type*> sort_pair_type;
+    typedef BlockRefCL<block_type> reference;
 
     static const Uint num_rows= Rows;
     static const Uint num_cols= Cols;
-    static const bool no_reuse= true;
+    static const bool no_reuse= false;
 
     static inline  void row_nnz (size_t* row_nnz_ar, size_t row, size_t num_blocks) {
         for (Uint k= 0; k < num_rows; ++k)
@@ -449,8 +824,17 @@ struct BlockTraitsCL< SMatrixCL<Rows, Cols> >
     }
     static inline sort_pair_type pair_copy (std::pair<const size_t, block_type>& p)
         { return std::make_pair( p.first, &p.second); }
-    static inline block_type& get_entry_reuse (const size_t*, const size_t*, size_t, double*)
-        { throw DROPSErrCL( "SparseMatBuilderCL: Cannot reuse the sparsity-pattern for SMatrixCL-blocks"); }
+    ///\brief The block is the l-th block of its block-row; all rows of the block-row have the same pattern.
+    static inline reference get_entry_reuse (const size_t* rb, const size_t* colind, size_t j, double* val) {
+        const size_t* pos= std::lower_bound( colind + rb[0], colind + rb[1], j);
+        Assert( pos != colind + rb[1] && *pos == j, "SparseMatBuilderCL (): no such index", DebugNumericC);
+        return reference( rb, (pos - colind - rb[0])/num_cols, val);
+    }
+    static inline void add_reuse (const size_t* rb, size_t l, double* val, const block_type& b, double s) {
+        for (size_t i= 0; i < num_rows; ++i)
+            for (size_t j= 0; j < num_cols; ++j)
+                val[j + l*num_cols + rb[i]]+= s*b( i, j);
+    }
 };
 
 template <Uint Rows>
@@ -458,10 +842,11 @@ struct BlockTraitsCL< SDiagMatrixCL<Rows> >
 {
     typedef SDiagMatrixCL<Rows> block_type;
     typedef std::pair<size_t, block_type*> sort_pair_type;
+    typedef BlockRefCL<block_type> reference;
 
     static const Uint num_rows= Rows;
     static const Uint num_cols= Rows;
-    static const bool no_reuse= true;
+    static const bool no_reuse= false;
 
     static inline  void row_nnz (size_t* row_nnz_ar, size_t row, size_t num_blocks) {
         for (Uint k= 0; k < num_rows; ++k)
@@ -481,11 +866,48 @@ struct BlockTraitsCL< SDiagMatrixCL<Rows> >
     }
     static inline sort_pair_type pair_copy (std::pair<const size_t, block_type>& p)
         { return std::make_pair( p.first, &p.second); }
-    static inline block_type& get_entry_reuse (const size_t*, const size_t*, size_t, double*)
-        { throw DROPSErrCL( "SparseMatBuilderCL: Cannot reuse the sparsity-pattern for SDiagMatrixCL-blocks"); }
+    ///\brief The block is the l-th block of its block-row; all rows of the block-row have the same pattern.
+    static inline reference get_entry_reuse (const size_t* rb, const size_t* colind, size_t j, double* val) {
+        const size_t* pos= std::lower_bound( colind + rb[0], colind + rb[1], j);
+        Assert( pos != colind + rb[1] && *pos == j, "SparseMatBuilderCL (): no such index", DebugNumericC);
+        return reference( rb, pos - colind - rb[0], val);
+    }
+    static inline void add_reuse (const size_t* rb, size_t l, double* val, const block_type& b, double s) {
+        for (size_t i= 0; i < num_rows; ++i)
+            val[l + rb[i]]+= s*b( i);
+    }
 };
 ///@}
 
+/// \brief Reference to a block of a SparseMatBuilderCL.
+///
+/// The block is either stored in the builder or, if the sparsity-pattern is reused, its entries are
+/// scattered over the rows of the matrix. Only the updates used in the accumulation are supported.
+template <class BlockT>
+class BlockRefCL
+{
+  private:
+    BlockT*       block_; ///< block in the builder; 0, if the pattern is reused
+    const size_t* rb_;    ///< row-begin-array starting at the first row of the block-row
+    size_t        l_;     ///< position of the block in its block-row
+    double*       val_;   ///< values of the matrix
+
+  public:
+    BlockRefCL (BlockT& b) : block_( &b), rb_( 0), l_( 0), val_( 0) {}
+    BlockRefCL (const size_t* rb, size_t l, double* val) : block_( 0), rb_( rb), l_( l), val_( val) {}
+
+    BlockRefCL& operator+= (const BlockT& b) {
+        if (block_ != 0) *block_+= b;
+        else BlockTraitsCL<BlockT>::add_reuse( rb_, l_, val_, b, 1.);
+        return *this;
+    }
+    BlockRefCL& operator-= (const BlockT& b) {
+        if (block_ != 0) *block_-= b;
+        else BlockTraitsCL<BlockT>::add_reuse( rb_, l_, val_, b, -1.);
+        return *this;
+    }
+};
+
 /// \brief Building sparse matrices
 ///
 /// \param T is the type of the matrix-entries
@@ -501,6 +923,7 @@ public:
     typedef T                        valueT;
     typedef SparseMatBaseCL<T>       spmatT;
     typedef std::pair<size_t, block_type> entryT;
+    typedef typename BlockTraitT::reference reference;
 #if DROPS_SPARSE_MAT_BUILDER_USES_HASH_MAP
 #  ifndef DROPS_WIN
      typedef std::tr1::unordered_map<size_t, block_type> couplT;
@@ -530,6 +953,8 @@ public:
             if (BlockTraitT::no_reuse)
                 throw DROPSErrCL( "SparseMatBuilderCL: Cannot reuse the pattern for block_type != double.");
             Comment("SparseMatBuilderCL: Reusing OLD matrix" << std::endl, DebugNumericC);
+            Assert( _mat->num_rows() == _rows && _mat->num_cols() == _cols, "SparseMatBuilderCL: Cannot reuse the pattern of a matrix with different dimensions.", DebugNumericC);
+            std::fill( _mat->raw_val(), _mat->raw_val() + _mat->num_nonzeros(), T());
             _coupl=0;
         }
         else
@@ -545,7 +970,7 @@ public:
 
     ~SparseMatBuilderCL() { if (_coupl) delete[] _coupl; }
 
-    block_type& operator() (size_t i, size_t j)
+    reference operator() (size_t i, size_t j)
     {
 ///Todo: Assert anpassen
   //      Assert( i < _rows/BlockTraitT::num_rows && j <_cols/BlockTraitT::num_cols,
@@ -554,7 +979,7 @@ public:
         if (!_reuse)
             return _coupl[i/BlockTraitT::num_rows][j/BlockTraitT::num_cols];
         else
-            return BlockTraitT::get_entry_reuse( _mat->GetFirstCol( i),  _mat->GetFirstCol( i + 1), j, _mat->GetFirstVal( i));
+            return BlockTraitT::get_entry_reuse( _mat->raw_row() + i, _mat->raw_col(), j, _mat->raw_val());
     }
 
     void Build();
@@ -618,10 +1043,19 @@ void SparseMatBuilderCL<T, BlockT>::Build()
     _coupl= 0;
 }
 
+/// \brief Algorithm for the transposed matrix-vector product transp_mul(A, x).
+enum TranspMulT {
+    SerialTranspMul,  ///< serial scatter over the rows of A; needs no additional memory
+    PrivateTranspMul, ///< threads scatter into private copies of the result, which are summed up in parallel
+    ExplicitTranspMul ///< parallel product with the explicit transpose of A, which is recomputed, if Version() changes
+};
+
 ///\brief  SparseMatBaseCL: compressed row storage sparse matrix
 /// Use SparseMatBuilderCL for setting up.
 ///
 /// If the size of _colind plus _val exceeds mmap_threshold, they are allocated as a single chunk with mmap. The memory management of these 2 arrays is encapsulated in the private num_nonzeros(nnz).
+///
+/// The algorithm of transp_mul is selected per matrix by SetTranspMul; copies inherit it, assignment does not change it.
 template <typename T>
 class SparseMatBaseCL
 {
@@ -638,6 +1072,13 @@ private:
     std::valarray<size_t> _colind; ///< (nnz_ entries) column-number of corresponding entry in _val
     std::valarray<T>      _val;    ///< (nnz_ entries) the components of the matrix
 
+    TranspMulT                  transp_mul_;     ///< algorithm of transp_mul
+    mutable SparseMatBaseCL<T>* transp_;         ///< explicit transpose for ExplicitTranspMul
+    mutable size_t              transp_version_; ///< version_ of this matrix, from which transp_ was computed
+
+    size_t pattern_key_;     ///< key of the assembly, which created the pattern; 0, if none is set
+    size_t pattern_version_; ///< version_ of this matrix, for which pattern_key_ was set
+
     void num_rows (size_t rows);    ///< Set _rows and resize _rowbeg
     void num_cols (size_t cols);    ///< Set _cols
     void num_nonzeros (size_t nnz); ///< Set nnz_ and resize _colind and _val
@@ -678,6 +1119,19 @@ public:
     void IncrementVersion() { ++version_; }      ///< Increment modification version number
     size_t Version() const  { return version_; } ///< Get modification version number
 
+    void       SetTranspMul (TranspMulT m); ///< Select the algorithm of transp_mul
+    TranspMulT GetTranspMul () const { return transp_mul_; }
+    ///\brief Returns the explicit transpose; it is recomputed, if the matrix has been modified since the last call.
+    const SparseMatBaseCL& GetTranspose () const;
+
+    /// \name Reuse of the sparsity pattern
+    /// An assembly records a key of its sparsity pattern, e.g. IdxDescCL::GetNumberingVersion(), after building the matrix.
+    /// A later assembly with the same key can reuse the pattern, if the matrix has not been modified in between.
+    //@{
+    void SetPatternKey (size_t key) { pattern_key_= key; pattern_version_= version_; }
+    bool HasPatternKey (size_t key) const { return key != 0 && key == pattern_key_ && version_ == pattern_version_; }
+    //@}
+
     const size_t* GetFirstCol(size_t i) const { return Addr(_colind) + _rowbeg[i]; }
           size_t* GetFirstCol(size_t i)       { return Addr(_colind) + _rowbeg[i]; }
     const T*      GetFirstVal(size_t i) const { return Addr(_val)    + _rowbeg[i]; }
@@ -745,30 +1199,36 @@ template <typename T>
 
 template <typename T>
   SparseMatBaseCL<T>::SparseMatBaseCL ()
-    : _rows(0), _cols(0), nnz_( 0), version_(1), _rowbeg( size_t(), 1), _colind(), _val()
+    : _rows(0), _cols(0), nnz_( 0), version_(1), _rowbeg( size_t(), 1), _colind(), _val(),
+      transp_mul_( SerialTranspMul), transp_( 0), transp_version_( 0), pattern_key_( 0), pattern_version_( 0)
 {}
 
 template <typename T>
   SparseMatBaseCL<T>::SparseMatBaseCL (const SparseMatBaseCL& m)
     : _rows( m._rows), _cols( m._cols), nnz_( m.nnz_), version_( m.version_),
-      _rowbeg( m._rowbeg), _colind( m._colind), _val( m._val)
+      _rowbeg( m._rowbeg), _colind( m._colind), _val( m._val),
+      transp_mul_( m.transp_mul_), transp_( 0), transp_version_( 0), pattern_key_( m.pattern_key_), pattern_version_( m.pattern_version_)
 {}
 
 template <typename T>
   SparseMatBaseCL<T>::~SparseMatBaseCL ()
-{}
+{
+    delete transp_;
+}
 
 template <typename T>
   SparseMatBaseCL<T>::SparseMatBaseCL (size_t rows, size_t cols, size_t nnz)
     : _rows( rows), _cols( cols), nnz_( nnz), version_( 1),
-      _rowbeg( rows+1), _colind( nnz), _val( nnz)
+      _rowbeg( rows+1), _colind( nnz), _val( nnz),
+      transp_mul_( SerialTranspMul), transp_( 0), transp_version_( 0), pattern_key_( 0), pattern_version_( 0)
 {}
 
 
 template <typename T>
   SparseMatBaseCL<T>::SparseMatBaseCL(const std::valarray<T>& v)
       : _rows( v.size()), _cols( v.size()), nnz_( 0), version_( 1),
-        _rowbeg( v.size() + 1), _colind( 0), _val( 0)
+        _rowbeg( v.size() + 1), _colind( 0), _val( 0),
+        transp_mul_( SerialTranspMul), transp_( 0), transp_version_( 0), pattern_key_( 0), pattern_version_( 0)
 {
     num_nonzeros( v.size());
     for (size_t i= 0; i < _rows; ++i)
@@ -790,6 +1250,28 @@ template <typename T>
     return *this;
 }
 
+template <typename T>
+  void SparseMatBaseCL<T>::SetTranspMul (TranspMulT m)
+{
+    transp_mul_= m;
+    if (m != ExplicitTranspMul) {
+        delete transp_;
+        transp_= 0;
+    }
+}
+
+template <typename T>
+  const SparseMatBaseCL<T>& SparseMatBaseCL<T>::GetTranspose () const
+{
+    if (transp_ == 0)
+        transp_= new SparseMatBaseCL<T>;
+    if (transp_version_ != version_) {
+        transpose( *this, *transp_);
+        transp_version_= version_;
+    }
+    return *transp_;
+}
+
 template <typename T>
 T SparseMatBaseCL<T>::operator() (size_t i, size_t j) const
 {
@@ -943,6 +1425,98 @@ class SparseMatDiagCL
 };
 
 
+//**********************************************************************************
+//
+//  S p a r s e M a t C o l o r i n g C L :  multicolor ordering of the rows of a sparse matrix
+//
+//**********************************************************************************
+
+///\brief Partition of the rows of a square sparse matrix into colors, such that rows of the same color are not coupled.
+///
+/// Rows i != j of the same color satisfy A(i,j) == 0 and A(j,i) == 0; thus, Gauss-Seidel type methods can update all
+/// rows of one color in parallel. The colors are computed by a greedy algorithm in the order of the rows. As the
+/// coloring only depends on the sparsity pattern, it is recomputed only if the pattern changes (SamePattern()).
+class SparseMatColoringCL
+{
+  private:
+    size_t              num_rows_;
+    size_t              pattern_hash_; ///< hash of the sparsity pattern, from which the coloring was computed
+    std::vector<size_t> colorbeg_;     ///< (num_colors+1 entries) index of the first row of each color in rows_
+    std::vector<size_t> rows_;         ///< the rows, sorted by color and ascending within each color
+
+    template <typename T>
+    static size_t pattern_hash (const SparseMatBaseCL<T>& A) {
+        size_t h= A.num_rows();
+        for (size_t i= 0; i <= A.num_rows(); ++i)
+            h^= A.row_beg( i) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        for (size_t nz= 0; nz < A.num_nonzeros(); ++nz)
+            h^= A.col_ind( nz) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+
+  public:
+    SparseMatColoringCL () : num_rows_( 0), pattern_hash_( 0), colorbeg_( 1, 0) {}
+    template <typename T>
+    explicit SparseMatColoringCL (const SparseMatBaseCL<T>& A) { assign( A); }
+
+    /// \brief Compute the coloring of the rows of A.
+    template <typename T>
+    void assign (const SparseMatBaseCL<T>& A);
+    /// \brief True, if the coloring has been computed for a matrix with the sparsity pattern of A.
+    template <typename T>
+    bool SamePattern (const SparseMatBaseCL<T>& A) const
+    { return num_rows_ == A.num_rows() && rows_.size() == A.num_rows() && pattern_hash_ == pattern_hash( A); }
+
+    size_t num_colors () const { return colorbeg_.size() - 1; }
+    size_t num_rows   () const { return num_rows_; }
+    /// \brief The rows of color c are [color_begin( c), color_end( c)).
+    const size_t* color_begin (size_t c) const { return Addr( rows_) + colorbeg_[c]; }
+    const size_t* color_end   (size_t c) const { return Addr( rows_) + colorbeg_[c + 1]; }
+};
+
+template <typename T>
+void SparseMatColoringCL::assign (const SparseMatBaseCL<T>& A)
+{
+    Assert( A.num_rows() == A.num_cols(), "SparseMatColoringCL::assign: no square Matrix", DebugNumericC);
+    num_rows_= A.num_rows();
+    pattern_hash_= pattern_hash( A);
+    SparseMatBaseCL<T> AT;
+    transpose( A, AT);
+
+    // greedy coloring: row i gets the smallest color, which is not used by its neighbours in A and A^T.
+    const size_t no_color= std::numeric_limits<size_t>::max();
+    std::vector<size_t> color( num_rows_, no_color),
+                        mark; // mark[c] == i, if color c is used by a neighbour of i
+    size_t num_colors= 0;
+    for (size_t i= 0; i < num_rows_; ++i) {
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+            if (color[A.col_ind( nz)] != no_color)
+                mark[color[A.col_ind( nz)]]= i;
+        for (size_t nz= AT.row_beg( i); nz < AT.row_beg( i + 1); ++nz)
+            if (color[AT.col_ind( nz)] != no_color)
+                mark[color[AT.col_ind( nz)]]= i;
+        size_t c= 0;
+        while (c < num_colors && mark[c] == i)
+            ++c;
+        if (c == num_colors) {
+            ++num_colors;
+            mark.push_back( no_color);
+        }
+        color[i]= c;
+    }
+
+    // sort the rows by color
+    colorbeg_.assign( num_colors + 1, 0);
+    for (size_t i= 0; i < num_rows_; ++i)
+        ++colorbeg_[color[i] + 1];
+    std::partial_sum( colorbeg_.begin(), colorbeg_.end(), colorbeg_.begin());
+    std::vector<size_t> pos( colorbeg_.begin(), colorbeg_.end() - 1);
+    rows_.resize( num_rows_);
+    for (size_t i= 0; i < num_rows_; ++i)
+        rows_[pos[color[i]]++]= i;
+}
+
+
 //*****************************************************************************
 //
 //  Vector as diagonal matrix
@@ -1364,17 +1938,146 @@ SparseMatBaseCL<T>::insert_col (size_t c, const VectorBaseCL<T>& v)
 
 
 /// \brief Compute the transpose matrix of M explicitly.
-/// This could be handled more memory-efficient by exploiting
-/// that the column-indices in the rows of M are ascending.
+/// As the rows of M are traversed in ascending order, the column-indices
+/// in the rows of Mt are ascending without sorting.
 template <typename T>
 void
 transpose (const SparseMatBaseCL<T>& M, SparseMatBaseCL<T>& Mt)
 {
-    SparseMatBuilderCL<T> Tr( &Mt, M.num_cols(), M.num_rows());
+    Mt.resize( M.num_cols(), M.num_rows(), M.num_nonzeros());
+    size_t* rb= Mt.raw_row();
+    std::fill( rb, rb + M.num_cols() + 1, size_t());
+    for (size_t nz= 0; nz < M.num_nonzeros(); ++nz)
+        ++rb[M.col_ind( nz) + 1];
+    std::partial_sum( rb, rb + M.num_cols() + 1, rb);
+
+    std::vector<size_t> pos( rb, rb + M.num_cols());
+    size_t* col= Mt.raw_col();
+    T*      val= Mt.raw_val();
     for (size_t i= 0; i< M.num_rows(); ++i)
-        for (size_t nz= M.row_beg( i); nz < M.row_beg( i + 1); ++nz)
-            Tr( M.col_ind( nz), i)= M.val( nz);
-    Tr.Build();
+        for (size_t nz= M.row_beg( i); nz < M.row_beg( i + 1); ++nz) {
+            const size_t k= pos[M.col_ind( nz)]++;
+            col[k]= i;
+            val[k]= M.val( nz);
+        }
+}
+
+/// \brief Compute the sparsity pattern of C= A*B; the values of C are not initialized.
+/// The column-indices in each row of C are ascending.
+template <typename T>
+void
+mat_mul_pattern (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, SparseMatBaseCL<T>& C)
+{
+    Assert( A.num_cols() == B.num_rows(), "mat_mul_pattern: incompatible dimensions", DebugNumericC);
+    const size_t n= A.num_rows(), m= B.num_cols();
+    std::vector<size_t> rb( n + 1);
+    // count the entries of each row
+#   pragma omp parallel
+    {
+        std::vector<size_t> marker( m, size_t( -1));
+#ifndef DROPS_WIN
+        size_t i;
+#else
+        int i;
+#endif
+#       pragma omp for
+        for (i= 0; i < n; ++i) {
+            size_t cnt= 0;
+            for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+                for (size_t l= B.row_beg( A.col_ind( nz)); l < B.row_beg( A.col_ind( nz) + 1); ++l)
+                    if (marker[B.col_ind( l)] != static_cast<size_t>( i)) {
+                        marker[B.col_ind( l)]= i;
+                        ++cnt;
+                    }
+            rb[i + 1]= cnt;
+        }
+    }
+    std::partial_sum( rb.begin(), rb.end(), rb.begin());
+    C.resize( n, m, rb[n]);
+    std::copy( rb.begin(), rb.end(), C.raw_row());
+    // fill the column-indices
+    size_t* col= C.raw_col();
+#   pragma omp parallel
+    {
+        std::vector<size_t> marker( m, size_t( -1));
+#ifndef DROPS_WIN
+        size_t i;
+#else
+        int i;
+#endif
+#       pragma omp for
+        for (i= 0; i < n; ++i) {
+            size_t k= rb[i];
+            for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+                for (size_t l= B.row_beg( A.col_ind( nz)); l < B.row_beg( A.col_ind( nz) + 1); ++l)
+                    if (marker[B.col_ind( l)] != static_cast<size_t>( i)) {
+                        marker[B.col_ind( l)]= i;
+                        col[k++]= B.col_ind( l);
+                    }
+            std::sort( col + rb[i], col + k);
+        }
+    }
+}
+
+/// \brief Compute the values of C= A*B, where the sparsity pattern of C has been computed by mat_mul_pattern( A, B, C).
+/// If only the values of A and B changed, the pattern of C can be reused.
+template <typename T>
+void
+mat_mul_values (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, SparseMatBaseCL<T>& C)
+{
+    Assert( A.num_rows() == C.num_rows() && B.num_cols() == C.num_cols(), "mat_mul_values: incompatible dimensions", DebugNumericC);
+    T* val= C.raw_val();
+#   pragma omp parallel
+    {
+        std::vector<size_t> pos( C.num_cols()); // position of a column in the current row of C
+#ifndef DROPS_WIN
+        size_t i;
+#else
+        int i;
+#endif
+#       pragma omp for
+        for (i= 0; i < C.num_rows(); ++i) {
+            for (size_t k= C.row_beg( i); k < C.row_beg( i + 1); ++k) {
+                pos[C.col_ind( k)]= k;
+                val[k]= T();
+            }
+            for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+                for (size_t l= B.row_beg( A.col_ind( nz)); l < B.row_beg( A.col_ind( nz) + 1); ++l)
+                    val[pos[B.col_ind( l)]]+= A.val( nz)*B.val( l);
+        }
+    }
+    C.IncrementVersion();
+}
+
+/// \brief Compute the sparse matrix product C= A*B.
+template <typename T>
+void
+mat_mul (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B, SparseMatBaseCL<T>& C)
+{
+    mat_mul_pattern( A, B, C);
+    mat_mul_values( A, B, C);
+}
+
+/// \brief Copy A to B with conversion of the values, e.g. a single precision copy of a double matrix.
+template <typename T, typename U>
+void
+convert (const SparseMatBaseCL<U>& A, SparseMatBaseCL<T>& B)
+{
+    if (B.num_rows() != A.num_rows() || B.num_cols() != A.num_cols() || B.num_nonzeros() != A.num_nonzeros())
+        B.resize( A.num_rows(), A.num_cols(), A.num_nonzeros());
+    std::copy( A.raw_row(), A.raw_row() + A.num_rows() + 1, B.raw_row());
+    std::copy( A.raw_col(), A.raw_col() + A.num_nonzeros(), B.raw_col());
+    const U* a= A.raw_val();
+    T*       b= B.raw_val();
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for
+    for (i= 0; i < A.num_nonzeros(); ++i)
+        b[i]= static_cast<T>( a[i]);
+    B.IncrementVersion();
 }
 
 
@@ -1448,17 +2151,78 @@ y_ATx(T* __restrict y,
     } while (--num_rows > 0);
 }
 
+// y+= A^T*x; the threads scatter the rows of A with about the same number of non-zeros
+// into private copies of y, which are added to y in a second, column-parallel sweep.
+// The first thread scatters directly into y.
+// Assumes, that none of the arrays involved do alias.
+template <typename T>
+void
+y_ATx_private(T* __restrict y,
+     size_t num_rows,
+     size_t num_cols,
+     const T* __restrict Aval,
+     const size_t* __restrict Arow,
+     const size_t* __restrict Acol,
+     const T* __restrict x)
+{
+    const Uint num_threads= blas1_num_threads( Arow[num_rows]);
+    if (num_threads == 1) {
+        if (num_rows > 0)
+            y_ATx( y, num_rows, Aval, Arow, Acol, x);
+        return;
+    }
+#ifdef _OPENMP
+    T* buf= new T[(num_threads - 1)*num_cols];
+#   pragma omp parallel num_threads( num_threads)
+    {
+        const Uint nt= omp_get_num_threads(), tid= omp_get_thread_num();
+        const size_t nnz= Arow[num_rows],
+            r_begin= std::lower_bound( Arow, Arow + num_rows, (tid*nnz)/nt) - Arow,
+            r_end= tid + 1 == nt ? num_rows : std::lower_bound( Arow, Arow + num_rows, ((tid + 1)*nnz)/nt) - Arow;
+        T* const yt= tid == 0 ? y : buf + (tid - 1)*num_cols;
+        if (tid > 0)
+            std::fill( yt, yt + num_cols, T());
+        for (size_t i= r_begin; i < r_end; ++i) {
+            const T xrow= x[i];
+            for (size_t nz= Arow[i]; nz < Arow[i + 1]; ++nz)
+                yt[Acol[nz]]+= Aval[nz]*xrow;
+        }
+#       pragma omp barrier
+        size_t c_begin, c_end;
+        static_chunk( num_cols, nt, tid, c_begin, c_end);
+        for (Uint t= 1; t < nt; ++t) {
+            const T* const bt= buf + (t - 1)*num_cols;
+            for (size_t j= c_begin; j < c_end; ++j)
+                y[j]+= bt[j];
+        }
+    }
+    delete[] buf;
+#endif
+}
+
 template <typename _MatEntry, typename _VecEntry>
 VectorBaseCL<_VecEntry> transp_mul (const SparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& x)
 {
     VectorBaseCL<_VecEntry> ret( A.num_cols());
     Assert( A.num_rows()==x.size(), "transp_mul: incompatible dimensions", DebugNumericC);
-    y_ATx( &ret[0],
-           A.num_rows(),
-           A.raw_val(),
-           A.raw_row(),
-           A.raw_col(),
-           Addr( x));
+    switch (A.GetTranspMul()) {
+      case ExplicitTranspMul: {
+        const SparseMatBaseCL<_MatEntry>& AT= A.GetTranspose();
+        if (AT.num_rows() > 0)
+            y_Ax( &ret[0], AT.num_rows(), AT.raw_val(), AT.raw_row(), AT.raw_col(), Addr( x));
+        break;
+      }
+      case PrivateTranspMul:
+        y_ATx_private( Addr( ret), A.num_rows(), A.num_cols(), A.raw_val(), A.raw_row(), A.raw_col(), Addr( x));
+        break;
+      default:
+        y_ATx( &ret[0],
+               A.num_rows(),
+               A.raw_val(),
+               A.raw_row(),
+               A.raw_col(),
+               Addr( x));
+    }
     return ret;
 }
 
@@ -1543,6 +2307,8 @@ class MLSparseMatBaseCL : public MLDataCL<SparseMatBaseCL<T> >
 
     VectorBaseCL<T> GetDiag() const { return this->GetFinest().GetDiag(); }
     void clear() { for (ML_iterator it = this->begin(); it != this->end(); ++it) it->clear();}
+    /// \brief Select the algorithm of transp_mul on all levels
+    void SetTranspMul (TranspMulT m) { for (ML_iterator it = this->begin(); it != this->end(); ++it) it->SetTranspMul( m);}
 };
 
 template <typename T>
@@ -31,18 +31,18 @@ namespace DROPS {
 
 /// codes for Oseen solvers
 enum OseenSolverE {
-    GCR_OS= 1, iUzawa_OS= 2, MinRes_OS= 3, GMRes_OS= 4, GMResR_OS= 5, IDRs_OS= 7, StokesMGM_OS= 30
+    GCR_OS= 1, iUzawa_OS= 2, MinRes_OS= 3, GMRes_OS= 4, GMResR_OS= 5, RecycleGCR_OS= 6, IDRs_OS= 7, StokesMGM_OS= 30
 };
 
 /// codes for velocity preconditioners (also including smoothers for the StokesMGM_OS)
 enum APcE {
-    MG_APC= 1, MGsymm_APC= 2, PCG_APC= 3, GMRes_APC= 4, BiCGStab_APC= 5, VankaBlock_APC= 6, IDRs_APC=7, GS_GMRes_APC= 8, AMG_APC= 20, // preconditioners
+    MG_APC= 1, MGsymm_APC= 2, PCG_APC= 3, GMRes_APC= 4, BiCGStab_APC= 5, VankaBlock_APC= 6, IDRs_APC=7, GS_GMRes_APC= 8, AMG_APC= 20, FloatSSOR_GMRes_APC= 21, PipelinedPCG_APC= 22, CGS2_GMRes_APC= 23, // preconditioners
     PVanka_SM= 30, BraessSarazin_SM= 31 // smoothers, nevertheless listed here
 };
 
 /// codes for the pressure Schur complement preconditioners
 enum SPcE {
-    ISBBT_SPC= 1, ISBBT_Stab_SPC = 11, NoPre_SPC=12, IsXstab_SPC = 13, IsXmod_SPC =14, MinComm_SPC= 2, ISPre_SPC= 3, ISMG_SPC= 7, BDinvBT_SPC= 5, SIMPLER_SPC=8, MSIMPLER_SPC=9, VankaSchur_SPC= 4, VankaBlock_SPC=6, ISNonlinear_SPC=10
+    ISBBT_SPC= 1, ISBBT_Stab_SPC = 11, NoPre_SPC=12, IsXstab_SPC = 13, IsXmod_SPC =14, ISBBT_AMG_SPC= 15, ISAMG_SPC= 16, ISPre_Float_SPC= 17, MinComm_SPC= 2, ISPre_SPC= 3, ISMG_SPC= 7, BDinvBT_SPC= 5, SIMPLER_SPC=8, MSIMPLER_SPC=9, VankaSchur_SPC= 4, VankaBlock_SPC=6, ISNonlinear_SPC=10
 };
 
 /// collects some information on the different Oseen solvers and preconditioners
@@ -55,6 +55,7 @@ struct StokesSolverInfoCL
             case MinRes_OS:    return "PMinRes";
             case GMRes_OS:     return "GMRes";
             case GMResR_OS:    return "GMResR";
+            case RecycleGCR_OS: return "GCR with recycling";
             case StokesMGM_OS: return "Stokes MG";
             case IDRs_OS:      return "IDR(s)";
             default:           return "unknown";
@@ -67,7 +68,10 @@ struct StokesSolverInfoCL
             case PCG_APC:          return "PCG iterations";
             case GMRes_APC:        return "Jacobi-GMRes iterations";
             case BiCGStab_APC:     return "BiCGStab iterations";
-            case AMG_APC:          return "algebraic multigrid";
+            case AMG_APC:          return "smoothed aggregation AMG-GMRes iterations";
+            case FloatSSOR_GMRes_APC: return "SSOR-GMRes iterations with single precision matrix";
+            case PipelinedPCG_APC: return "pipelined PCG iterations";
+            case CGS2_GMRes_APC:   return "Jacobi-GMRes iterations with CGS2 orthogonalization and fused reductions";
             case VankaBlock_APC:   return "block Vanka";
             case PVanka_SM:        return "Vanka smoother";
             case BraessSarazin_SM: return "Braess-Sarazin smoother";
@@ -86,6 +90,9 @@ struct StokesSolverInfoCL
             case IsXmod_SPC:       return "IsXmod (Cahouet-Chabard for ghost penalty) no kernel consideration";
             case ISNonlinear_SPC:  return "ISNonlinearPreCL (Cahouet-Chabard)";
             case ISMG_SPC:         return "ISMGPre (multigrid Cahouet-Chabard)";
+            case ISBBT_AMG_SPC:    return "ISBBT (modified Cahouet-Chabard) with AMG for BB^T";
+            case ISAMG_SPC:        return "ISMGPre (Cahouet-Chabard) with AMG";
+            case ISPre_Float_SPC:  return "ISPre (Cahouet-Chabard) with single precision matrices";
             case BDinvBT_SPC:      return "B D^-1 B^T";
             case SIMPLER_SPC:      return "SIMPLER";
             case MSIMPLER_SPC:     return "MSIMPLER";
@@ -117,17 +124,29 @@ struct StokesSolverInfoCL
     <tr><td>  3 </td><td> MinRes            </td><td> PCG                                </td><td> ISPreCL                      </td></tr>
     <tr><td>  4 </td><td> GMRes             </td><td> Jacobi-GMRes                       </td><td> VankaSchurPreCL              </td></tr>
     <tr><td>  5 </td><td> GMResR            </td><td> BiCGStab                           </td><td> BD^{-1}BT                    </td></tr>
-    <tr><td>  6 </td><td>                   </td><td> VankaPre                           </td><td> VankaPre                     </td></tr>
+    <tr><td>  6 </td><td> GCR, recycling    </td><td> VankaPre                           </td><td> VankaPre                     </td></tr>
     <tr><td>  7 </td><td> IDR(s)            </td><td> IDR(s)                             </td><td> ISMGPreCL                    </td></tr>
     <tr><td>  8 </td><td>                   </td><td> Gauss-Seidel-GMRes                 </td><td> SIMPLER                      </td></tr>
     <tr><td>  9 </td><td>                   </td><td>                                    </td><td> MSIMPLER                     </td></tr>
     <tr><td> 11 </td><td>                   </td><td>                                    </td><td> ISBBT_Stab_PreCL             </td></tr>
     <tr><td> 12 </td><td>                   </td><td>                                    </td><td> NoPreCL                      </td></tr>
     <tr><td> 13 </td><td>                   </td><td>                                    </td><td> IsXstabPreCL                 </td></tr>
-    <tr><td> 20 </td><td>                   </td><td> HYPRE-AMG                          </td><td>                              </td></tr>
+    <tr><td> 15 </td><td>                   </td><td>                                    </td><td> ISBBTPreCL with AMGPcCL      </td></tr>
+    <tr><td> 16 </td><td>                   </td><td>                                    </td><td> ISMGPreCL with AMGPcCL       </td></tr>
+    <tr><td> 17 </td><td>                   </td><td>                                    </td><td> ISPreCL, float matrices      </td></tr>
+    <tr><td> 20 </td><td>                   </td><td> AMGPcCL-GMRes                      </td><td>                              </td></tr>
+    <tr><td> 21 </td><td>                   </td><td> SSOR-GMRes, float matrix           </td><td>                              </td></tr>
+    <tr><td> 22 </td><td>                   </td><td> pipelined PCG                      </td><td>                              </td></tr>
+    <tr><td> 23 </td><td>                   </td><td> Jacobi-GMRes, CGS2, fused reductions </td><td>                              </td></tr>
     <tr><td> 30 </td><td> StokesMGM         </td><td> PVankaSmootherCL                   </td><td> PVankaSmootherCL             </td></tr>
     <tr><td> 31 </td><td>                   </td><td> BSSmootherCL                       </td><td> BSSmootherCL                 </td></tr>
-    </table>*/
+    </table>
+    AMGPcCL is the smoothed aggregation algebraic multigrid from num/amg.h; it needs neither a hierarchy of triangulations nor prolongations.
+    The preconditioners with float matrices (FloatPcCL in num/precond.h) read single precision copies of the matrices; the vectors stay in double precision.
+    GCR with recycling (RecycleGCRSolverCL) keeps Stokes.RecycleDim search directions from one solve to the next.
+    Pipelined PCG (num/krylovsolver.h) overlaps its single global reduction per iteration with the preconditioner and the matrix-vector product.
+    CGS2-GMRes fuses the inner products of an iteration into a single blocking reduction; it does not overlap it with other work.
+    Both are meant for runs on many processes.*/
 template <class StokesT, class ProlongationVelT= MLDataCL<ProlongationCL<Point3DCL> >, class ProlongationPT= MLDataCL<ProlongationCL<double> > >
 class StokesSolverFactoryBaseCL
 {
@@ -200,7 +219,11 @@ class StokesSolverFactoryCL : public StokesSolverFactoryBaseCL<StokesT, Prolonga
     JACPcCL  JACPc_;
     GSPcCL   GSPc_;
 #ifndef _PAR
+#  if DROPS_MULTICOLOR_SMOOTHERS
+    typedef MCSSORPcCL    SymmPcPcT;
+#  else
     typedef SSORPcCL      SymmPcPcT;
+#  endif
 #else
     //typedef ChebyshevPcCL SymmPcPcT;
     typedef JACPcCL  SymmPcPcT;
@@ -228,6 +251,8 @@ class StokesSolverFactoryCL : public StokesSolverFactoryBaseCL<StokesT, Prolonga
 #ifdef _PAR
     typedef MLSmootherCL<ChebyshevsmoothCL> SmootherT;
     //typedef MLSmootherCL<JORsmoothCL> SmootherT;
+#elif DROPS_MULTICOLOR_SMOOTHERS
+    typedef MLSmootherCL<MCSSORsmoothCL> SmootherT;
 #else
     typedef MLSmootherCL<SSORsmoothCL> SmootherT;
 #endif
@@ -273,6 +298,32 @@ class StokesSolverFactoryCL : public StokesSolverFactoryBaseCL<StokesT, Prolonga
     typedef SolverAsPreCL<IDRsSolverT> IDRsPcT;
     IDRsPcT IDRsPc_;
 
+    //AMG-GMRes
+    AMGPcCL AMGPcA_;
+    typedef GMResSolverCL<AMGPcCL> AMGSolverT;
+    AMGSolverT AMGSolver_;
+    typedef SolverAsPreCL<AMGSolverT> AMGPcT;
+    AMGPcT AMGPc_;
+
+    //SSOR-GMRes with single precision matrix
+    FloatSSORPcCL FloatSSORPc_;
+    typedef GMResSolverCL<FloatSSORPcCL> FloatSSOR_GMResSolverT;
+    FloatSSOR_GMResSolverT FloatSSOR_GMResSolver_;
+    typedef SolverAsPreCL<FloatSSOR_GMResSolverT> FloatSSOR_GMResPcT;
+    FloatSSOR_GMResPcT FloatSSOR_GMResPc_;
+
+    //pipelined PCG
+    typedef PipelinedPCGSolverCL<SymmPcPcT> PipelinedPCGSolverT;
+    PipelinedPCGSolverT PipelinedPCGSolver_;
+    typedef SolverAsPreCL<PipelinedPCGSolverT> PipelinedPCGPcT;
+    PipelinedPCGPcT PipelinedPCGPc_;
+
+    //JAC-GMRes with CGS2
+    typedef CGS2GMResSolverCL<JACPcCL> CGS2_GMResSolverT;
+    CGS2_GMResSolverT CGS2_GMResSolver_;
+    typedef SolverAsPreCL<CGS2_GMResSolverT> CGS2_GMResPcT;
+    CGS2_GMResPcT CGS2_GMResPc_;
+
 // Block PC for Oseen problem
     typedef BlockPreCL<ExpensivePreBaseCL, SchurPreBaseCL, DiagSpdBlockPreCL>  DiagBlockPcT;
     typedef BlockPreCL<ExpensivePreBaseCL, SchurPreBaseCL, LowerBlockPreCL>    LowerBlockPcT;
@@ -294,6 +345,11 @@ class StokesSolverFactoryCL : public StokesSolverFactoryBaseCL<StokesT, Prolonga
     GCR_SBlockT *GCRSBlock_;
     GCR_VankaT  *GCRVanka_;
 
+//GCR solver with recycling
+    typedef RecycleGCRSolverCL<LowerBlockPcT> RecycleGCR_LBlockT;
+
+    RecycleGCR_LBlockT *RecycleGCRLBlock_;
+
 //GMRes solver
     typedef GMResSolverCL<LowerBlockPcT> GMRes_LBlockT;
     typedef GMResSolverCL<VankaPreCL>    GMRes_VankaT;
@@ -403,11 +459,16 @@ StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::
         BiCGStabSolver_( JACPc_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), /*rel*/ true),BiCGStabPc_( BiCGStabSolver_),
         PCGSolver_( symmPcPc_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), true), PCGPc_( PCGSolver_),
         IDRsSolver_( JACPc_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), true), IDRsPc_( IDRsSolver_),
+        AMGSolver_( AMGPcA_, /*restart*/ 100, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), /*rel*/ true), AMGPc_( AMGSolver_),
+        FloatSSOR_GMResSolver_( FloatSSORPc_, /*restart*/ 100, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), /*rel*/ true), FloatSSOR_GMResPc_( FloatSSOR_GMResSolver_),
+        PipelinedPCGSolver_( symmPcPc_, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), true), PipelinedPCGPc_( PipelinedPCGSolver_),
+        CGS2_GMResSolver_( JACPc_, /*restart*/ 100, P.get<int>("Stokes.PcAIter"), P.get<double>("Stokes.PcATol"), /*rel*/ true), CGS2_GMResPc_( CGS2_GMResSolver_),
         // block precondtioner
         DBlock_(0), LBlock_(0), SBlock_(0),
         vankapc_( &Stokes.pr_idx),
         // GCR solver
         GCRLBlock_(0), GCRSBlock_(0), GCRVanka_(0),
+        RecycleGCRLBlock_(0),
         // GMRes solver
         GMResLBlock_(0),  GMResVanka_(0),
         GMResRLBlock_(0), GMResRVanka_(0),
@@ -424,6 +485,10 @@ StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::
         gcrsolver_( DiagGMResMinCommPc_, 500, 500, 1e-6, true), coarse_blockgcrsolver_(gcrsolver_),
         vankasmoother_( 0, 0.8, &Stokes.pr_idx)
 {
+    // Reuse the multigrid setup over several solves, cf. MGSolverCL::SetReuse.
+    const double mgreuse= P.get<double>("Stokes.PcAMGReuse", 0.);
+    MGSolversymm_.SetReuse( mgreuse);
+    MGSolver_.SetReuse( mgreuse);
     apc_= CreateAPc();
     spc_= CreateSPc();
 }
@@ -436,6 +501,7 @@ StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::
     delete GMResRVanka_; delete GMResRLBlock_;
     delete GMResVanka_; delete GMResLBlock_;
     delete GCRVanka_; delete GCRLBlock_; delete GCRSBlock_;
+    delete RecycleGCRLBlock_;
     delete SBlock_; delete LBlock_; delete DBlock_;
     delete IDRsVanka_; delete IDRsLBlock_;
 }
@@ -460,11 +526,15 @@ bool StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::ValidSolv
         msg= "block preconditioner not allowed for inexact Uzawa";
     else if (OseenSolver_==MinRes_OS && (StokesSolverInfoCL::IsBlockPre(APc_) || StokesSolverInfoCL::IsBlockPre(SPc_) ))
         msg= "MinRes requires diagonal block preconditioner";
+    else if (OseenSolver_==RecycleGCR_OS && (StokesSolverInfoCL::IsBlockPre(APc_) || StokesSolverInfoCL::IsBlockPre(SPc_) ))
+        msg= "GCR with recycling is only implemented for the lower block triangular preconditioner";
     else if ((StokesSolverInfoCL::IsBlockPre(APc_) || StokesSolverInfoCL::IsBlockPre(SPc_)) && !StokesSolverInfoCL::EqualStokesMGSmoother( APc_, SPc_) && SPc_!=SIMPLER_SPC && SPc_!=MSIMPLER_SPC)
         msg= "block preconditioner should be the same for vel and pr part";
 #ifdef _PAR
-    else if (APc_ == GS_GMRes_APC)
+    else if (APc_ == GS_GMRes_APC || APc_ == FloatSSOR_GMRes_APC)
         msg= "Gauss-Seidel is not available in parallel, yet";
+    else if (APc_ == AMG_APC || SPc_ == ISBBT_AMG_SPC || SPc_ == ISAMG_SPC)
+        msg= "AMGPcCL is not available in parallel, yet";
 #endif
     else // all tests passed successfully
         ok= true;
@@ -493,6 +563,10 @@ ExpensivePreBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, Prolongatio
         case GS_GMRes_APC: return &GS_GMResPc_;
         case BiCGStab_APC: return &BiCGStabPc_;
         case IDRs_APC:     return &IDRsPc_;
+        case AMG_APC:      return &AMGPc_;
+        case FloatSSOR_GMRes_APC: return &FloatSSOR_GMResPc_;
+        case PipelinedPCG_APC: return &PipelinedPCGPc_;
+        case CGS2_GMRes_APC:   return &CGS2_GMResPc_;
         default:           return 0;
     }
 }
@@ -508,6 +582,9 @@ SchurPreBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>
         case IsXstab_SPC:    return &isxstabpc_;
         case IsXmod_SPC:     return &isxprmodpc_;
         case ISMG_SPC:       return &ismgpre_;
+        case ISBBT_AMG_SPC:  bbtispc_.SetAMG( true); return &bbtispc_;
+        case ISAMG_SPC:      ismgpre_.SetAMG( true); return &ismgpre_;
+        case ISPre_Float_SPC:isprepc_.SetFloat( true); return &isprepc_;
         case SIMPLER_SPC:
         case MSIMPLER_SPC:
         case BDinvBT_SPC:    return &bdinvbtispc_;
@@ -570,6 +647,14 @@ StokesSolverBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, Prolongatio
         }
         break;
 
+        case RecycleGCR_OS: {
+            LBlock_= new LowerBlockPcT( *apc_, *spc_);
+            RecycleGCRLBlock_= new RecycleGCR_LBlockT( *LBlock_,  P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.RecycleDim", 10),
+                P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), /*rel*/  P_.template get<bool>("Stokes.relTol",false));
+            stokessolver= new BlockMatrixSolverCL<RecycleGCR_LBlockT>( *RecycleGCRLBlock_);
+        }
+        break;
+
         case GMRes_OS: {
             if (APc_==VankaBlock_APC) {
                 GMResVanka_= new GMRes_VankaT( vankapc_,  P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), /*rel*/ false, false, RightPreconditioning);
@@ -494,6 +494,33 @@ double ExchangeCL::Norm( const VectorCL& x, bool isXacc, VectorCL* x_acc) const
     return std::sqrt(Norm_sq(x, isXacc, x_acc));
 }
 
+void ExchangeCL::GlobalSum( double* vals, int n) const
+/** Sum the \a n local values \a vals over all processes. On exit, \a vals
+    contains the sums over all processes.*/
+{
+    std::vector<double> sums( n);
+    ProcCL::GlobalSum( vals, &sums[0], n);
+    std::copy( sums.begin(), sums.end(), vals);
+}
+
+void ExchangeCL::StartGlobalSum( double* vals, int n) const
+/** Start the summation of the \a n local values \a vals over all processes
+    without blocking. Computations, which do not depend on the result, e.g.,
+    a matrix-vector product, can be performed until WaitGlobalSum is called;
+    \a vals must not be accessed in between. Only one reduction per ExchangeCL
+    can be pending.
+*/
+{
+    sumreq_= ProcCL::IAllReduce( vals, n, MPI_SUM_Operation);
+}
+
+void ExchangeCL::WaitGlobalSum() const
+/** Wait for the reduction started by StartGlobalSum. On exit, the values
+    given to StartGlobalSum contain the sums over all processes.*/
+{
+    ProcCL::Wait( sumreq_);
+}
+
 void ExchangeCL::CreateList( const MultiGridCL& mg, IdxDescCL* rowidx, bool, bool)
 /** Build the internal data structures to be able to provide the
     functionality of this class.
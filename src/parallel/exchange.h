@@ -82,6 +82,12 @@ class DummyExchangeCL
     double Norm( const VectorCL& x, bool is_acc, VectorCL* x_acc=0) const{
         return std::sqrt(LocalNorm_sq(x, is_acc, x_acc));
     }
+    /// \brief Sum local values over all processes; nothing to do in the serial case
+    void GlobalSum( double*, int) const {}
+    /// \brief Start the reduction of local sums over all processes; nothing to do in the serial case
+    void StartGlobalSum( double*, int) const {}
+    /// \brief Wait for the reduction started by StartGlobalSum
+    void WaitGlobalSum() const {}
 };
 
 class DummyExchangeBlockCL : public DummyExchangeCL
@@ -274,6 +280,8 @@ class ExchangeCL
 
     /// \brief Receive buffers two vectors x and y
     mutable BufferListT xBuf_, yBuf_;
+    /// \brief Request of the pending reduction started by StartGlobalSum
+    mutable ProcCL::RequestT sumreq_;
 
     NeighListT   neighs_;                                   ///< neighbor processes
     DOFProcListT dofProcList_;                              ///< storing information about distributed dof
@@ -332,6 +340,12 @@ class ExchangeCL
     double Norm_sq( const VectorCL&, bool, VectorCL* x_acc=0) const;
     /// \brief Parallel Euclidian norm with final reduction over all processes
     double Norm( const VectorCL&, bool, VectorCL* x_acc=0) const;
+    /// \brief Blocking reduction of \a n local sums over all processes; afterwards, vals contains the global sums
+    void GlobalSum( double* vals, int n) const;
+    /// \brief Start the non-blocking reduction of \a n local sums over all processes
+    void StartGlobalSum( double* vals, int n) const;
+    /// \brief Wait for the reduction started by StartGlobalSum; afterwards, vals contains the global sums
+    void WaitGlobalSum() const;
 
     /// \name Get information about neighbor processes
     //@{
@@ -448,6 +462,12 @@ class ExchangeBlockCL
     double Norm_sq( const VectorCL&, bool, VectorCL* x_acc=0) const;
     /// \brief Parallel Euclidian norm with final reduction over all processes
     double Norm( const VectorCL&, bool, VectorCL* x_acc=0) const;
+    /// \brief Blocking reduction of \a n local sums over all processes
+    void GlobalSum( double* vals, int n) const { exchange_[0]->GlobalSum( vals, n); }
+    /// \brief Start the non-blocking reduction of \a n local sums over all processes
+    void StartGlobalSum( double* vals, int n) const { exchange_[0]->StartGlobalSum( vals, n); }
+    /// \brief Wait for the reduction started by StartGlobalSum
+    void WaitGlobalSum() const { exchange_[0]->WaitGlobalSum(); }
 };
 
 
@@ -134,6 +134,9 @@ class ProcCL
       /// \brief MPI-Allreduce-wrapper
     template <typename T>
     static inline void AllReduce(const T*, T*, int, const OperationT&);
+      /// \brief MPI-Iallreduce-wrapper; the reduction is performed in place
+    template <typename T>
+    static inline RequestT IAllReduce(T*, int, const OperationT&);
       /// \brief MPI-Gather-wrapper or MPI-Allgather-wrapper if root<0 (both data-types are the same)
     template <typename T>
     static inline void Gather(const T*, T*, int, int root);
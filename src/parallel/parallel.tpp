@@ -93,6 +93,14 @@ template <typename T>
   inline void ProcCL::AllReduce(const T* myData, T* globalData, int size, const ProcCL::OperationT& op)
   { Communicator_.Allreduce(myData, globalData, size, ProcCL::MPI_TT<T>::dtype, op); }
 
+template <typename T>
+  inline ProcCL::RequestT ProcCL::IAllReduce(T* data, int size, const ProcCL::OperationT& op)
+{   // non-blocking collectives are not part of the C++-bindings
+    MPI_Request req;
+    MPI_Iallreduce(MPI_IN_PLACE, data, size, ProcCL::MPI_TT<T>::dtype, op, Communicator_, &req);
+    return RequestT(req);
+}
+
 template <typename T>
   inline void ProcCL::Gather(const T* myData, T* globalData, int size, int root)
 {
@@ -203,6 +211,14 @@ template <typename T>
   inline void ProcCL::AllReduce(const T* myData, T* globalData, int size, const ProcCL::OperationT& op)
   { MPI_Allreduce(const_cast<T*>(myData), globalData, size, ProcCL::MPI_TT<T>::dtype, op, Communicator_); }
 
+template <typename T>
+  inline ProcCL::RequestT ProcCL::IAllReduce(T* data, int size, const ProcCL::OperationT& op)
+{
+    RequestT req;
+    MPI_Iallreduce(MPI_IN_PLACE, data, size, ProcCL::MPI_TT<T>::dtype, op, Communicator_, &req);
+    return req;
+}
+
 template <typename T>
   inline void ProcCL::Gather(const T* myData, T* globalData, int size, int root)
 {
@@ -52,6 +52,10 @@ class Accumulator_P1CL : public TetraAccumulatorCL
     double coup[4][4];
     QuadCL<> U_Grad[4];
 
+    // - blocks of tetras, see visit_block
+    double T_block[3][3][TetraBlockSizeC];
+    double det_block[TetraBlockSizeC];
+
     const Uint lvl;
     const Uint idx;
 
@@ -179,6 +183,8 @@ class SourceAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
     void local_setup (const TetraCL& tet);
     void update_rhsintegrals(const TetraCL& tet);
     void visit (const TetraCL& tet);
+    /// \brief The tetras of a block are visited one by one; this allows the other accumulators of the tuple to work on blocks.
+    size_t block_size () const { return TetraBlockSizeC; }
     virtual TetraAccumulatorCL* clone (int /*tid*/) { return new SourceAccumulator_P1CL ( *this); }
 };
 
@@ -270,14 +276,21 @@ class StiffnessAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
     using                           base_::lvl;
     using                           base_::idx;
     using                           base_::t;
+    using                           base_::T_block;
+    using                           base_::det_block;
     SUPGCL& supg_;
     bool   ALE_;
+    double G_block[4][3][TetraBlockSizeC];
+    double diff_block[4][4][TetraBlockSizeC];
   public:
     StiffnessAccumulator_P1CL(const MultiGridCL& MG, const BndDataCL<> * BndData, MatrixCL* Amat, VecDescCL* b,
             IdxDescCL& RowIdx, IdxDescCL& ColIdx, SUPGCL& supg, bool ALE, const double t_)
         : Accumulator_P1CL<Coeff,QuadCL>(MG,BndData,Amat,b,RowIdx,ColIdx,t_),supg_(supg), ALE_(ALE){}
     void local_setup (const TetraCL& tet);
     void visit (const TetraCL& tet);
+    /// \brief Without SUPG and ALE, the diffusion part of the tetras of a block is computed in structure-of-arrays layout.
+    size_t block_size () const { return supg_.GetSUPG() || ALE_ ? 1 : TetraBlockSizeC; }
+    void visit_block (const TetraCL* const* t, size_t n);
     virtual TetraAccumulatorCL* clone (int /*tid*/) { return new StiffnessAccumulator_P1CL ( *this); }
 
 };
@@ -335,6 +348,35 @@ void StiffnessAccumulator_P1CL<Coeff,QuadCL>::local_setup (const TetraCL& tet)
     }
 }
 
+template<class Coeff,template <class T=double> class QuadCL>
+void StiffnessAccumulator_P1CL<Coeff,QuadCL>::visit_block (const TetraCL* const* tet, size_t n)
+{
+    GetTrafoTr( T_block, det_block, tet, n);
+    P1DiscCL::GetGradients( G_block, T_block);
+    for(int i=0; i<4; ++i)
+        for(int j=0; j<4; ++j)
+            for (Uint l= 0; l < TetraBlockSizeC; ++l)
+                diff_block[i][j][l]= Coeff::alpha*(G_block[i][0][l]*G_block[j][0][l] + G_block[i][1][l]*G_block[j][1][l]
+                                                   + G_block[i][2][l]*G_block[j][2][l])/6.0*std::fabs( det_block[l]);
+    double q[5];
+    for (size_t l= 0; l < n; ++l) {
+        absdet= std::fabs( det_block[l]);
+        for (int k= 0; k < 5; ++k)
+            q[k]= Coeff::q( *tet[l], Quad2DataCL::Node[k], 0.0);
+        for(int i=0; i<4; ++i)
+        {
+            for(int j=0; j<4; ++j)
+                coup[i][j]= diff_block[i][j][l] + P1DiscCL::Quad( q, i, j)*absdet;
+            UnknownIdx[i]= tet[l]->GetVertex(i)->Unknowns.Exist(idx) ? tet[l]->GetVertex(i)->Unknowns(idx)
+                    : NoIdx;
+        }
+        if (A_ != 0)
+            base_::update_global_matrix();
+        if (b_ != 0 && BndData_ != 0)
+            base_::update_coupling( *tet[l]);
+    }
+}
+
 
 
 // mass matrix: \int_{\Omega} \alpha u  v \, dx
@@ -361,6 +403,8 @@ class MassAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
     using                           base_::lvl;
     using                           base_::idx;
     using                           base_::t;
+    using                           base_::T_block;
+    using                           base_::det_block;
     SUPGCL& supg_;
     bool   ALE_;
     double tSUPG_;
@@ -370,6 +414,9 @@ class MassAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
         : Accumulator_P1CL<Coeff,QuadCL>(MG,BndData,Amat,b,RowIdx,ColIdx,t),supg_(supg), ALE_(ALE), tSUPG_(tSUPG){}
     void local_setup (const TetraCL& tet);
     void visit (const TetraCL& tet);
+    /// \brief Without SUPG and ALE, the determinants of the tetras of a block are computed in structure-of-arrays layout.
+    size_t block_size () const { return supg_.GetSUPG() || ALE_ ? 1 : TetraBlockSizeC; }
+    void visit_block (const TetraCL* const* t, size_t n);
     virtual TetraAccumulatorCL* clone (int /*tid*/) { return new MassAccumulator_P1CL ( *this); }
 };
 
@@ -421,6 +468,25 @@ void MassAccumulator_P1CL<Coeff,QuadCL>::local_setup (const TetraCL& tet)
     }
 }
 
+template<class Coeff,template <class T=double> class QuadCL>
+void MassAccumulator_P1CL<Coeff,QuadCL>::visit_block (const TetraCL* const* tet, size_t n)
+{
+    GetTrafoTr( T_block, det_block, tet, n);
+    for (size_t l= 0; l < n; ++l) {
+        absdet= std::fabs( det_block[l]);
+        for(int i=0; i<4; ++i)
+        {
+            for(int j=0; j<4; ++j)
+                coup[i][j]= P1DiscCL::GetMass( i, j)*absdet;
+            UnknownIdx[i]= tet[l]->GetVertex(i)->Unknowns.Exist(idx) ? tet[l]->GetVertex(i)->Unknowns(idx) : NoIdx;
+        }
+        if (A_ != 0)
+            base_::update_global_matrix();
+        if (b_ != 0 && BndData_ != 0)
+            base_::update_coupling( *tet[l]);
+    }
+}
+
 // Convection matrix: \int_{\Omega} w \nabla u v \, dx
 template<class Coeff,template <class T=double> class QuadCL>
 class ConvectionAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
@@ -453,6 +519,8 @@ class ConvectionAccumulator_P1CL : public Accumulator_P1CL<Coeff,QuadCL>
         : Accumulator_P1CL<Coeff,QuadCL>(MG,BndData,Amat,b,RowIdx,ColIdx,t_), ALE_(ALE), adjoint(adjoint_){}
     void local_setup (const TetraCL& sit);
     void visit (const TetraCL& sit);
+    /// \brief The tetras of a block are visited one by one; this allows the other accumulators of the tuple to work on blocks.
+    size_t block_size () const { return TetraBlockSizeC; }
     virtual TetraAccumulatorCL* clone (int /*tid*/) { return new ConvectionAccumulator_P1CL ( *this); }
 
 
@@ -181,8 +181,8 @@ class System2Accumulator_P2P1XCL : public System2Accumulator_P2P1CL<TwoPhaseFlow
     LocalP2CL<double>         local_p2_lset;
     std::valarray<double>     ls_loc_;
     int                       ls_sign_[4];
-    TetraPartitionCL          partition_;
-    QuadDomainCL              q2dom_;
+    InterfaceCutCacheCL&      cutcache_;
+    const QuadDomainCL*       q2dom_;        ///< composite quadrature domain of degree 2 from cutcache_
     GridFunctionCL<Point3DCL> qgrad_[10];
     LocalP1CL<Point3DCL>      GradRefLP1_[10],
                               GradLP1_[10];
@@ -220,7 +220,8 @@ class System2Accumulator_P2P1XCL : public System2Accumulator_P2P1CL<TwoPhaseFlow
 System2Accumulator_P2P1XCL::System2Accumulator_P2P1XCL (const TwoPhaseFlowCoeffCL& coeff_arg, const StokesBndDataCL& BndData_arg,
         const LevelsetP2CL& lset, const IdxDescCL& RowIdx_arg, const IdxDescCL& ColIdx_arg,
         MatrixCL& B_arg, VecDescCL* c_arg, double t_arg)
-    :  base_( coeff_arg, BndData_arg, RowIdx_arg, ColIdx_arg, B_arg, c_arg, t_arg), lset_( lset), ls_loc_( lat.vertex_size()), speBndHandle(BndData_arg)
+    :  base_( coeff_arg, BndData_arg, RowIdx_arg, ColIdx_arg, B_arg, c_arg, t_arg), lset_( lset), ls_loc_( lat.vertex_size()),
+       cutcache_( lset.GetCutCache()), q2dom_( 0), speBndHandle(BndData_arg)
 {
     P2DiscCL::GetGradientsOnRef( GradRefLP1_);
 }
@@ -240,10 +241,10 @@ void System2Accumulator_P2P1XCL::visit (const TetraCL& tet)
 {
     base_::visit( tet);
     evaluate_on_vertexes( lset_.GetSolution(), tet, lat, Addr( ls_loc_));
-    if (equal_signs( ls_loc_)) return; // extended basis functions have only support on tetra intersecting Gamma.
+    CutDataCL* cut= cutcache_.Get( tet, lat, ls_loc_);
+    if (cut == 0) return; // extended basis functions have only support on tetra intersecting Gamma.
 
-    partition_.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc_);
-    make_CompositeQuad2Domain( q2dom_, partition_);
+    q2dom_= &cut->quad2_domain();
     local_p2_lset.assign(tet, *lset_.PhiC, lset_.GetBndData());
 
     local_setup(tet);
@@ -254,7 +255,7 @@ void System2Accumulator_P2P1XCL::local_setup (const TetraCL& tet)
 {
     P2DiscCL::GetGradients( GradLP1_, GradRefLP1_, T);
     for (int i= 0; i < 10; ++i) // Gradients of the velocity hat-functions
-        resize_and_evaluate_on_vertexes(  GradLP1_[i], q2dom_, qgrad_[i]);
+        resize_and_evaluate_on_vertexes(  GradLP1_[i], *q2dom_, qgrad_[i]);
 
     for (int i= 0; i < 4; ++i) // sign of the level-set function in the vertices
         ls_sign_[i]= sign(local_p2_lset[i]);
@@ -270,12 +271,12 @@ void System2Accumulator_P2P1XCL::local_setup (const TetraCL& tet)
         const IdxT xidx= (*Xidx_)[prNumb[pr]];
         if (xidx==NoIdx) continue;
 
-        resize_and_evaluate_on_vertexes( p1, q2dom_, qpr);
+        resize_and_evaluate_on_vertexes( p1, *q2dom_, qpr);
         for(int vel=0; vel<10; ++vel) {
             const bool is_pos= ls_sign_[pr] == 1;
             // for C=0 (<=> !is_pos) we have I = -\int_{T_-} grad v_vel p_pr dx
             // for C=1 (<=>  is_pos) we have I =  \int_{T_+} grad v_vel p_pr dx
-            loc_B_[pr][vel]= SMatrixCL<1,3>( (is_pos ? -1. : 1.)*quad( qgrad_[vel]*qpr, absdet, q2dom_, is_pos ? NegTetraC : PosTetraC));
+            loc_B_[pr][vel]= SMatrixCL<1,3>( (is_pos ? -1. : 1.)*quad( qgrad_[vel]*qpr, absdet, *q2dom_, is_pos ? NegTetraC : PosTetraC));
         }
     }
 
@@ -856,6 +857,8 @@ class PrMassAccumulator_P1CL : public TetraAccumulatorCL
 
     std::valarray<double>     ls_loc_;
     TetraPartitionCL          partition_;
+    QuadDomainCL              q2dom_;
+    InterfaceCutCacheCL&      cutcache_;
 
     const IdxT num_unks_pr;
     MatrixBuilderCL* M_pr;
@@ -865,8 +868,9 @@ class PrMassAccumulator_P1CL : public TetraAccumulatorCL
     const double nu_inv_p, nu_inv_n;
     double integralp, integraln;
     InterfaceTetraCL cut;
-    LocalP2CL<> pipj[4][4];
+    SLocalP2CL<> pipj[4][4];
     LocalP2CL<> loc_phi;
+    std::vector<double> pp; ///< values of pipj on the quadrature points of a cut tetra; keeps its memory between the tetras
 
     bool useXFEM;
 
@@ -889,7 +893,7 @@ class PrMassAccumulator_P1CL : public TetraAccumulatorCL
 
 PrMassAccumulator_P1CL::PrMassAccumulator_P1CL (const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, MatrixCL& matM_, IdxDescCL& RowIdx_, const LevelsetP2CL& lset_, bool XFEM)
     : MG(MG_), lat( PrincipalLatticeCL::instance( 2)), Coeff(Coeff_), matM(matM_), RowIdx(RowIdx_),
-      lset(lset_), ls_loc_( lat.vertex_size()), num_unks_pr(RowIdx_.NumUnknowns()),
+      lset(lset_), ls_loc_( lat.vertex_size()), cutcache_( lset_.GetCutCache()), num_unks_pr(RowIdx_.NumUnknowns()),
       lvl(RowIdx_.TriangLevel()), nu_inv_p(1./Coeff_.mu( 1.0)), nu_inv_n(1./Coeff_.mu( -1.0)), useXFEM( XFEM)
 {
     for(int i= 0; i < 4; ++i) {
@@ -922,14 +926,8 @@ void PrMassAccumulator_P1CL::visit (const TetraCL& sit)
     cut.Init( sit, loc_phi);
     const bool nocut= !cut.Intersects();
     GetLocalNumbP1NoBnd( prNumb, sit, RowIdx);
-    GridFunctionCL<> pp;
-    QuadDomainCL q2dom_;
     bool sign[4];
 
-    evaluate_on_vertexes( lset.GetSolution(), sit, lat, Addr( ls_loc_));
-    partition_.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc_);
-    make_CompositeQuad2Domain( q2dom_, partition_);
-
     if (nocut) { // nu is constant in tetra
         const double nu_inv= cut.GetSign( 0) == 1 ? nu_inv_p : nu_inv_n;
         // write values into matrix
@@ -938,15 +936,22 @@ void PrMassAccumulator_P1CL::visit (const TetraCL& sit)
                 (*M_pr)( prNumb[i], prNumb[j])+= nu_inv*P1DiscCL::GetMass( i, j)*absdet;
     }
     else { // nu is discontinuous in tetra
+        evaluate_on_vertexes( lset.GetSolution(), sit, lat, Addr( ls_loc_));
+        CutDataCL* cutdata= cutcache_.Get( sit, lat, ls_loc_);
+        if (cutdata == 0) { // all values on the lattice vanish or have the same sign
+            partition_.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc_);
+            make_CompositeQuad2Domain( q2dom_, partition_);
+        }
+        const QuadDomainCL& q2dom= cutdata != 0 ? cutdata->quad2_domain() : q2dom_;
         for(int i=0; i<4; ++i) {
             sign[i]= cut.GetSign(i) == 1;
             for(int j=0; j<=i; ++j) {
                 // compute the integrals
                 // \int_{T_i} p_i p_j dx,    where T_i = T \cap \Omega_i, i=1,2
                 integralp= integraln= 0.;
-                resize_and_evaluate_on_vertexes( pipj[i][j], q2dom_, pp);
-                integralp = quad( pp , absdet , q2dom_ , PosTetraC);
-                integraln = quad( pp , absdet , q2dom_ , NegTetraC);
+                resize_and_evaluate_on_vertexes( pipj[i][j], q2dom, pp);
+                integralp = quad( pp , absdet , q2dom , PosTetraC);
+                integraln = quad( pp , absdet , q2dom , NegTetraC);
 
                 coup[j][i]= integralp*nu_inv_p + integraln*nu_inv_n;
                 coup[i][j]= coup[j][i];
@@ -2228,12 +2233,13 @@ class LocalSystem1OnePhase_P2CL
     double mu_;
     double rho_;
 
-    Quad2CL<Point3DCL> Grad[10], GradRef[10];
-    const SVectorCL<Quad2DataCL::NumNodesC> Ones;
+    SLocalP1CL<Point3DCL> Grad[10], GradRef[10]; ///< the gradients are linear; their values in the vertices suffice
+    double m[4][4];                              ///< mu times the P1 mass matrix of the tetra
+    SMatrixCL<3,3> GG[10][10];
 
   public:
     LocalSystem1OnePhase_P2CL (double muarg= 0., double rhoarg= 0.)
-        : mu_( muarg), rho_( rhoarg), Ones( 1.)
+        : mu_( muarg), rho_( rhoarg)
     { P2DiscCL::GetGradientsOnRef( GradRef); }
 
     void   mu  (double new_mu)        { mu_= new_mu; }
@@ -2246,15 +2252,20 @@ class LocalSystem1OnePhase_P2CL
 
 void LocalSystem1OnePhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, LocalSystem1DataCL& loc)
 {
+    // All integrals are those on the reference tetra, transformed with T and absdet; no quadrature is needed.
     P2DiscCL::GetGradients( Grad, GradRef, T);
+    for (Uint k= 0; k < 4; ++k)
+        for (Uint l= 0; l < 4; ++l)
+            m[k][l]= mu()*absdet*P1DiscCL::GetMass( k, l);
+    P2DiscCL::GetGradientProducts( GG, Grad, m);
     for (Uint i= 0; i < 10; ++i) {
-        loc.rho_phi[i]= rho()*quad( Ones, absdet, Quad2Data_Mul_P2_CL(), i);
+        loc.rho_phi[i]= rho()*P2DiscCL::GetLumpedMass( i)*absdet;
         for (Uint j= 0; j <= i; ++j) {
             // M: As we are not at the phase-boundary this is exact.
             loc.M[j][i]= rho()*P2DiscCL::GetMass( j, i)*absdet;
 
             // kreuzterm = \int mu * (dphi_i / dx_l) * (dphi_j / dx_k) = \int mu *\nabla\phi_i \outerprod \nabla\phi_j
-            loc.Ak[j][i]= mu()*quad( OuterProductExpressionCL( Grad[i], Grad[j]), absdet, make_Quad2Data());
+            loc.Ak[j][i]= GG[i][j];
             // dot-product of the gradients
             loc.A[j][i]= trace( loc.Ak[j][i]);
             if (i != j) { // The local matrices coupM, coupA, coupAk are symmetric.
@@ -2525,7 +2536,7 @@ class LocalSystem1TwoPhase_P2CL
     const double rho_p, rho_n;
     instat_vector_fun_ptr rhs_func;
 
-    LocalP1CL<Point3DCL> GradRefLP1[10], GradLP1[10];
+    SLocalP1CL<Point3DCL> GradRef[10], Grad[10];
     LocalP2CL<> p2;
 
     std::valarray<double> ls_loc;
@@ -2533,42 +2544,72 @@ class LocalSystem1TwoPhase_P2CL
     QuadDomainCL q2dom;
     QuadDomainCL q5dom;
     GridFunctionCL<double>    q[10];
-    GridFunctionCL<Point3DCL> qA[10];
     GridFunctionCL<Point3DCL> rhs;
+    double m[2][4][4]; ///< P1 mass matrices of the negative and the positive part
 
   public:
     LocalSystem1TwoPhase_P2CL (double mup, double mun, double rhop, double rhon, instat_vector_fun_ptr rhsFunc)
         : lat( PrincipalLatticeCL::instance( 2)), mu_p( mup), mu_n( mun), rho_p( rhop), rho_n( rhon), rhs_func(rhsFunc), ls_loc( lat.vertex_size())
-    { P2DiscCL::GetGradientsOnRef( GradRefLP1); }
+    { P2DiscCL::GetGradientsOnRef( GradRef); }
 
     double mu  (int sign) const { return sign > 0 ? mu_p  : mu_n; }
     double rho (int sign) const { return sign > 0 ? rho_p : rho_n; }
 
-    void setup (const SMatrixCL<3,3>& T, double absdet, const TetraCL& tet, const LocalP2CL<>& ls, double t, LocalIntegrals_P2CL[2], LocalSystem1DataCL& loc);
+    /// If cutcache is not 0, the composite quadrature domains are taken from the cache.
+    void setup (const SMatrixCL<3,3>& T, double absdet, const TetraCL& tet, const LocalP2CL<>& ls, double t, LocalIntegrals_P2CL[2], LocalSystem1DataCL& loc,
+        InterfaceCutCacheCL* cutcache= 0);
 };
 
-void LocalSystem1TwoPhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, const TetraCL& tet, const LocalP2CL<>& ls, double t, LocalIntegrals_P2CL locInt[2], LocalSystem1DataCL& loc)
+void LocalSystem1TwoPhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, const TetraCL& tet, const LocalP2CL<>& ls, double t, LocalIntegrals_P2CL locInt[2], LocalSystem1DataCL& loc,
+    InterfaceCutCacheCL* cutcache)
 {
-    P2DiscCL::GetGradients( GradLP1, GradRefLP1, T);
+    P2DiscCL::GetGradients( Grad, GradRef, T);
 
     evaluate_on_vertexes( ls, lat, Addr( ls_loc));
-    partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc);
-    make_CompositeQuad5Domain( q5dom, partition);
-    make_CompositeQuad2Domain( q2dom, partition);
-    resize_and_evaluate_on_vertexes( rhs_func, tet, q5dom, /*time*/ t, rhs);
+    CutDataCL* cut= cutcache != 0 ? cutcache->Get( tet, lat, ls_loc) : 0;
+    if (cut == 0) {
+        partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc);
+        make_CompositeQuad5Domain( q5dom, partition);
+        make_CompositeQuad2Domain( q2dom, partition);
+    }
+    const QuadDomainCL& q5= cut != 0 ? cut->quad5_domain() : q5dom;
+    const QuadDomainCL& q2= cut != 0 ? cut->quad2_domain() : q2dom;
+    resize_and_evaluate_on_vertexes( rhs_func, tet, q5, /*time*/ t, rhs);
+
+    // The polynomial integrands are only integrated on the part with fewer quadrature points;
+    // on the other part, they are the integrals on the reference tetra minus those on the first part.
+    const TetraSignEnum s= q5.vertex_size( NegTetraC) <= q5.vertex_size( PosTetraC) ? NegTetraC : PosTetraC;
+    const int part= s == NegTetraC ? 0 : 1, other= 1 - part;
+
+    // the gradients are linear: their products only need the P1 mass matrices of the parts
+    for (int k= 0; k < 4; ++k)
+        for (int l= 0; l < 4; ++l)
+            m[part][k][l]= 0.;
+    QuadDomainCL::const_weight_iterator w= q2.weight_begin( s);
+    for (QuadDomainCL::const_vertex_iterator v= q2.vertex_begin( s); v != q2.vertex_end( s); ++v, ++w)
+        for (int k= 0; k < 4; ++k)
+            for (int l= 0; l <= k; ++l)
+                m[part][k][l]+= *w*(*v)[k]*(*v)[l];
+    for (int k= 0; k < 4; ++k)
+        for (int l= 0; l <= k; ++l) {
+            m[part][l][k]= m[part][k][l]*= absdet;
+            m[other][l][k]= m[other][k][l]= absdet*P1DiscCL::GetMass( k, l) - m[part][k][l];
+        }
+    P2DiscCL::GetGradientProducts( locInt[0].cAk, Grad, m[0]);
+    P2DiscCL::GetGradientProducts( locInt[1].cAk, Grad, m[1]);
 
     for (int i= 0; i < 10; ++i) {
         p2[i]= 1.; p2[i==0 ? 9 : i - 1]= 0.;
-        resize_and_evaluate_on_vertexes( p2,         q5dom, q[i]); // for M
-        resize_and_evaluate_on_vertexes( GradLP1[i], q2dom, qA[i]); // for A
-        quad( q[i]*rhs, absdet, q5dom, locInt[0].rhs[i], locInt[1].rhs[i]); // for rhs
-        quad( q[i], absdet, q5dom, locInt[0].phi[i], locInt[1].phi[i]); // for rho_phi
+        resize_and_evaluate_on_vertexes( p2,         q5, q[i]); // for M
+        quad( make_ProductExpression( q[i], rhs), absdet, q5, locInt[0].rhs[i], locInt[1].rhs[i]); // for rhs
+        locInt[part].phi[i]= quad( q[i], absdet, q5, s); // for rho_phi
+        locInt[other].phi[i]= absdet*P2DiscCL::GetLumpedMass( i) - locInt[part].phi[i];
         loc.rho_phi[i]= rho_n*locInt[0].phi[i] + rho_p*locInt[1].phi[i];
     }
     for (int i= 0; i < 10; ++i) {
         for (int j= 0; j <= i; ++j) {
-            quad( q[i]*q[j], absdet, q5dom, locInt[0].mass[i][j], locInt[1].mass[i][j]);
-            quad( OuterProductExpressionCL( qA[i], qA[j]), absdet, q2dom, locInt[0].cAk[i][j], locInt[1].cAk[i][j]);
+            locInt[part].mass[i][j]= quad( make_ProductExpression( q[i], q[j]), absdet, q5, s);
+            locInt[other].mass[i][j]= absdet*P2DiscCL::GetMass( i, j) - locInt[part].mass[i][j];
             loc.M[j][i]= rho_n*locInt[0].mass[i][j] + rho_p*locInt[1].mass[i][j];
             loc.Ak[j][i]= mu_n*locInt[0].cAk[i][j]  +  mu_p*locInt[1].cAk[i][j];
             // dot-product of the gradients
@@ -2650,6 +2691,8 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
 
     SparseMatBuilderCL<double, SMatrixCL<3,3> >* mA_;
     SparseMatBuilderCL<double, SDiagMatrixCL<3> >* mM_;
+    bool reuse_pattern_; ///< reuse the sparsity pattern of A and M, if they were built by this accumulator for the current numbering
+    InterfaceCutCacheCL* cutcache_; ///< subtriangulations of the cut tetras; may be 0
 
     LocalSystem1OnePhase_P2CL local_onephase; ///< used on tetras in a single phase
     LocalSystem1TwoPhase_P2CL local_twophase; ///< used on intersected tetras
@@ -2665,7 +2708,7 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
     LocalP2CL<> ls_loc;
 	bool speBnd;        //if there is a slip or symmetric boundary condtion
 
-    Quad2CL<Point3DCL> rhs;
+    SQuad2CL<Point3DCL> rhs;
     Point3DCL loc_b[10], dirichlet_val[10]; ///< Used to transfer boundary-values from local_setup() update_global_system().
 
     ///\brief Computes the mapping from local to global data "n", the local matrices in loc and, if required, the Dirichlet-values needed to eliminate the boundary-dof from the global system.
@@ -2676,7 +2719,7 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
   public:
     System1Accumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff, const StokesBndDataCL& BndData_,
         const VecDescCL& ls, const BndDataCL<double>& ls_bnd, IdxDescCL& RowIdx_, MatrixCL& A_, MatrixCL& M_,
-        VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t);
+        VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t, bool reuse_pattern= false, InterfaceCutCacheCL* cutcache= 0);
 
     ///\brief Initializes matrix-builders and load-vectors
     void begin_accumulation ();
@@ -2690,9 +2733,9 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
 
 System1Accumulator_P2CL::System1Accumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff_, const StokesBndDataCL& BndData_,
     const VecDescCL& lset_arg, const BndDataCL<double>& lset_bnd, IdxDescCL& RowIdx_, MatrixCL& A_, MatrixCL& M_,
-    VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t_)
+    VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t_, bool reuse_pattern, InterfaceCutCacheCL* cutcache)
     : Coeff( Coeff_), BndData( BndData_), lset_Phi( lset_arg), lset_Bnd( lset_bnd), t( t_),
-      RowIdx( RowIdx_), A( A_), M( M_), cplA( cplA_), cplM( cplM_), b( b_),
+      RowIdx( RowIdx_), A( A_), M( M_), cplA( cplA_), cplM( cplM_), b( b_), reuse_pattern_( reuse_pattern), cutcache_( cutcache),
       local_twophase( Coeff.mu( 1.0), Coeff.mu( -1.0), Coeff.rho( 1.0), Coeff.rho( -1.0), Coeff.volforce),
 	  speBndHandler1(BndData_, Coeff.alpha),
 	  speBndHandler2(BndData_, lset_Phi, lset_Bnd, Coeff.Bndoutnormal, Coeff.mu( 1.0), Coeff.mu( -1.0), Coeff.beta(1.0), Coeff.beta(-1.0), Coeff.betaL, Coeff.alpha)
@@ -2702,8 +2745,12 @@ void System1Accumulator_P2CL::begin_accumulation ()
 {
     std::cout << "entering SetupSystem1_P2CL:\n";
     const size_t num_unks_vel= RowIdx.NumUnknowns();
-    mA_= new SparseMatBuilderCL<double, SMatrixCL<3,3> >( &A, num_unks_vel, num_unks_vel);
-    mM_= new SparseMatBuilderCL<double, SDiagMatrixCL<3> >( &M, num_unks_vel, num_unks_vel);
+    // The pattern depends only on the numbering; it is kept, if neither the numbering nor the matrices changed since the last setup.
+    const bool reuse= reuse_pattern_ && A.HasPatternKey( RowIdx.GetNumberingVersion()) && M.HasPatternKey( RowIdx.GetNumberingVersion());
+    if (reuse)
+        std::cout << "reusing the pattern of A and M, ";
+    mA_= new SparseMatBuilderCL<double, SMatrixCL<3,3> >( &A, num_unks_vel, num_unks_vel, reuse);
+    mM_= new SparseMatBuilderCL<double, SDiagMatrixCL<3> >( &M, num_unks_vel, num_unks_vel, reuse);
     if (b != 0) {
         b->Clear( t);
         cplM->Clear( t);
@@ -2717,6 +2764,10 @@ void System1Accumulator_P2CL::finalize_accumulation ()
     delete mA_;
     mM_->Build();
     delete mM_;
+    if (reuse_pattern_) {
+        A.SetPatternKey( RowIdx.GetNumberingVersion());
+        M.SetPatternKey( RowIdx.GetNumberingVersion());
+    }
 #ifndef _PAR
     std::cout << A.num_nonzeros() << " nonzeros in A, "
               << M.num_nonzeros() << " nonzeros in M!";
@@ -2760,7 +2811,7 @@ void System1Accumulator_P2CL::local_setup (const TetraCL& tet)
 		}
     }
     else{
-        local_twophase.setup( T, absdet, tet, ls_loc, t, locInt, loc);
+        local_twophase.setup( T, absdet, tet, ls_loc, t, locInt, loc, cutcache_);
         if(speBnd){
             speBndHandler2.setup(tet, T, ls_loc, loc); //update loc for special boundary condtion
             speBndHandler2.CLdiss(tet, loc);
@@ -2935,13 +2986,14 @@ void System1Accumulator_P2XCL::update_global_system ()
 
 
 void SetupSystem1_P2( const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, const StokesBndDataCL& BndData_, MatrixCL& A, MatrixCL& M,
-                      VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const VecDescCL& lset_phi, const BndDataCL<>& lset_bnd, IdxDescCL& RowIdx, double t)
-/// Set up matrices A, M and rhs b (depending on phase bnd)
+                      VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const VecDescCL& lset_phi, const BndDataCL<>& lset_bnd, IdxDescCL& RowIdx, double t, bool reuse_pattern,
+                      InterfaceCutCacheCL* cutcache= 0)
+/// Set up matrices A, M and rhs b (depending on phase bnd); the subtriangulations of the cut tetras are taken from cutcache, if it is not 0.
 {
     // TimerCL time;
     // time.Start();
     ScopeTimerCL scope("SetupSystem1_P2");
-    System1Accumulator_P2CL accu( Coeff_, BndData_, lset_phi, lset_bnd, RowIdx, A, M, b, cplA, cplM, t);
+    System1Accumulator_P2CL accu( Coeff_, BndData_, lset_phi, lset_bnd, RowIdx, A, M, b, cplA, cplM, t, reuse_pattern, cutcache);
     TetraAccumulatorTupleCL accus;
     MaybeAddProgressBar(MG_, "System1(P2) Setup", accus, RowIdx.TriangLevel());    accus.push_back( &accu);
     accumulate( accus, MG_, RowIdx.TriangLevel(), RowIdx.GetMatchingFunction(), RowIdx.GetBndInfo());
@@ -3273,7 +3325,8 @@ void InstatStokes2PhaseP2P1CL::SetupSystem1( MLMatDescCL* A, MLMatDescCL* M, Vec
     for (size_t lvl=0; lvl < A->Data.size(); ++lvl, ++itA, ++itM, ++it, ++itLset)
         switch (it->GetFE()) {
           case vecP2_FE:
-            SetupSystem1_P2 ( MG_, Coeff_, BndData_, *itA, *itM, lvl == A->Data.size()-1 ? b : 0, cplA, cplM, lvl == A->Data.size()-1 ? lset.Phi : *itLset, lset.GetBndData(), *it, t);
+            SetupSystem1_P2 ( MG_, Coeff_, BndData_, *itA, *itM, lvl == A->Data.size()-1 ? b : 0, cplA, cplM, lvl == A->Data.size()-1 ? lset.Phi : *itLset, lset.GetBndData(), *it, t, reuse_pattern_,
+                              lvl == A->Data.size()-1 ? &lset.GetCutCache() : 0);
             break;
           case vecP2R_FE:
             SetupSystem1_P2R( MG_, Coeff_, BndData_, *itA, *itM, lvl == A->Data.size()-1 ? b : 0, cplA, cplM, lvl == A->Data.size()-1 ? lset.Phi : *itLset, lset.GetBndData(), *it, t);
@@ -3314,7 +3367,8 @@ InstatStokes2PhaseP2P1CL::system1_accu (MLTetraAccumulatorTupleCL& accus, MLMatD
         switch (it->GetFE()) {
           case vecP2_FE:
             itaccu->push_back_acquire( new System1Accumulator_P2CL( GetCoeff(), GetBndData(), lvl == A->Data.size()-1 ? *lset.PhiC : *itLset, lset.GetBndData(),
-                *it, *itA, *itM, lvl == A->Data.size() - 1 ? b : 0, cplA, cplM, t));
+                *it, *itA, *itM, lvl == A->Data.size() - 1 ? b : 0, cplA, cplM, t, reuse_pattern_,
+                lvl == A->Data.size() - 1 ? &lset.GetCutCache() : 0));
             break;
 
           default:
@@ -210,21 +210,30 @@ private:
     //mutable CkernelCL    *cKernel;
     mutable VectorBaseCL<VectorCL> cKernel;
 
+  private:
+    bool reuse_pattern_; ///< numeric-only reassembly of A and M for vecP2_FE, if the numbering did not change
+
   public:
     InstatStokes2PhaseP2P1CL( const MGBuilderCL& mgb, const TwoPhaseFlowCoeffCL& coeff, const BndDataCL& bdata, FiniteElementT prFE= P1_FE, double XFEMstab=0.1, FiniteElementT velFE= vecP2_FE)
-        : base_(mgb, coeff, bdata), vel_idx(velFE, 1, bdata.Vel, 0, XFEMstab), pr_idx(prFE, 1, bdata.Pr, 0, XFEMstab), cKernel(0) { }
+        : base_(mgb, coeff, bdata), vel_idx(velFE, 1, bdata.Vel, 0, XFEMstab), pr_idx(prFE, 1, bdata.Pr, 0, XFEMstab), cKernel(0), reuse_pattern_( false) { }
     InstatStokes2PhaseP2P1CL( MultiGridCL& mg, const TwoPhaseFlowCoeffCL& coeff, const BndDataCL& bdata, FiniteElementT prFE= P1_FE, double XFEMstab=0.1, FiniteElementT velFE= vecP2_FE)
-        : base_(mg, coeff, bdata),  vel_idx(velFE, 1, bdata.Vel, 0, XFEMstab), pr_idx(prFE, 1, bdata.Pr, 0, XFEMstab), cKernel(0) { }
+        : base_(mg, coeff, bdata),  vel_idx(velFE, 1, bdata.Vel, 0, XFEMstab), pr_idx(prFE, 1, bdata.Pr, 0, XFEMstab), cKernel(0), reuse_pattern_( false) { }
 
     /// \name Numbering
     //@{
     /// Create/delete numbering of unknowns
     void CreateNumberingVel( Uint level, MLIdxDescCL* idx, match_fun match= 0, const LevelsetP2CL* lsetp= 0);
     void CreateNumberingPr ( Uint level, MLIdxDescCL* idx, match_fun match= 0, const LevelsetP2CL* lsetp= 0);
-    /// \brief Only used for XFEM
+    /// \brief Only used for XFEM; on the level of the level set function, only the cut tetras are checked.
     void UpdateXNumbering( MLIdxDescCL* idx, const LevelsetP2CL& lset)
         {
-            if (UsesXFEM()) idx->UpdateXNumbering( MG_, *lset.PhiC, lset.GetBndData());
+            if (!UsesXFEM()) return;
+            if (idx->TriangLevel() == lset.PhiC->RowIdx->TriangLevel()) {
+                const InterfaceTetraListCL& tetras= lset.GetInterfaceTetras();
+                idx->UpdateXNumbering( MG_, *lset.PhiC, lset.GetBndData(), tetras.cut_begin(), tetras.cut_end());
+            }
+            else
+                idx->UpdateXNumbering( MG_, *lset.PhiC, lset.GetBndData());
         }
     /// \brief Only used for XFEM
     void UpdatePressure( VecDescCL* p)
@@ -239,6 +248,9 @@ private:
     //@{
     /// Returns whether extended FEM are used for pressure
     bool UsesXFEM() const { return pr_idx.GetFinest().IsExtended(); }
+    /// If enabled, SetupSystem1 and system1_accu only recompute the values of A and M, as long as the velocity numbering and the matrices are unchanged.
+    void SetPatternReuse (bool reuse) { reuse_pattern_= reuse; }
+    bool GetPatternReuse () const { return reuse_pattern_; }
     /// Set up matrices A, M and rhs b (depending on phase bnd)
     void SetupSystem1( MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t) const;
     MLTetraAccumulatorTupleCL& system1_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t) const;
@@ -262,8 +262,14 @@ class StokesSystem1Accumulator_P2CL : public TetraAccumulatorCL
     Quad2CL<Point3DCL> rhs;
     Point3DCL loc_b[10], dirichlet_val[10]; ///< Used to transfer boundary-values from local_setup() update_global_system().
 
+    double T_block[3][3][TetraBlockSizeC], det_block[TetraBlockSizeC], absdet_block[TetraBlockSizeC];
+    double G_block[4][3][TetraBlockSizeC];    ///< P1-gradients of the tetras of a block
+    double A_block[10][10][TetraBlockSizeC];  ///< stiffness matrices of the tetras of a block
+
     ///\brief Computes the mapping from local to global data "n", the local matrices in loc and, if required, the Dirichlet-values needed to eliminate the boundary-dof from the global system.
     void local_setup (const TetraCL& tet);
+    ///\brief Computes "n" and, if required, the right-hand side and the Dirichlet-values; T and absdet must be set.
+    void local_setup_rhs (const TetraCL& tet);
     ///\brief Update the global system.
     void update_global_system ();
 
@@ -278,6 +284,9 @@ class StokesSystem1Accumulator_P2CL : public TetraAccumulatorCL
     void finalize_accumulation();
 
     void visit (const TetraCL& sit);
+    ///\brief The stiffness matrices of the tetras of a block are computed in structure-of-arrays layout.
+    size_t block_size () const { return TetraBlockSizeC; }
+    void visit_block (const TetraCL* const* t, size_t n);
 
     TetraAccumulatorCL* clone (int /*tid*/) { return new StokesSystem1Accumulator_P2CL ( *this); };
 };
@@ -319,20 +328,46 @@ void StokesSystem1Accumulator_P2CL<CoeffT>::visit (const TetraCL& tet)
     update_global_system();
 }
 
+template< class CoeffT>
+void StokesSystem1Accumulator_P2CL<CoeffT>::visit_block (const TetraCL* const* tet, size_t num)
+{
+    GetTrafoTr( T_block, det_block, tet, num);
+    for (Uint l= 0; l < TetraBlockSizeC; ++l)
+        absdet_block[l]= std::fabs( det_block[l]);
+    P1DiscCL::GetGradients( G_block, T_block);
+    P2DiscCL::GetStiffness( A_block, G_block, absdet_block);
+
+    for (size_t l= 0; l < num; ++l) {
+        absdet= absdet_block[l];
+        for (Uint i= 0; i < 10; ++i)
+            for (Uint j= 0; j <= i; ++j) {
+                loc.M[j][i]= loc.M[i][j]= P2DiscCL::GetMass( j, i)*absdet;
+                loc.A[j][i]= loc.A[i][j]= Coeff.nu*A_block[i][j][l];
+            }
+        local_setup_rhs( *tet[l]);
+        update_global_system();
+    }
+}
+
 template< class CoeffT>
 void StokesSystem1Accumulator_P2CL<CoeffT>::local_setup (const TetraCL& tet)
 {
     GetTrafoTr( T, det, tet);
     absdet= std::fabs( det);
 
-    rhs.assign( tet, Coeff.f, t);
-    n.assign( tet, RowIdx, BndData.Vel);
-
     local_onephase.mu(  Coeff.nu);
     local_onephase.rho( 1.0);
     local_onephase.setup( T, absdet, loc);
 
+    local_setup_rhs( tet);
+}
+
+template< class CoeffT>
+void StokesSystem1Accumulator_P2CL<CoeffT>::local_setup_rhs (const TetraCL& tet)
+{
+    n.assign( tet, RowIdx, BndData.Vel);
     if (b != 0) {
+        rhs.assign( tet, Coeff.f, t);
         for (int i= 0; i < 10; ++i) {
             if (!n.WithUnknowns( i)) {
                 typedef StokesBndDataCL::VelBndDataCL::bnd_val_fun bnd_val_fun;
@@ -0,0 +1,154 @@
+/// \file accuengine.cpp
+/// \brief compares and times the colored and the partitioned OpenMP-parallel accumulation with System1Accumulator_P2CL
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "num/accumulator.h"
+#include "stokes/instatstokes2phase.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "misc/funcmap.h"
+
+#include <set>
+#include <cstdlib>
+
+using namespace DROPS;
+
+const Uint N= 8; ///< subdivisions of the unit cube per direction
+
+Point3DCL ZeroVel (const Point3DCL&, double) { return Point3DCL(); }
+double    Zero    (const Point3DCL&, double) { return 0.; }
+double    sigma   (const Point3DCL&, double) { return 1.; }
+double    Sphere  (const Point3DCL& p, double) { return (p - Point3DCL( 0.5)).norm() - 0.3; }
+
+// used by TwoPhaseFlowCoeffCL
+static RegisterVectorFunction regvelzerovel( "ZeroVel", ZeroVel);
+static RegisterScalarFunction regscazero( "Zero", Zero);
+
+/// \brief The interior tetras of different parts must not share a vertex; together with the separator tetras, all tetras occur exactly once.
+int CheckPartition (const MultiGridCL& mg, const TriangPartitionCL& part)
+{
+    std::map<const VertexCL*, size_t> vertex_part;
+    std::set<const TetraCL*> tetras;
+    int status= 0;
+    for (size_t p= 0; p < part.num_parts(); ++p)
+        for (TriangPartitionCL::TetraSeqT::const_iterator t= part.interior( p).begin(); t != part.interior( p).end(); ++t) {
+            if (!tetras.insert( *t).second)
+                status= 1;
+            for (Uint i= 0; i < 4; ++i)
+                if (!vertex_part.insert( std::make_pair( (*t)->GetVertex( i), p)).second
+                    && vertex_part[(*t)->GetVertex( i)] != p)
+                    status= 1;
+        }
+    for (ColorClassesCL::const_iterator cl= part.separator().begin(); cl != part.separator().end(); ++cl)
+        for (ColorClassesCL::ColorClassT::const_iterator t= cl->begin(); t != cl->end(); ++t)
+            if (!tetras.insert( *t).second)
+                status= 1;
+    if (tetras.size() != static_cast<size_t>( std::distance( mg.GetTriangTetraBegin(), mg.GetTriangTetraEnd())))
+        status= 1;
+    part.WriteStatistics( std::cout);
+    std::cout << (status == 0 ? "valid partition\n" : "invalid partition\n");
+    return status;
+}
+
+int Check (const char* name, double err)
+{
+    std::cout << name << ": error: " << err << '\n';
+    return err < 1e-12 ? 0 : 1;
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), N, N, N);
+        const BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+        const StokesVelBndDataCL::bnd_val_fun bnd_fun[6]= { ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel };
+        const StokesBndDataCL bnddata( 6, bc, bnd_fun);
+        const TwoPhaseFlowCoeffCL coeff( 1., 10., 1., 5., 0., Point3DCL());
+        InstatStokes2PhaseP2P1CL Stokes( brick, coeff, bnddata);
+        MultiGridCL& mg= Stokes.GetMG();
+
+        SurfaceTensionCL sf( sigma);
+        const BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+        const LsetBndDataCL lsbnd( 6, lsbc);
+        LevelsetP2ContCL lset( mg, lsbnd, sf);
+        lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+        lset.Phi.SetIdx( &lset.idx);
+        lset.Init( Sphere);
+
+        Stokes.CreateNumberingVel( mg.GetLastLevel(), &Stokes.vel_idx);
+        Stokes.b.SetIdx( &Stokes.vel_idx);
+        Stokes.A.SetIdx( &Stokes.vel_idx, &Stokes.vel_idx);
+        Stokes.M.SetIdx( &Stokes.vel_idx, &Stokes.vel_idx);
+        VecDescCL cplA( &Stokes.vel_idx), cplM( &Stokes.vel_idx);
+        std::cout << "velocity unknowns: " << Stokes.vel_idx.NumUnknowns() << '\n';
+
+        VectorCL x( Stokes.vel_idx.NumUnknowns());
+        for (size_t i= 0; i < x.size(); ++i)
+            x[i]= drand48();
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+        const VectorCL Ax( Stokes.A.Data*x), Mx( Stokes.M.Data*x), b( Stokes.b.Data);
+
+        const int max_threads=
+#ifdef _OPENMP
+            omp_get_max_threads();
+#else
+            1;
+#endif
+        const char* names[2]= { "colored", "partitioned" };
+        const TetraAccumulationT modes[2]= { ColoredAccumulation, PartitionedAccumulation };
+        // At least two threads are used to test the parallel code paths.
+        for (int t= 2; t <= std::max( 2, max_threads); t*= 2) {
+#ifdef _OPENMP
+            omp_set_num_threads( t);
+#endif
+            for (int m= 0; m < 2; ++m) {
+                SetTetraAccumulation( modes[m]);
+                Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.); // warm-up; creates the color classes or the partition
+                TimerCL timer;
+                timer.Start();
+                for (int i= 0; i < 3; ++i)
+                    Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+                timer.Stop();
+                std::cout << names[m] << ": " << t << " threads: " << timer.GetTime()/3. << " s\n";
+                status+= Check( "A", supnorm( VectorCL( Stokes.A.Data*x - Ax))/supnorm( Ax));
+                status+= Check( "M", supnorm( VectorCL( Stokes.M.Data*x - Mx))/supnorm( Mx));
+                status+= Check( "b", supnorm( VectorCL( Stokes.b.Data - b)));
+            }
+#ifdef _OPENMP
+            status+= CheckPartition( mg, mg.GetTriangPartition( -1, 0, Stokes.vel_idx.GetBndInfo(), t));
+#endif
+        }
+#ifdef _OPENMP
+        omp_set_num_threads( max_threads);
+#endif
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
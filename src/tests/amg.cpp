@@ -0,0 +1,138 @@
+/// \file amg.cpp
+/// \brief tests the smoothed aggregation AMG preconditioner and the sparse matrix product
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "num/amg.h"
+#include "num/krylovsolver.h"
+#include "parallel/exchange.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t N= 24; ///< grid points per direction
+
+/// \brief 7-point stencil of -div(k grad u) on the unit cube with k= 1 + c*x.
+/// If neumann is false, the boundary values are eliminated (Dirichlet); otherwise, the boundary is a Neumann boundary.
+void Assemble (MatrixCL& A, double c, bool neumann, bool reuse)
+{
+    const size_t n= N*N*N;
+    SparseMatBuilderCL<double> b( &A, n, n, reuse);
+    for (size_t i= 0; i < N; ++i)
+        for (size_t j= 0; j < N; ++j)
+            for (size_t k= 0; k < N; ++k) {
+                const size_t row= (i*N + j)*N + k;
+                const int idx[3]= { int( i), int( j), int( k) };
+                for (int d= 0; d < 3; ++d)
+                    for (int s= -1; s <= 1; s+= 2) {
+                        int nb[3]= { idx[0], idx[1], idx[2] };
+                        nb[d]+= s;
+                        const double kappa= 1. + c*(i + 0.5*(d == 0 ? s : 0))/N;
+                        if (nb[d] < 0 || nb[d] >= int( N)) {
+                            if (!neumann)
+                                b( row, row)+= kappa;
+                            continue;
+                        }
+                        b( row, row)+= kappa;
+                        b( row, (nb[0]*N + nb[1])*N + nb[2])-= kappa;
+                    }
+            }
+    b.Build();
+}
+
+/// \brief Solve with PCG; returns the number of iterations, if the residual is reduced by 1e-8, and maxiter otherwise.
+template <class PcT>
+int Solve (PcT& pc, const MatrixCL& A, const VectorCL& b)
+{
+    PCGSolverCL<PcT> solver( pc, 500, 1e-8, /*relative*/ true);
+    VectorCL x( b.size());
+    solver.Solve( A, x, b, DummyExchangeCL());
+    const double res= norm( VectorCL( A*x - b))/norm( b);
+    return res <= 1e-7 ? solver.GetIter() : solver.GetMaxIter();
+}
+
+int TestProduct ()
+{
+    MatrixCL A, B, C;
+    Assemble( A, 0., false, false);
+    Assemble( B, 1., true, false);
+    mat_mul( A, B, C);
+    VectorCL x( A.num_cols());
+    for (size_t i= 0; i < x.size(); ++i)
+        x[i]= drand48();
+    const double err= norm( VectorCL( C*x - A*VectorCL( B*x)))/norm( x);
+    std::cout << "mat_mul: error: " << err << '\n';
+    return err < 1e-12 ? 0 : 1;
+}
+
+int TestAMG ()
+{
+    int status= 0;
+    MatrixCL A;
+    Assemble( A, 0., false, false);
+    VectorCL b( A.num_rows());
+    for (size_t i= 0; i < b.size(); ++i)
+        b[i]= drand48();
+
+    SSORPcCL ssor;
+    const int it_ssor= Solve( ssor, A, b);
+    AMGPcCL amg;
+    const int it_amg= Solve( amg, A, b);
+    std::cout << "Dirichlet: PCG-SSOR: " << it_ssor << " iterations, PCG-AMG: " << it_amg << " iterations, levels: "
+              << amg.GetNumLevels() << ", operator complexity: " << amg.GetOperatorComplexity() << '\n';
+    if (it_amg > 20 || 2*it_amg > it_ssor)
+        status= 1;
+
+    // Only the values change: the aggregates are reused.
+    Assemble( A, 2., false, true);
+    const int it_update= Solve( amg, A, b);
+    std::cout << "Dirichlet, new values: PCG-AMG: " << it_update << " iterations, setups: " << amg.GetNumSetups()
+              << ", updates: " << amg.GetNumUpdates() << '\n';
+    if (it_update > 20 || amg.GetNumSetups() != 1 || amg.GetNumUpdates() != 1)
+        status= 1;
+
+    // Singular Neumann matrix with consistent right hand side; the pattern is the same as for Dirichlet boundary values.
+    MatrixCL An;
+    Assemble( An, 1., true, false);
+    b-= b.sum()/b.size();
+    const int it_neumann= Solve( amg, An, b);
+    AMGPcCL amg_new;
+    const int it_neumann_new= Solve( amg_new, An, b);
+    std::cout << "Neumann: PCG-AMG: " << it_neumann << " iterations, updates: " << amg.GetNumUpdates()
+              << ", with new aggregates: " << it_neumann_new << " iterations\n";
+    if (it_neumann > 20 || it_neumann_new > 20 || amg.GetNumUpdates() != 2)
+        status= 1;
+    return status;
+}
+
+int main ()
+{
+    try {
+        const int status= TestProduct() + TestAMG();
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
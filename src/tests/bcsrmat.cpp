@@ -0,0 +1,139 @@
+/// \file bcsrmat.cpp
+/// \brief compares the block compressed row matrix with 3x3-blocks to the scalar compressed row matrix
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/bcsrmat.h"
+#include "misc/utils.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t N= 40; ///< grid points per direction
+
+void InitVector( VectorCL& v)
+{
+    for (size_t i= 0; i < v.size(); ++i)
+        v[i]= drand48() - 0.5;
+}
+
+/// \brief 7-point stencil on a NxNxN-grid with 3 unknowns per grid point.
+/// The couplings in x- and y-direction are full 3x3-blocks, the couplings in z-direction are diagonal,
+/// such that the conversion has to fill up blocks with zeros.
+void BuildMatrix (MatrixCL& A)
+{
+    const size_t n= 3*N*N*N;
+    SparseMatBuilderCL<double> bA( &A, n, n);
+    for (size_t k= 0; k < N; ++k)
+        for (size_t j= 0; j < N; ++j)
+            for (size_t i= 0; i < N; ++i) {
+                const size_t p= 3*(i + N*(j + N*k));
+                for (Uint r= 0; r < 3; ++r) {
+                    bA( p + r, p + r)= 12.;
+                    bA( p + r, p + (r + 1)%3)= -0.5;
+                    if (i > 0)     for (Uint c= 0; c < 3; ++c) bA( p + r, p - 3 + c)= r == c ? -1. : 0.1*(drand48() - 0.5);
+                    if (i + 1 < N) for (Uint c= 0; c < 3; ++c) bA( p + r, p + 3 + c)= r == c ? -1. : 0.1*(drand48() - 0.5);
+                    if (j > 0)     for (Uint c= 0; c < 3; ++c) bA( p + r, p - 3*N + c)= r == c ? -1. : 0.1*(drand48() - 0.5);
+                    if (j + 1 < N) for (Uint c= 0; c < 3; ++c) bA( p + r, p + 3*N + c)= r == c ? -1. : 0.1*(drand48() - 0.5);
+                    if (k > 0)     bA( p + r, p - 3*N*N + r)= -1.;
+                    if (k + 1 < N) bA( p + r, p + 3*N*N + r)= -1.;
+                }
+            }
+    bA.Build();
+}
+
+int Check (const char* name, double err)
+{
+    std::cout << name << ": error: " << err << '\n';
+    return err < 1e-12 ? 0 : 1;
+}
+
+/// \brief Apply the smoother of type PB to the scalar and the block matrix and compare the results.
+template <PreBaseGS PB, bool HasOmega>
+int CheckSmoother (const char* name, const MatrixCL& A, const BCSRMatrixCL& bA, const VectorCL& b, const VectorCL& x0)
+{
+    VectorCL x( x0), y( x0);
+    for (int i= 0; i < 3; ++i) {
+        SolveGSstep<HasOmega, VectorCL>( PreDummyCL<PB>(), A,  x, b, 1.2);
+        SolveGSstep<HasOmega, VectorCL>( PreDummyCL<PB>(), bA, y, b, 1.2);
+    }
+    return Check( name, supnorm( VectorCL( x - y))/supnorm( x));
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        MatrixCL A;
+        BuildMatrix( A);
+        TimerCL timer;
+        timer.Start();
+        BCSRMatrixCL bA( A);
+        timer.Stop();
+        std::cout << "conversion: " << timer.GetTime() << " s\n"
+                  << "nonzeros: scalar: " << A.num_nonzeros() << "\tblock: " << bA.num_nonzeros()
+                  << "\tblocks: " << bA.num_blocks() << '\n';
+
+        double err= 0.;
+        for (size_t i= 0; i < A.num_rows(); ++i)
+            for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+                err= std::max( err, std::fabs( bA( i, A.col_ind( nz)) - A.val( nz)));
+        status+= Check( "entries", err);
+        status+= Check( "diagonal", supnorm( VectorCL( A.GetDiag() - bA.GetDiag())));
+
+        VectorCL x( A.num_cols()), y( A.num_rows()), yb( A.num_rows());
+        InitVector( x);
+        timer.Reset();
+        timer.Start();
+        for (int i= 0; i < 20; ++i)
+            y= A*x;
+        timer.Stop();
+        const double t_csr= timer.GetTime()/20.;
+        std::cout << "y_Ax (CSR):  " << t_csr << " s\n";
+        timer.Reset();
+        timer.Start();
+        for (int i= 0; i < 20; ++i)
+            yb= bA*x;
+        timer.Stop();
+        std::cout << "y_Ax (BCSR): " << timer.GetTime()/20. << " s, speedup: " << t_csr/timer.GetTime()*20. << '\n';
+        status+= Check( "A*x", supnorm( VectorCL( y - yb))/supnorm( y));
+        y= transp_mul( A, x);
+        yb= transp_mul( bA, x);
+        status+= Check( "transp_mul", supnorm( VectorCL( y - yb))/supnorm( y));
+
+        VectorCL b( A.num_rows()), x0( A.num_rows());
+        InitVector( b);
+        InitVector( x0);
+        status+= CheckSmoother<PB_JAC,  true> ( "Jacobi",     A, bA, b, x0);
+        status+= CheckSmoother<PB_GS,   true> ( "SOR",        A, bA, b, x0);
+        status+= CheckSmoother<PB_GS,   false>( "Gauss-Seidel", A, bA, b, x0);
+        status+= CheckSmoother<PB_SGS,  true> ( "SSOR",       A, bA, b, x0);
+        status+= CheckSmoother<PB_SGS0, true> ( "SSOR0",      A, bA, b, x0);
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,126 @@
+/// \file blas1.cpp
+/// \brief compares the threaded BLAS-1 kernels for VectorCL with serial reference implementations
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/spmat.h"
+#include "misc/utils.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t VecSize= 5000000;
+
+void InitVector( VectorCL& v)
+{
+    for (size_t i= 0; i < v.size(); ++i)
+        v[i]= drand48() - 0.5;
+}
+
+double SerialDot (const VectorCL& x, const VectorCL& y)
+{
+    double sum= 0.;
+    for (size_t i= 0; i < x.size(); ++i)
+        sum+= x[i]*y[i];
+    return sum;
+}
+
+int Check (const char* name, double val, double ref)
+{
+    const double err= std::fabs( val - ref)/std::max( 1.0, std::fabs( ref));
+    std::cout << name << ": " << val << "\treference: " << ref << "\trel. error: " << err << '\n';
+    return err < 1e-10 ? 0 : 1;
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        VectorCL x( VecSize), y( VecSize), z( VecSize);
+        InitVector( x); InitVector( y); InitVector( z);
+        const double a= 0.3, b= -1.7;
+
+        TimerCL timer;
+        double d= 0.;
+        timer.Start();
+        for (int i= 0; i < 10; ++i)
+            d= dot( x, y);
+        timer.Stop();
+        std::cout << "dot: " << timer.GetTime()/10. << " s\n";
+        status+= Check( "dot", d, SerialDot( x, y));
+        status+= Check( "norm_sq", norm_sq( x), SerialDot( x, x));
+        status+= Check( "KahanInnerProd", KahanInnerProd( x, y, 0.), SerialDot( x, y));
+
+        double d1, d2;
+        dot2( x, y, z, d1, d2);
+        status+= Check( "dot2 (1)", d1, SerialDot( x, y));
+        status+= Check( "dot2 (2)", d2, SerialDot( x, z));
+
+        VectorCL ref( y + a*x);
+        const double ref_nrm= SerialDot( ref, ref);
+        timer.Reset();
+        timer.Start();
+        const double nrm= axpy_norm_sq( a, x, y);
+        timer.Stop();
+        std::cout << "axpy_norm_sq: " << timer.GetTime() << " s\n";
+        status+= Check( "axpy_norm_sq", nrm, ref_nrm);
+        status+= Check( "axpy_norm_sq (vector)", supnorm( VectorCL( y - ref)), 0.);
+
+        ref= x + a*y + b*z;
+        z_xpaypby2( z, x, a, y, b, z); // z aliases y2
+        status+= Check( "z_xpaypby2", supnorm( VectorCL( z - ref)), 0.);
+
+        ref= x + b*y;
+        status+= Check( "z_xpay_norm_sq", z_xpay_norm_sq( z, x, b, y), SerialDot( ref, ref));
+
+        // The reproducible reductions must not depend on the number of threads.
+        SetBLAS1Reduction( ReproducibleReduction);
+        timer.Reset();
+        timer.Start();
+        for (int i= 0; i < 10; ++i)
+            d= dot( x, y);
+        timer.Stop();
+        std::cout << "dot (reproducible): " << timer.GetTime()/10. << " s\n";
+        status+= Check( "dot (reproducible)", d, SerialDot( x, y));
+#ifdef _OPENMP
+        const int max_threads= omp_get_max_threads();
+        const double nrm_rep= norm_sq( x),
+                     kahan_rep= KahanInnerProd( x, y, 0.);
+        for (int t= 1; t <= max_threads + 3; ++t) {
+            omp_set_num_threads( t);
+            if (dot( x, y) != d || norm_sq( x) != nrm_rep || KahanInnerProd( x, y, 0.) != kahan_rep) {
+                std::cout << "reproducible reduction differs for " << t << " threads.\n";
+                ++status;
+            }
+        }
+        omp_set_num_threads( max_threads);
+#endif
+        SetBLAS1Reduction( FastReduction);
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
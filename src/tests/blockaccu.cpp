@@ -0,0 +1,108 @@
+/// \file blockaccu.cpp
+/// \brief tests the accumulation over blocks of tetras against the accumulation tetra by tetra
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "num/accumulator.h"
+#include "poisson/poisson.h"
+
+#include <cstdlib>
+#include <cmath>
+
+using namespace DROPS;
+
+double    Reaction (const TetraCL& tet, const BaryCoordCL& b, double) { return 1. + GetWorldCoord( tet, b)[0]; }
+double    Source   (const TetraCL& tet, const BaryCoordCL& b, double) { return GetWorldCoord( tet, b)[1]; }
+Point3DCL ZeroVel  (const TetraCL&, const BaryCoordCL&, double) { return Point3DCL(); }
+double    ZeroBnd  (const Point3DCL&, double) { return 0.; }
+
+struct CoeffCL
+{
+    static scalar_tetra_function q, f;
+    static vector_tetra_function Vel, ALEVelocity;
+    static double alpha;
+};
+
+scalar_tetra_function CoeffCL::q= Reaction;
+scalar_tetra_function CoeffCL::f= Source;
+vector_tetra_function CoeffCL::Vel= ZeroVel;
+vector_tetra_function CoeffCL::ALEVelocity= ZeroVel;
+double CoeffCL::alpha= 0.5;
+
+/// \brief Relative difference of the assembly over blocks and tetra by tetra.
+double Difference (const MatrixCL& block, const MatrixCL& single)
+{
+    if (block.num_nonzeros() != single.num_nonzeros())
+        return 1.;
+    double d= 0., s= 0.;
+    for (size_t i= 0; i < single.num_nonzeros(); ++i) {
+        d= std::max( d, std::fabs( block.raw_val()[i] - single.raw_val()[i]));
+        s= std::max( s, std::fabs( single.raw_val()[i]));
+    }
+    return d/s;
+}
+
+int CheckPoisson (MultiGridCL& mg, size_t repeat)
+{
+    const BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+    const BndDataCL<>::bnd_val_fun bnd_fun[6]= { ZeroBnd, ZeroBnd, ZeroBnd, ZeroBnd, ZeroBnd, ZeroBnd };
+    const BndDataCL<> bnd( 6, bc, bnd_fun);
+    CoeffCL coeff;
+    SUPGCL supg;
+    IdxDescCL idx( P1_FE);
+    idx.CreateNumbering( mg.GetLastLevel(), mg, bnd);
+    MatrixCL A[2], M[2];
+    TimerCL timer;
+    for (int block= 0; block < 2; ++block) {
+        SetBlockAccumulation( block == 1);
+        timer.Reset();
+        for (size_t i= 0; i < repeat; ++i)
+            SetupPartialSystem_P1( mg, coeff, &A[block], &M[block], 0, 0, 0, 0, 0, &bnd, idx, idx, 0., supg, false, false);
+        timer.Stop();
+        std::cout << "Poisson P1, " << (block == 1 ? "blocks: " : "single tetras: ") << timer.GetTime()/repeat << " s\n";
+    }
+    const double dA= Difference( A[1], A[0]), dM= Difference( M[1], M[0]);
+    std::cout << "Poisson P1: difference of A: " << dA << ", of M: " << dM << '\n';
+    idx.DeleteNumbering( mg);
+    return dA < 1e-13 && dM < 1e-13 ? 0 : 1;
+}
+
+int main (int argc, char** argv)
+{
+    try {
+        const Uint   n= argc > 1 ? std::atoi( argv[1]) : 6;
+        const size_t repeat= argc > 2 ? std::atoi( argv[2]) : 1;
+        BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), n, n, n);
+        MultiGridCL mg( brick);
+
+        const int status= CheckPoisson( mg, repeat);
+        SetBlockAccumulation( true);
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
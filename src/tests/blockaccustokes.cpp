@@ -0,0 +1,107 @@
+/// \file blockaccustokes.cpp
+/// \brief tests the accumulation of the one-phase Stokes system over blocks of tetras against the accumulation tetra by tetra
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "num/accumulator.h"
+#include "stokes/stokes.h"
+
+#include <cstdlib>
+#include <cmath>
+
+using namespace DROPS;
+
+Point3DCL ZeroVelBnd (const Point3DCL&, double) { return Point3DCL(); }
+Point3DCL VelSource  (const Point3DCL& p, double) { return p; }
+
+struct CoeffCL
+{
+    static instat_vector_fun_ptr f;
+    const double nu;
+
+    CoeffCL() : nu( 2.) {}
+};
+
+instat_vector_fun_ptr CoeffCL::f= VelSource;
+
+/// \brief Relative difference of the assembly over blocks and tetra by tetra.
+double Difference (const MatrixCL& block, const MatrixCL& single)
+{
+    if (block.num_nonzeros() != single.num_nonzeros())
+        return 1.;
+    double d= 0., s= 0.;
+    for (size_t i= 0; i < single.num_nonzeros(); ++i) {
+        d= std::max( d, std::fabs( block.raw_val()[i] - single.raw_val()[i]));
+        s= std::max( s, std::fabs( single.raw_val()[i]));
+    }
+    return d/s;
+}
+
+int CheckStokes (MultiGridCL& mg, size_t repeat)
+{
+    const BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+    const StokesVelBndDataCL::bnd_val_fun bnd_fun[6]= { ZeroVelBnd, ZeroVelBnd, ZeroVelBnd, ZeroVelBnd, ZeroVelBnd, ZeroVelBnd };
+    const StokesBndDataCL bnd( 6, bc, bnd_fun);
+    const CoeffCL coeff;
+    MLIdxDescCL idx( vecP2_FE);
+    idx.CreateNumbering( mg.GetLastLevel(), mg, bnd.Vel);
+    MatrixCL A[2], M[2];
+    VecDescCL b[2], cplA[2], cplM[2];
+    TimerCL timer;
+    for (int block= 0; block < 2; ++block) {
+        SetBlockAccumulation( block == 1);
+        b[block].SetIdx( &idx);
+        cplA[block].SetIdx( &idx);
+        cplM[block].SetIdx( &idx);
+        timer.Reset();
+        for (size_t i= 0; i < repeat; ++i)
+            SetupSystem1_P2( mg, coeff, bnd, A[block], M[block], &b[block], &cplA[block], &cplM[block], idx.GetFinest(), 0.);
+        timer.Stop();
+        std::cout << "Stokes P2, " << (block == 1 ? "blocks: " : "single tetras: ") << timer.GetTime()/repeat << " s\n";
+    }
+    const double dA= Difference( A[1], A[0]), dM= Difference( M[1], M[0]),
+        db= supnorm( VectorCL( b[1].Data - b[0].Data))/supnorm( b[0].Data);
+    std::cout << "Stokes P2: difference of A: " << dA << ", of M: " << dM << ", of b: " << db << '\n';
+    idx.DeleteNumbering( mg);
+    return dA < 1e-13 && dM < 1e-13 && db < 1e-13 ? 0 : 1;
+}
+
+int main (int argc, char** argv)
+{
+    try {
+        const Uint   n= argc > 1 ? std::atoi( argv[1]) : 6;
+        const size_t repeat= argc > 2 ? std::atoi( argv[2]) : 1;
+        BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), n, n, n);
+        MultiGridCL mg( brick);
+
+        const int status= CheckStokes( mg, repeat);
+        SetBlockAccumulation( true);
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
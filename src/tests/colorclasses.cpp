@@ -0,0 +1,97 @@
+/// \file colorclasses.cpp
+/// \brief tests the incremental update of the color classes of the tetras after refinement
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "num/bndData.h"
+
+#include <set>
+
+using namespace DROPS;
+
+/// \brief Mark the tetras near the sphere with radius r around (0.5, 0.5, 0.5).
+void MarkSphere (MultiGridCL& mg, double r)
+{
+    const Point3DCL c( 0.5);
+    DROPS_FOR_TRIANG_TETRA( mg, -1, It)
+        if (std::abs( (GetBaryCenter( *It) - c).norm() - r) < std::pow( It->GetVolume(), 1./3.))
+            It->SetRegRefMark();
+}
+
+/// \brief All tetras of the triangulation must be colored exactly once, tetras of the same color must not share a vertex.
+int Check (const MultiGridCL& mg, const ColorClassesCL& colors)
+{
+    std::set<const TetraCL*> tetras;
+    int status= 0;
+    for (ColorClassesCL::const_iterator cl= colors.begin(); cl != colors.end(); ++cl) {
+        std::set<const VertexCL*> verts;
+        for (ColorClassesCL::ColorClassT::const_iterator t= cl->begin(); t != cl->end(); ++t) {
+            if (!tetras.insert( *t).second)
+                status= 1;
+            for (Uint i= 0; i < 4; ++i)
+                if (!verts.insert( (*t)->GetVertex( i)).second)
+                    status= 1;
+        }
+    }
+    if (tetras.size() != static_cast<size_t>( std::distance( mg.GetTriangTetraBegin(), mg.GetTriangTetraEnd())))
+        status= 1;
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, -1, It)
+        if (tetras.count( &*It) == 0)
+            status= 1;
+    colors.WriteStatistics( std::cout);
+    std::cout << (status == 0 ? "valid coloring\n" : "invalid coloring\n");
+    return status;
+}
+
+int main ()
+{
+    try {
+        BrickBuilderCL brick( std_basis<3>( 0), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 12, 12, 12);
+        MultiGridCL mg( brick);
+        const BndCondCL bnd( 0);
+        int status= 0;
+
+        status+= Check( mg, mg.GetColorClasses( -1, 0, bnd));
+        for (int step= 0; step < 3; ++step) {
+            MarkSphere( mg, 0.2 + 0.05*step);
+            mg.Refine();
+            const ColorClassesCL& colors= mg.GetColorClasses( -1, 0, bnd);
+            status+= Check( mg, colors);
+            if (colors.num_recolored() == colors.num_tetra())
+                status+= 1; // all tetras recolored: the update is not incremental.
+        }
+        // A refinement without marks must not recolor any tetra.
+        mg.Refine();
+        const ColorClassesCL& colors= mg.GetColorClasses( -1, 0, bnd);
+        status+= Check( mg, colors);
+        if (colors.num_recolored() != 0)
+            status+= 1;
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,134 @@
+/// \file cutcache.cpp
+/// \brief tests the cache of the subtriangulations of the cut tetras
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "stokes/instatstokes2phase.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "misc/funcmap.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+const Uint   N= 8;    ///< subdivisions of the unit cube per direction
+const double R= 0.3;  ///< radius of the sphere
+
+Point3DCL ZeroVel (const Point3DCL&, double) { return Point3DCL(); }
+double    Zero    (const Point3DCL&, double) { return 0.; }
+double    sigma   (const Point3DCL&, double) { return 1.; }
+double    Sphere  (const Point3DCL& p, double) { return (p - Point3DCL( 0.5)).norm() - R; }
+
+// used by TwoPhaseFlowCoeffCL
+static RegisterVectorFunction regvelzerovel( "ZeroVel", ZeroVel);
+static RegisterScalarFunction regscazero( "Zero", Zero);
+
+int Check (const char* name, double err, double tol)
+{
+    std::cout << name << ": error: " << err << '\n';
+    return err < tol ? 0 : 1;
+}
+
+/// \brief area of the interface from the triangles of InterfaceTriangleCL on the children of the tetras
+double ChildTriangleArea (const MultiGridCL& mg, const LevelsetP2CL& lset)
+{
+    InterfaceTriangleCL triangle;
+    double area= 0.;
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, mg.GetLastLevel(), it) {
+        triangle.Init( *it, lset.Phi, lset.GetBndData());
+        for (int ch= 0; ch < 8; ++ch)
+            if (triangle.ComputeForChild( ch))
+                for (int v= 0; v < triangle.GetNumTriangles(); ++v)
+                    area+= triangle.GetAbsDet( v);
+    }
+    return 0.5*area;
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), N, N, N);
+        const BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+        const StokesVelBndDataCL::bnd_val_fun bnd_fun[6]= { ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel };
+        const StokesBndDataCL bnddata( 6, bc, bnd_fun);
+        const TwoPhaseFlowCoeffCL coeff( 1., 10., 1., 5., 0., Point3DCL());
+        InstatStokes2PhaseP2P1CL Stokes( brick, coeff, bnddata);
+        MultiGridCL& mg= Stokes.GetMG();
+
+        SurfaceTensionCL sf( sigma);
+        const BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+        const LsetBndDataCL lsbnd( 6, lsbc);
+        LevelsetP2ContCL lset( mg, lsbnd, sf);
+        lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+        lset.Phi.SetIdx( &lset.idx);
+        lset.Init( Sphere);
+        const InterfaceCutCacheCL& cache= lset.GetCutCache();
+
+        // volume and area fill the cache, the second call uses it
+        const double vol= lset.GetVolume(), area= lset.GetInterfaceArea();
+        const size_t misses= cache.GetMisses(), cut= cache.size();
+        status+= Check( "volume", std::fabs( vol - 4./3.*M_PI*R*R*R)/vol, 5e-2);
+        status+= Check( "area", std::fabs( area - 4.*M_PI*R*R)/area, 5e-2);
+        status+= Check( "area, triangles of the children", std::fabs( ChildTriangleArea( mg, lset) - area)/area, 1e-12);
+        status+= Check( "area, cached", std::fabs( lset.GetInterfaceArea() - area), 1e-15);
+        std::cout << "cut tetras: " << cut << ", hits: " << cache.GetHits() << ", misses: " << cache.GetMisses() << '\n';
+        status+= cut > 0 && misses == cut && cache.GetMisses() == misses && cache.GetHits() == 2*cut ? 0 : 1;
+
+        // The system matrices are the same with the cached subtriangulations.
+        Stokes.CreateNumberingVel( mg.GetLastLevel(), &Stokes.vel_idx);
+        Stokes.b.SetIdx( &Stokes.vel_idx);
+        Stokes.A.SetIdx( &Stokes.vel_idx, &Stokes.vel_idx);
+        Stokes.M.SetIdx( &Stokes.vel_idx, &Stokes.vel_idx);
+        VecDescCL cplA( &Stokes.vel_idx), cplM( &Stokes.vel_idx);
+        lset.GetCutCache().Clear();
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+        VectorCL x( Stokes.vel_idx.NumUnknowns());
+        for (size_t i= 0; i < x.size(); ++i)
+            x[i]= drand48();
+        const VectorCL Ax( Stokes.A.Data*x), Mx( Stokes.M.Data*x);
+        const size_t hits= cache.GetHits();
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+        std::cout << "SetupSystem1: hits: " << cache.GetHits() - hits << '\n';
+        status+= cache.GetHits() - hits == cut ? 0 : 1;
+        status+= Check( "A, cached", supnorm( VectorCL( Stokes.A.Data*x - Ax))/supnorm( Ax), 1e-15);
+        status+= Check( "M, cached", supnorm( VectorCL( Stokes.M.Data*x - Mx))/supnorm( Mx), 1e-15);
+
+        // A modified level set function is detected for each tetra, a new time step clears the cache.
+        lset.Phi.Data+= 0.01;
+        const size_t misses_mod= cache.GetMisses();
+        const double vol_mod= lset.GetVolume();
+        status+= cache.GetMisses() > misses_mod && vol_mod < vol ? 0 : 1;
+        status+= Check( "volume, translated level set", std::fabs( lset.GetVolume( -0.01) - vol)/vol, 1e-12);
+        lset.Phi.t+= 0.1;
+        status+= lset.GetCutCache().size() == 0 ? 0 : 1;
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
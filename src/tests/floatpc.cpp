@@ -0,0 +1,143 @@
+/// \file floatpc.cpp
+/// \brief tests the preconditioners with single precision matrices
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "num/precond.h"
+#include "num/krylovsolver.h"
+#include "parallel/exchange.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t N= 24; ///< grid points per direction
+
+/// \brief 7-point stencil of -div(k grad u) + c u on the unit cube with k= 1 + x*x and Dirichlet boundary values
+void Assemble (MatrixCL& A, double c)
+{
+    const size_t n= N*N*N;
+    SparseMatBuilderCL<double> b( &A, n, n);
+    for (size_t i= 0; i < N; ++i)
+        for (size_t j= 0; j < N; ++j)
+            for (size_t k= 0; k < N; ++k) {
+                const size_t row= (i*N + j)*N + k;
+                const int idx[3]= { int( i), int( j), int( k) };
+                b( row, row)+= c/(N*N);
+                for (int d= 0; d < 3; ++d)
+                    for (int s= -1; s <= 1; s+= 2) {
+                        int nb[3]= { idx[0], idx[1], idx[2] };
+                        nb[d]+= s;
+                        const double x= (i + 0.5*(d == 0 ? s : 0))/N,
+                            kappa= 1. + x*x;
+                        b( row, row)+= kappa;
+                        if (nb[d] >= 0 && nb[d] < int( N))
+                            b( row, (nb[0]*N + nb[1])*N + nb[2])-= kappa;
+                    }
+            }
+    b.Build();
+}
+
+/// \brief Maximal relative difference of the values of A and its single precision copy Af
+double ConversionError (const MatrixCL& A, const SparseMatBaseCL<float>& Af)
+{
+    if (Af.num_rows() != A.num_rows() || Af.num_nonzeros() != A.num_nonzeros())
+        return 1.;
+    double err= 0.;
+    for (size_t nz= 0; nz < A.num_nonzeros(); ++nz) {
+        if (Af.raw_col()[nz] != A.raw_col()[nz])
+            return 1.;
+        err= std::max( err, std::fabs( Af.raw_val()[nz] - A.raw_val()[nz])/std::fabs( A.raw_val()[nz]));
+    }
+    return err;
+}
+
+/// \brief Solve with the solver; returns the number of iterations, if the true residual is reduced by 1e-9, and maxiter otherwise.
+template <class SolverT>
+int Solve (SolverT& solver, const MatrixCL& A, const VectorCL& b)
+{
+    VectorCL x( b.size());
+    solver.Solve( A, x, b, DummyExchangeCL());
+    const double res= norm( VectorCL( A*x - b))/norm( b);
+    return res <= 1e-9 ? solver.GetIter() : solver.GetMaxIter();
+}
+
+int Test ()
+{
+    int status= 0;
+    MatrixCL A;
+    Assemble( A, 0.);
+    VectorCL b( A.num_rows());
+    for (size_t i= 0; i < b.size(); ++i)
+        b[i]= drand48();
+
+    SSORPcCL ssor;
+    FloatSSORPcCL fssor;
+    GMResSolverCL<SSORPcCL>      gmres( ssor, 50, 500, 1e-10);
+    GMResSolverCL<FloatSSORPcCL> fgmres( fssor, 50, 500, 1e-10);
+    const int it= Solve( gmres, A, b), fit= Solve( fgmres, A, b);
+    const double err= ConversionError( A, fssor.GetFloatMatrix());
+    std::cout << "GMRes-SSOR: " << it << " iterations, with float matrix: " << fit << " iterations, conversion error: " << err << '\n';
+    if (fit > it + 2 || err > 1e-7)
+        status= 1;
+
+    PCGSolverCL<SSORPcCL>      pcg( ssor, 500, 1e-10);
+    PCGSolverCL<FloatSSORPcCL> fpcg( fssor, 500, 1e-10);
+    const int pit= Solve( pcg, A, b), fpit= Solve( fpcg, A, b);
+    std::cout << "PCG-SSOR: " << pit << " iterations, with float matrix: " << fpit << " iterations\n";
+    if (fpit > pit + 2)
+        status= 1;
+
+    // The single precision copy follows the modifications of the matrix.
+    Assemble( A, 1e3);
+    const int fit2= Solve( fgmres, A, b);
+    const double err2= ConversionError( A, fssor.GetFloatMatrix());
+    std::cout << "modified matrix: GMRes-SSOR with float matrix: " << fit2 << " iterations, conversion error: " << err2 << '\n';
+    if (fit2 >= fgmres.GetMaxIter() || err2 > 1e-7)
+        status= 1;
+
+    // SSOR smoothing steps with start vector x as in a multigrid cycle
+    FloatSSORsmoothCL fsmoother;
+    SSORsmoothCL      smoother;
+    VectorCL x( b.size()), fx( b.size());
+    for (int i= 0; i < 5; ++i) {
+        smoother.Apply( A, x, b, DummyExchangeCL());
+        fsmoother.Apply( A, fx, b, DummyExchangeCL());
+    }
+    const double diff= norm( VectorCL( x - fx))/norm( x);
+    std::cout << "5 SSOR smoothing steps: relative difference of double and float matrix: " << diff << '\n';
+    if (diff > 1e-6)
+        status= 1;
+    return status;
+}
+
+int main ()
+{
+    try {
+        const int status= Test();
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,173 @@
+/// \file interfacetetras.cpp
+/// \brief tests the list of the tetras at the interface of the level set function
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "stokes/instatstokes2phase.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "misc/funcmap.h"
+
+#include <set>
+
+using namespace DROPS;
+
+const Uint   N= 8;    ///< subdivisions of the unit cube per direction
+const double R= 0.3;  ///< radius of the sphere
+
+Point3DCL ZeroVel (const Point3DCL&, double) { return Point3DCL(); }
+double    Zero    (const Point3DCL&, double) { return 0.; }
+double    sigma   (const Point3DCL&, double) { return 1.; }
+double    Sphere  (const Point3DCL& p, double) { return (p - Point3DCL( 0.5)).norm() - R; }
+
+// used by TwoPhaseFlowCoeffCL
+static RegisterVectorFunction regvelzerovel( "ZeroVel", ZeroVel);
+static RegisterScalarFunction regscazero( "Zero", Zero);
+
+typedef std::set<const TetraCL*> TetraSetT;
+
+TetraSetT ToSet (InterfaceTetraListCL::const_iterator begin, InterfaceTetraListCL::const_iterator end)
+{
+    TetraSetT s;
+    for (; begin != end; ++begin)
+        s.insert( &*begin);
+    return s;
+}
+
+/// \brief The cut tetras contain all tetras intersected by the interface; the band contains the cut tetras and their neighbors.
+int CheckList (const MultiGridCL& mg, const LevelsetP2CL& lset)
+{
+    const InterfaceTetraListCL& tetras= lset.GetInterfaceTetras();
+    const TetraSetT cut= ToSet( tetras.cut_begin(), tetras.cut_end()),
+                    band= ToSet( tetras.begin(), tetras.end());
+    InterfaceTriangleCL triangle;
+    size_t num_intersected= 0, num_tetra= 0;
+    int status= 0;
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, mg.GetLastLevel(), it) {
+        ++num_tetra;
+        triangle.Init( *it, lset.Phi, lset.GetBndData());
+        if (triangle.Intersects()) {
+            ++num_intersected;
+            if (cut.count( &*it) == 0)
+                status= 1;
+        }
+        if (band.count( &*it) == 0)
+            for (Uint v= 0; v < NumVertsC; ++v)
+                for (TetraSetT::const_iterator c= cut.begin(); c != cut.end(); ++c)
+                    if ((*c)->GetVertex( 0) == it->GetVertex( v) || (*c)->GetVertex( 1) == it->GetVertex( v)
+                        || (*c)->GetVertex( 2) == it->GetVertex( v) || (*c)->GetVertex( 3) == it->GetVertex( v))
+                        status= 1;
+    }
+    for (TetraSetT::const_iterator c= cut.begin(); c != cut.end(); ++c)
+        if (band.count( *c) == 0)
+            status= 1;
+    std::cout << "tetras: " << num_tetra << ", intersected: " << num_intersected << ", cut: " << tetras.num_cut()
+              << ", band: " << tetras.size() << '\n';
+    return status;
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), N, N, N);
+        const BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+        const StokesVelBndDataCL::bnd_val_fun bnd_fun[6]= { ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel };
+        const StokesBndDataCL bnddata( 6, bc, bnd_fun);
+        const TwoPhaseFlowCoeffCL coeff( 1., 10., 1., 5., 0., Point3DCL());
+        InstatStokes2PhaseP2P1CL Stokes( brick, coeff, bnddata, P1X_FE, 0.);
+        MultiGridCL& mg= Stokes.GetMG();
+
+        SurfaceTensionCL sf( sigma);
+        const BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+        const LsetBndDataCL lsbnd( 6, lsbc);
+        LevelsetP2ContCL lset( mg, lsbnd, sf);
+        lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+        lset.Phi.SetIdx( &lset.idx);
+        lset.Init( Sphere);
+
+        const size_t num_tetra= lset.GetInterfaceTetras().GetNumChecked();
+        status+= CheckList( mg, lset);
+
+        // Without a modification of the level set function, no tetra is checked again.
+        status+= lset.GetInterfaceTetras().GetNumChecked() == 0 ? 0 : 1;
+
+        // A small shift of the interface only rechecks the tetras at DoFs with a new sign; the result is the same as for a new list.
+        lset.Phi.Data-= 0.02;
+        const InterfaceTetraListCL& tetras= lset.GetInterfaceTetras();
+        const size_t checked= tetras.GetNumChecked();
+        std::cout << "shifted interface: checked tetras: " << checked << " of " << num_tetra << '\n';
+        status+= checked > 0 && checked < num_tetra/2 ? 0 : 1;
+        status+= CheckList( mg, lset);
+        InterfaceTetraListCL fresh;
+        fresh.Update( mg, lset.Phi, lset.GetBndData());
+        status+= ToSet( fresh.cut_begin(), fresh.cut_end()) == ToSet( tetras.cut_begin(), tetras.cut_end()) ? 0 : 1;
+        status+= ToSet( fresh.begin(), fresh.end()) == ToSet( tetras.begin(), tetras.end()) ? 0 : 1;
+
+        // wider band
+        lset.SetInterfaceBand( 2);
+        const size_t band1= tetras.size();
+        status+= lset.GetInterfaceTetras().size() > band1 ? 0 : 1;
+        status+= CheckList( mg, lset);
+
+        // The surface force on the cut tetras is the same for the serial and the colored accumulation.
+        Stokes.CreateNumberingVel( mg.GetLastLevel(), &Stokes.vel_idx);
+        VecDescCL f( &Stokes.vel_idx), f_col( &Stokes.vel_idx);
+        lset.SetSurfaceForce( SF_Const);
+#ifdef _OPENMP
+        const int num_threads= omp_get_max_threads();
+        omp_set_num_threads( 1);
+        lset.AccumulateBndIntegral( f);
+        omp_set_num_threads( 2);
+        lset.AccumulateBndIntegral( f_col);
+        omp_set_num_threads( num_threads);
+#else
+        lset.AccumulateBndIntegral( f);
+        lset.AccumulateBndIntegral( f_col);
+#endif
+        std::cout << "surface force: norm: " << norm( f.Data) << ", difference of the colored accumulation: " << supnorm( VectorCL( f.Data - f_col.Data)) << '\n';
+        status+= norm( f.Data) > 0. && supnorm( VectorCL( f.Data - f_col.Data)) < 1e-12*supnorm( f.Data) ? 0 : 1;
+
+        // The extended pressure DoFs are the same as for the sweep over all tetras.
+        Stokes.CreateNumberingPr( mg.GetLastLevel(), &Stokes.pr_idx, 0, &lset);
+        ExtIdxDescCL& xidx= Stokes.pr_idx.GetFinest().GetXidx();
+        std::vector<IdxT> all( xidx.GetNumUnknownsStdFE());
+        Stokes.pr_idx.UpdateXNumbering( mg, *lset.PhiC, lset.GetBndData());
+        const IdxT num_all= Stokes.pr_idx.NumUnknowns();
+        for (size_t i= 0; i < all.size(); ++i)
+            all[i]= xidx[i];
+        Stokes.UpdateXNumbering( &Stokes.pr_idx, lset);
+        std::cout << "pressure unknowns: " << num_all << ", with the cut tetras: " << Stokes.pr_idx.NumUnknowns() << '\n';
+        status+= num_all == Stokes.pr_idx.NumUnknowns() && num_all > xidx.GetNumUnknownsStdFE() ? 0 : 1;
+        for (size_t i= 0; i < all.size(); ++i)
+            if (all[i] != xidx[i])
+                status= 1;
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
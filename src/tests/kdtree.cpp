@@ -0,0 +1,150 @@
+/// \file kdtree.cpp
+/// \brief tests the parallel construction of the kd-tree and the batched search against a search by brute force
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "misc/kd-tree/tree_builder.h"
+#include "misc/kd-tree/search.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+typedef KDTree::TreeCL<double,3>                          TreeT;
+typedef KDTree::SearchNearestNeighborsCL<2,double,3,12>   SearcherT;
+
+const size_t NumPoints= 200000, ///< points in the tree
+             NumQuery = 20000,  ///< query points
+             NumNeigh = 8;      ///< searched neighbors
+
+/// \brief Store the distance to the farthest of the nearest neighbors of each query point
+class StoreCL
+{
+  private:
+    std::vector<double>& dist_;
+  public:
+    StoreCL( std::vector<double>& dist) : dist_( dist) {}
+    void operator() (size_t i, const SearcherT& searcher) const {
+        double d= 0.;
+        for (size_t n= 0; n < searcher.result().size(); ++n)
+            d= std::max( d, searcher.result()[n].distance());
+        dist_[i]= d;
+    }
+};
+
+/// \brief Distance to the NumNeigh-th nearest point by brute force
+double BruteForce (const std::vector<double>& points, const double* q)
+{
+    std::vector<double> d( points.size()/3);
+    for (size_t i= 0; i < d.size(); ++i)
+        d[i]= std::sqrt( std::pow( points[3*i] - q[0], 2) + std::pow( points[3*i+1] - q[1], 2) + std::pow( points[3*i+2] - q[2], 2));
+    std::nth_element( d.begin(), d.begin() + NumNeigh - 1, d.end());
+    return d[NumNeigh - 1];
+}
+
+/// \brief Many identical points: the node of the hat above them becomes a leaf, whose point must not be lost.
+int TestDuplicates ()
+{
+    const double dup[3]= { 0.3, 0.3, 0.3 };
+    std::vector<double> points;
+    for (size_t i= 0; i < 3*40; ++i)
+        points.push_back( drand48());
+    for (size_t i= 0; i < 60; ++i)
+        points.insert( points.end(), dup, dup + 3);
+
+    TreeT tree;
+    KDTree::TreeBuilderCL<double,3> builder( tree);
+    builder.build( points);
+    SearcherT searcher( tree, dup, 1);
+    searcher.search();
+    const double d= searcher.result()[0].distance();
+    std::cout << "duplicate points: " << tree.size() << " points, distance to the duplicate point: " << d << '\n';
+    return d != 0. ? 1 : 0;
+}
+
+int main ()
+{
+    try {
+        std::vector<double> points( 3*NumPoints), queries( 3*NumQuery);
+        for (size_t i= 0; i < points.size(); ++i)
+            points[i]= drand48();
+        for (size_t i= 0; i < queries.size(); ++i)
+            queries[i]= 1.2*drand48() - 0.1;
+
+        const int max_threads=
+#ifdef _OPENMP
+            omp_get_max_threads();
+#else
+            1;
+#endif
+        int status= 0;
+        std::vector<double> dist( NumQuery), batch_dist( NumQuery);
+        // At least two threads are used to test the parallel code paths.
+        for (int t= 1; t <= std::max( 2, max_threads); t*= 2) {
+#ifdef _OPENMP
+            omp_set_num_threads( t);
+#endif
+            TreeT tree;
+            KDTree::TreeBuilderCL<double,3> builder( tree);
+            TimerCL timer;
+            timer.Start();
+            builder.build( points);
+            timer.Stop();
+            std::cout << t << " threads: build: " << timer.GetTime() << " s, " << tree.size() << " points";
+            if (tree.size() != NumPoints)
+                status= 1;
+
+            timer.Reset();
+            const StoreCL store_single( dist);
+            for (size_t i= 0; i < NumQuery; ++i) {
+                SearcherT searcher( tree, &queries[3*i], NumNeigh);
+                searcher.search();
+                store_single( i, searcher);
+            }
+            timer.Stop();
+            std::cout << ", search: " << timer.GetTime() << " s";
+
+            timer.Reset();
+            StoreCL store( batch_dist);
+            KDTree::search_batch<SearcherT>( tree, &queries[0], NumQuery, NumNeigh, store);
+            timer.Stop();
+            std::cout << ", batched search: " << timer.GetTime() << " s\n";
+
+            for (size_t i= 0; i < NumQuery; ++i)
+                if (dist[i] != batch_dist[i])
+                    status= 1;
+            for (size_t i= 0; i < NumQuery; i+= 100)
+                if (std::abs( dist[i] - BruteForce( points, &queries[3*i])) > 1e-14)
+                    status= 1;
+        }
+#ifdef _OPENMP
+        omp_set_num_threads( max_threads);
+#endif
+        status+= TestDuplicates();
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,127 @@
+/// \file locate.cpp
+/// \brief compares and times the point location of LocatorCL with the search tree and with a linear search
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "num/gauss.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+/// \brief The linear search over the tetras of level 0, which LocatorCL::Locate used before the search tree.
+void LinearLocate (LocationCL& loc, const MultiGridCL& mg, const Point3DCL& p, double tol= 1e-14)
+{
+    SMatrixCL<4,4> M;
+    SVectorCL<4> b;
+    for (MultiGridCL::const_TetraIterator it= mg.GetTetrasBegin( 0), end= mg.GetTetrasEnd( 0); it != end; ++it) {
+        for (Uint j= 0; j < 4; ++j) {
+            for (Uint i= 0; i < 3; ++i)
+                M( i, j)= it->GetVertex( j)->GetCoord()[i];
+            M( 3, j)= 1.;
+        }
+        std::copy( p.begin(), p.end(), b.begin());
+        b[3]= 1.;
+        gauss_pivot( M, b);
+        bool in= true;
+        for (Uint i= 0; i < 4; ++i)
+            in= in && b[i] >= -tol && b[i] <= 1. + tol;
+        if (in) {
+            loc= LocationCL( &*it, b);
+            LocatorCL::LocateInTetra( loc, mg.GetLastLevel(), p, tol);
+            return;
+        }
+    }
+    loc= LocationCL();
+}
+
+int Compare (const LocationCL& a, const LocationCL& b)
+{
+    if (a.IsValid() != b.IsValid())
+        return 1;
+    if (!a.IsValid())
+        return 0;
+    return &a.GetTetra() == &b.GetTetra() && (a.GetBaryCoord() - b.GetBaryCoord()).norm() < 1e-12 ? 0 : 1;
+}
+
+int main ()
+{
+    try {
+        BrickBuilderCL brick( std_basis<3>( 0), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 10, 10, 10);
+        MultiGridCL mg( brick);
+        DROPS_FOR_TRIANG_TETRA( mg, -1, It)
+            if ((GetBaryCenter( *It) - Point3DCL( 0.5)).norm() < 0.3)
+                It->SetRegRefMark();
+        mg.Refine();
+        int status= 0;
+
+        // Points in the cube, on vertices of level 0 and outside the cube.
+        std::vector<Point3DCL> p( 2000);
+        for (size_t i= 0; i < p.size(); ++i)
+            for (Uint j= 0; j < 3; ++j)
+                p[i][j]= i%10 == 0 ? std::floor( 10.*drand48())/10. : 1.2*drand48() - 0.1;
+
+        std::vector<LocationCL> ref( p.size()), loc( p.size());
+        TimerCL timer;
+        timer.Start();
+        for (size_t i= 0; i < p.size(); ++i)
+            LinearLocate( ref[i], mg, p[i]);
+        timer.Stop();
+        std::cout << "linear search: " << timer.GetTime() << " s\n";
+
+        timer.Reset();
+        timer.Start();
+        for (size_t i= 0; i < p.size(); ++i)
+            LocatorCL::Locate( loc[i], mg, -1, p[i]);
+        timer.Stop();
+        std::cout << "search tree: " << timer.GetTime() << " s, " << mg.GetTetraBoxTree( 0).num_nodes() << " nodes\n";
+        for (size_t i= 0; i < p.size(); ++i)
+            status+= Compare( loc[i], ref[i]);
+
+        std::vector<LocationCL> batch;
+        timer.Reset();
+        timer.Start();
+        LocatorCL::Locate( batch, mg, -1, p);
+        timer.Stop();
+        std::cout << "batched search tree: " << timer.GetTime() << " s\n";
+        for (size_t i= 0; i < p.size(); ++i)
+            status+= Compare( batch[i], ref[i]);
+
+        // The tree is rebuilt after a modification of the multigrid.
+        const size_t version= mg.GetTetraBoxTree( 0).GetVersion();
+        mg.Refine();
+        status+= mg.GetTetraBoxTree( 0).GetVersion() != version ? 0 : 1;
+        LocatorCL::Locate( batch, mg, -1, p);
+        for (size_t i= 0; i < p.size(); ++i) {
+            LinearLocate( ref[i], mg, p[i]);
+            status+= Compare( batch[i], ref[i]);
+        }
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,198 @@
+/// \file mgreuse.cpp
+/// \brief tests the reuse of the multigrid setup in MGSolverCL
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+// The Asserts of the smoothers on the matrix version are the subject of TestReuseBeforeFirstSolve.
+#define DROPSDebugC DebugNumericC
+
+#include "misc/utils.h"
+#include "num/MGsolver.h"
+#include "num/precond.h"
+#include "num/gauss.h"
+
+using namespace DROPS;
+
+const Uint NumLvl= 5; ///< the coarsest level has 3, the finest 63 interior grid points
+
+/// \brief Dense Gaussian elimination with the interface of the direct solvers in num/directsolver.h; counts the factorizations.
+class DenseSolverCL
+{
+  private:
+    std::vector<double> A_;
+    size_t n_;
+
+  public:
+    static Uint num_update;
+
+    DenseSolverCL (const MatrixCL& A) { Update( A); }
+    void Update (const MatrixCL& A) {
+        n_= A.num_rows();
+        A_.assign( n_*n_, 0.);
+        for (size_t i= 0; i < n_; ++i)
+            for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+                A_[i*n_ + A.col_ind( nz)]= A.val( nz);
+        ++num_update;
+    }
+    void Solve (const MatrixCL&, VectorCL& x, const VectorCL& b) {
+        DMatrixCL<double> M( n_, n_);
+        for (size_t i= 0; i < n_; ++i)
+            for (size_t j= 0; j < n_; ++j)
+                M( i, j)= A_[i*n_ + j];
+        x= b;
+        gauss_pivot( M, x);
+    }
+};
+
+Uint DenseSolverCL::num_update= 0;
+
+/// \brief Linear interpolation from n coarse to 2n+1 fine interior grid points
+void Prolongation (MatrixCL& P, size_t n)
+{
+    SparseMatBuilderCL<double> b( &P, 2*n + 1, n);
+    for (size_t i= 0; i < n; ++i) {
+        b( 2*i, i)= 0.5;
+        b( 2*i + 1, i)= 1.;
+        b( 2*i + 2, i)= 0.5;
+    }
+    b.Build();
+}
+
+/// \brief -u'' + c u on (0,1) with Dirichlet boundary values on the finest level, Galerkin products on the coarser levels
+void Assemble (MLMatrixCL& A, const MLMatrixCL& P, double c)
+{
+    MLMatrixCL::reverse_iterator fine= A.rbegin();
+    const size_t n= A.GetFinest().num_rows();
+    const double h= 1./(n + 1);
+    SparseMatBuilderCL<double> b( &*fine, n, n);
+    for (size_t i= 0; i < n; ++i) {
+        b( i, i)= 2./(h*h) + c;
+        if (i > 0)     b( i, i - 1)= -1./(h*h);
+        if (i < n - 1) b( i, i + 1)= -1./(h*h);
+    }
+    b.Build();
+    MLMatrixCL::const_reverse_iterator p= P.rbegin();
+    for (MLMatrixCL::reverse_iterator coarse= ++A.rbegin(); coarse != A.rend(); ++coarse, ++fine, ++p) {
+        MatrixCL R, AP;
+        transpose( *p, R);
+        mat_mul( *fine, *p, AP);
+        mat_mul( R, AP, *coarse);
+    }
+}
+
+int Test ()
+{
+    int status= 0;
+    MLIdxDescCL idx( P1_FE, NumLvl);
+    MLMatrixCL A( NumLvl);
+    MLSmootherCL<SGSsmoothCL> smoother;
+    MGDirectCoarseSolverCL<DenseSolverCL> coarse;
+    MGSolverCL<MLSmootherCL<SGSsmoothCL>, MGDirectCoarseSolverCL<DenseSolverCL> > solver( smoother, coarse, 50, 1e-10, idx, /*residerr*/ false);
+    MLMatrixCL& P= *solver.GetProlongation();
+    P.resize( NumLvl);
+    size_t n= 3;
+    MLMatrixCL::iterator p= ++P.begin();
+    for (Uint l= 1; l < NumLvl; ++l, ++p, n= 2*n + 1)
+        Prolongation( *p, n);
+    A.GetFinest().resize( n, n, 0);
+    VectorCL b( 1., n), x( n);
+
+    // Without reuse, the coarse matrix is factorized, if it has been modified.
+    Assemble( A, P, 0.);
+    solver.Solve( A, x, b, DummyExchangeCL());
+    Assemble( A, P, 1.);
+    x= 0.;
+    solver.Solve( A, x, b, DummyExchangeCL());
+    std::cout << "without reuse: setups: " << solver.GetNumSetups() << ", factorizations: " << coarse.GetNumFactorizations() << '\n';
+    if (solver.GetNumSetups() != 2 || coarse.GetNumFactorizations() != 2)
+        status= 1;
+
+    // Small modifications of the matrix: the factorization is reused.
+    solver.SetReuse( 3.);
+    for (int step= 0; step < 5; ++step) {
+        Assemble( A, P, 1. + step);
+        x= 0.;
+        solver.Solve( A, x, b, DummyExchangeCL());
+        std::cout << "step " << step << ": iterations: " << solver.GetIter() << ", rate: " << solver.GetRate() << '\n';
+        if (solver.GetResid() > 1e-10)
+            status= 1;
+    }
+    std::cout << "with reuse: setups: " << solver.GetNumSetups() << ", factorizations: " << coarse.GetNumFactorizations() << '\n';
+    if (solver.GetNumSetups() != 3 || coarse.GetNumFactorizations() != 3)
+        status= 1;
+
+    // A large modification (-u'' - 9u is almost singular) degrades the convergence rate; the next solve sets up again.
+    Assemble( A, P, -9.);
+    x= 0.;
+    solver.Solve( A, x, b, DummyExchangeCL());
+    const double rate_stale= solver.GetRate();
+    x= 0.;
+    solver.Solve( A, x, b, DummyExchangeCL());
+    std::cout << "large modification: rate: " << rate_stale << ", after the new setup: " << solver.GetRate()
+              << ", setups: " << solver.GetNumSetups() << ", factorizations: " << coarse.GetNumFactorizations() << '\n';
+    if (solver.GetNumSetups() != 4 || coarse.GetNumFactorizations() != 4 || solver.GetRate() >= rate_stale || solver.GetResid() > 1e-10)
+        status= 1;
+    return status;
+}
+
+/// \brief SetReuse before the first Solve, as in the solver factories: the smoothers created by the setup must not check the matrix version.
+int TestReuseBeforeFirstSolve ()
+{
+    int status= 0;
+    MLIdxDescCL idx( P1_FE, NumLvl);
+    MLMatrixCL A( NumLvl);
+    MLSmootherCL<ChebyshevsmoothCL> smoother;
+    MGDirectCoarseSolverCL<DenseSolverCL> coarse;
+    MGSolverCL<MLSmootherCL<ChebyshevsmoothCL>, MGDirectCoarseSolverCL<DenseSolverCL> > solver( smoother, coarse, 50, 1e-10, idx, /*residerr*/ false);
+    solver.SetReuse( 3.);
+    MLMatrixCL& P= *solver.GetProlongation();
+    P.resize( NumLvl);
+    size_t n= 3;
+    MLMatrixCL::iterator p= ++P.begin();
+    for (Uint l= 1; l < NumLvl; ++l, ++p, n= 2*n + 1)
+        Prolongation( *p, n);
+    A.GetFinest().resize( n, n, 0);
+    VectorCL b( 1., n), x( n);
+
+    for (int step= 0; step < 3; ++step) {
+        Assemble( A, P, 1. + step);
+        x= 0.;
+        solver.Solve( A, x, b, DummyExchangeCL());
+        std::cout << "reuse from the start, step " << step << ": iterations: " << solver.GetIter() << ", setups: " << solver.GetNumSetups() << '\n';
+        if (solver.GetResid() > 1e-10)
+            status= 1;
+    }
+    if (solver.GetNumSetups() != 1)
+        status= 1;
+    return status;
+}
+
+int main ()
+{
+    try {
+        const int status= Test() + TestReuseBeforeFirstSolve();
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
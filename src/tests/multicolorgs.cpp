@@ -0,0 +1,127 @@
+/// \file multicolorgs.cpp
+/// \brief tests the multicolor Gauss-Seidel/SSOR preconditioners
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/krylovsolver.h"
+#include "num/precond.h"
+#include "misc/utils.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t N= 40; ///< grid points per direction
+
+/// \brief 27-point Laplacian on a NxNxN-grid
+void BuildMatrix (MatrixCL& A)
+{
+    SparseMatBuilderCL<double> bA( &A, N*N*N, N*N*N);
+    for (size_t k= 0; k < N; ++k)
+        for (size_t j= 0; j < N; ++j)
+            for (size_t i= 0; i < N; ++i) {
+                const size_t p= i + N*(j + N*k);
+                bA( p, p)= 27.;
+                for (int dk= -1; dk <= 1; ++dk)
+                    for (int dj= -1; dj <= 1; ++dj)
+                        for (int di= -1; di <= 1; ++di)
+                            if ((di != 0 || dj != 0 || dk != 0) && i + di < N && j + dj < N && k + dk < N)
+                                bA( p, (i + di) + N*((j + dj) + N*(k + dk)))= -1.;
+            }
+    bA.Build();
+}
+
+/// \brief Rows of the same color must not be coupled.
+int CheckColoring (const MatrixCL& A, const SparseMatColoringCL& col)
+{
+    std::vector<size_t> color( A.num_rows(), col.num_colors());
+    size_t num= 0;
+    for (size_t c= 0; c < col.num_colors(); ++c)
+        for (const size_t* r= col.color_begin( c); r != col.color_end( c); ++r, ++num)
+            color[*r]= c;
+    int status= num == A.num_rows() ? 0 : 1;
+    for (size_t i= 0; i < A.num_rows(); ++i)
+        for (size_t nz= A.row_beg( i); nz < A.row_beg( i + 1); ++nz)
+            if (A.col_ind( nz) != i && color[A.col_ind( nz)] == color[i])
+                status= 1;
+    std::cout << "colors: " << col.num_colors() << (status == 0 ? "\tvalid coloring\n" : "\tinvalid coloring\n");
+    return status;
+}
+
+/// \brief Solve with PCG and the preconditioner pc.
+template <class PcT>
+int Solve (const char* name, const MatrixCL& A, const VectorCL& b, PcT& pc)
+{
+    VectorCL x( A.num_rows());
+    int    maxiter= 500;
+    double tol= 1e-10;
+    TimerCL timer;
+    timer.Start();
+    PCG( A, x, b, DummyExchangeCL(), pc, maxiter, tol, true);
+    timer.Stop();
+    std::cout << name << ": iterations: " << maxiter << "\tresidual: " << tol << "\ttime: " << timer.GetTime() << " s\n";
+    return tol < 1e-10 ? 0 : 1;
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        MatrixCL A;
+        BuildMatrix( A);
+        VectorCL b( A.num_rows());
+        for (size_t i= 0; i < b.size(); ++i)
+            b[i]= drand48();
+
+        TimerCL timer;
+        timer.Start();
+        SparseMatColoringCL col( A);
+        timer.Stop();
+        std::cout << "coloring: " << timer.GetTime() << " s\n";
+        status+= CheckColoring( A, col);
+
+        // SSOR0 and SSOR with start vector 0 coincide.
+        VectorCL x0( A.num_rows()), x1( 1., A.num_rows());
+        SolveGSstep<true, VectorCL>( PreDummyCL<PB_MCSGS>(), A, x0, b, col, 1.3);
+        SolveGSstep<true, VectorCL>( PreDummyCL<PB_MCSGS0>(), A, x1, b, col, 1.3);
+        const double err= supnorm( VectorCL( x0 - x1));
+        std::cout << "SSOR0 - SSOR: " << err << '\n';
+        status+= err < 1e-14 ? 0 : 1;
+
+        SSORPcCL ssor;
+        MCSSORPcCL mcssor;
+        status+= Solve( "SSOR", A, b, ssor);
+        status+= Solve( "multicolor SSOR", A, b, mcssor);
+        // The coloring is kept, if only the values of A change.
+        const SparseMatColoringCL* colp= &mcssor.GetColoring();
+        const size_t num_colors= colp->num_colors();
+        A*= 2.;
+        status+= Solve( "multicolor SSOR, scaled matrix", A, b, mcssor);
+        status+= colp->SamePattern( A) && colp->num_colors() == num_colors ? 0 : 1;
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
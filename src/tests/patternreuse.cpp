@@ -0,0 +1,168 @@
+/// \file patternreuse.cpp
+/// \brief tests the reuse of the sparsity pattern in SparseMatBuilderCL and in the setup of A and M for two-phase Stokes
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "stokes/instatstokes2phase.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "misc/funcmap.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+const Uint N= 8; ///< subdivisions of the unit cube per direction
+
+Point3DCL ZeroVel (const Point3DCL&, double) { return Point3DCL(); }
+double    Zero    (const Point3DCL&, double) { return 0.; }
+double    sigma   (const Point3DCL&, double) { return 1.; }
+double    Sphere  (const Point3DCL& p, double) { return (p - Point3DCL( 0.5)).norm() - 0.3; }
+
+// used by TwoPhaseFlowCoeffCL
+static RegisterVectorFunction regvelzerovel( "ZeroVel", ZeroVel);
+static RegisterScalarFunction regscazero( "Zero", Zero);
+
+int Check (const char* name, double err)
+{
+    std::cout << name << ": error: " << err << '\n';
+    return err < 1e-12 ? 0 : 1;
+}
+
+void FillRandom (SMatrixCL<3,3>& b)
+{
+    for (Uint i= 0; i < 3; ++i)
+        for (Uint j= 0; j < 3; ++j)
+            b( i, j)= drand48();
+}
+
+void FillRandom (SDiagMatrixCL<3>& b)
+{
+    for (Uint i= 0; i < 3; ++i)
+        b( i)= drand48();
+}
+
+/// \brief Assemble a random matrix with blocks of type BlockT twice, the second time with reuse of the pattern.
+template <class BlockT>
+int CheckBuilder (const char* name)
+{
+    const size_t n= 3*50;
+    MatrixCL A;
+    std::vector<std::pair<size_t, size_t> > blocks;
+    std::vector<BlockT> values;
+    for (size_t k= 0; k < 500; ++k) {
+        blocks.push_back( std::make_pair( 3*(lrand48()%(n/3)), 3*(lrand48()%(n/3))));
+        BlockT b;
+        FillRandom( b);
+        values.push_back( b);
+    }
+    SparseMatBuilderCL<double, BlockT> bA( &A, n, n);
+    for (size_t k= 0; k < blocks.size(); ++k)
+        bA( blocks[k].first, blocks[k].second)+= values[k];
+    bA.Build();
+    const MatrixCL ref( A);
+
+    A*= 3.; // the reuse must overwrite the values
+    SparseMatBuilderCL<double, BlockT> bA2( &A, n, n, true);
+    for (size_t k= 0; k < blocks.size(); ++k) {
+        bA2( blocks[k].first, blocks[k].second)+= values[k];
+        bA2( blocks[k].first, blocks[k].second)-= values[k];
+        bA2( blocks[k].first, blocks[k].second)+= values[k];
+    }
+    bA2.Build();
+    double err= A.num_nonzeros() == ref.num_nonzeros() ? 0. : 1.;
+    for (size_t nz= 0; nz < A.num_nonzeros(); ++nz)
+        err= std::max( err, std::fabs( A.val( nz) - ref.val( nz)));
+    return Check( name, err);
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        status+= CheckBuilder<SMatrixCL<3,3> >( "builder, SMatrixCL<3,3>");
+        status+= CheckBuilder<SDiagMatrixCL<3> >( "builder, SDiagMatrixCL<3>");
+
+        BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), N, N, N);
+        const BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+        const StokesVelBndDataCL::bnd_val_fun bnd_fun[6]= { ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel };
+        const StokesBndDataCL bnddata( 6, bc, bnd_fun);
+        const TwoPhaseFlowCoeffCL coeff( 1., 10., 1., 5., 0., Point3DCL());
+        InstatStokes2PhaseP2P1CL Stokes( brick, coeff, bnddata);
+        MultiGridCL& mg= Stokes.GetMG();
+
+        SurfaceTensionCL sf( sigma);
+        const BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+        const LsetBndDataCL lsbnd( 6, lsbc);
+        LevelsetP2ContCL lset( mg, lsbnd, sf);
+        lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+        lset.Phi.SetIdx( &lset.idx);
+        lset.Init( Sphere);
+
+        Stokes.CreateNumberingVel( mg.GetLastLevel(), &Stokes.vel_idx);
+        Stokes.b.SetIdx( &Stokes.vel_idx);
+        Stokes.A.SetIdx( &Stokes.vel_idx, &Stokes.vel_idx);
+        Stokes.M.SetIdx( &Stokes.vel_idx, &Stokes.vel_idx);
+        VecDescCL cplA( &Stokes.vel_idx), cplM( &Stokes.vel_idx);
+        std::cout << "velocity unknowns: " << Stokes.vel_idx.NumUnknowns() << '\n';
+
+        TimerCL timer;
+        timer.Start();
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+        timer.Stop();
+        std::cout << "setup with new pattern: " << timer.GetTime() << " s\n";
+        VectorCL x( Stokes.vel_idx.NumUnknowns());
+        for (size_t i= 0; i < x.size(); ++i)
+            x[i]= drand48();
+        const VectorCL Ax( Stokes.A.Data*x), Mx( Stokes.M.Data*x);
+
+        Stokes.SetPatternReuse( true);
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.); // records the pattern key
+        const size_t versionA= Stokes.A.Data.GetFinest().Version();
+        timer.Reset();
+        timer.Start();
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+        timer.Stop();
+        std::cout << "setup with reused pattern: " << timer.GetTime() << " s\n";
+        status+= Stokes.A.Data.GetFinest().HasPatternKey( Stokes.vel_idx.GetFinest().GetNumberingVersion()) ? 0 : 1;
+        status+= Stokes.A.Data.GetFinest().Version() > versionA ? 0 : 1; // the values changed
+        status+= Check( "A, reused pattern", supnorm( VectorCL( Stokes.A.Data*x - Ax))/supnorm( Ax));
+        status+= Check( "M, reused pattern", supnorm( VectorCL( Stokes.M.Data*x - Mx))/supnorm( Mx));
+
+        // A new numbering invalidates the pattern.
+        const size_t numb_version= Stokes.vel_idx.GetFinest().GetNumberingVersion();
+        Stokes.DeleteNumbering( &Stokes.vel_idx);
+        Stokes.CreateNumberingVel( mg.GetLastLevel(), &Stokes.vel_idx);
+        status+= Stokes.vel_idx.GetFinest().GetNumberingVersion() != numb_version ? 0 : 1;
+        status+= Stokes.A.Data.GetFinest().HasPatternKey( Stokes.vel_idx.GetFinest().GetNumberingVersion()) ? 1 : 0;
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+        status+= Check( "A, new numbering", supnorm( VectorCL( Stokes.A.Data*x - Ax))/supnorm( Ax));
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
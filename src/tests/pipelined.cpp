@@ -0,0 +1,121 @@
+/// \file pipelined.cpp
+/// \brief tests pipelined PCG and GMRES with CGS2 orthogonalization against PCG and GMRES
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "num/precond.h"
+#include "num/krylovsolver.h"
+#include "parallel/exchange.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t N= 20; ///< grid points per direction
+
+/// \brief 7-point stencil of -laplace(u) + c*du/dx on the unit cube with Dirichlet boundary values; upwind differences for the convection.
+void Assemble (MatrixCL& A, double c)
+{
+    const size_t n= N*N*N;
+    SparseMatBuilderCL<double> b( &A, n, n);
+    for (size_t i= 0; i < N; ++i)
+        for (size_t j= 0; j < N; ++j)
+            for (size_t k= 0; k < N; ++k) {
+                const size_t row= (i*N + j)*N + k;
+                const int idx[3]= { int( i), int( j), int( k) };
+                b( row, row)+= 6. + c;
+                for (int d= 0; d < 3; ++d)
+                    for (int s= -1; s <= 1; s+= 2) {
+                        int nb[3]= { idx[0], idx[1], idx[2] };
+                        nb[d]+= s;
+                        if (nb[d] < 0 || nb[d] >= int( N))
+                            continue;
+                        b( row, (nb[0]*N + nb[1])*N + nb[2])-= 1. + (d == 0 && s == -1 ? c : 0.);
+                    }
+            }
+    b.Build();
+}
+
+/// \brief Solve and print the number of iterations; returns 1, if the true residual is not reduced by 1e-7.
+template <class SolverT>
+int Solve (SolverT& solver, const MatrixCL& A, const VectorCL& b, const char* name, int& iter)
+{
+    VectorCL x( b.size());
+    solver.Solve( A, x, b, DummyExchangeCL());
+    iter= solver.GetIter();
+    const double res= norm( VectorCL( A*x - b))/norm( b);
+    std::cout << name << ": " << iter << " iterations, residual: " << res << '\n';
+    return res <= 1e-7 ? 0 : 1;
+}
+
+int TestCG ()
+{
+    MatrixCL A;
+    Assemble( A, 0.);
+    VectorCL b( A.num_rows());
+    for (size_t i= 0; i < b.size(); ++i)
+        b[i]= drand48();
+
+    SSORPcCL pc;
+    PCGSolverCL<SSORPcCL> pcg( pc, 500, 1e-9, /*relative*/ true);
+    PipelinedPCGSolverCL<SSORPcCL> ppcg( pc, 500, 1e-9, /*relative*/ true);
+    int it_pcg, it_ppcg;
+    int status= Solve( pcg, A, b, "PCG", it_pcg) + Solve( ppcg, A, b, "pipelined PCG", it_ppcg);
+    // Both methods are equivalent in exact arithmetic.
+    if (std::abs( it_pcg - it_ppcg) > 2)
+        status= 1;
+    return status;
+}
+
+int TestGMRES ()
+{
+    MatrixCL A;
+    Assemble( A, 20.);
+    VectorCL b( A.num_rows());
+    for (size_t i= 0; i < b.size(); ++i)
+        b[i]= drand48();
+
+    JACPcCL pc;
+    int status= 0;
+    // With restart 10, the CGS2 orthogonalization must not spoil the convergence after restarts.
+    for (int restart= 10; restart <= 100; restart+= 90) {
+        GMResSolverCL<JACPcCL> gmres( pc, restart, 500, 1e-9, /*relative*/ true);
+        CGS2GMResSolverCL<JACPcCL> cgs2gmres( pc, restart, 500, 1e-9, /*relative*/ true);
+        int it_gmres, it_cgs2;
+        status+= Solve( gmres, A, b, "GMRES", it_gmres) + Solve( cgs2gmres, A, b, "CGS2-GMRES", it_cgs2);
+        if (std::abs( it_gmres - it_cgs2) > 2)
+            status= 1;
+    }
+    return status;
+}
+
+int main ()
+{
+    try {
+        const int status= TestCG() + TestGMRES();
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
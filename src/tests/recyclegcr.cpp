@@ -0,0 +1,107 @@
+/// \file recyclegcr.cpp
+/// \brief tests GCR with recycling of search directions for a sequence of similar systems
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "num/precond.h"
+#include "num/krylovsolver.h"
+#include "parallel/exchange.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t N= 16; ///< grid points per direction
+
+/// \brief 7-point stencil of -laplace(u) + c*du/dx on the unit cube with Dirichlet boundary values; upwind differences for the convection.
+void Assemble (MatrixCL& A, double c)
+{
+    const size_t n= N*N*N;
+    SparseMatBuilderCL<double> b( &A, n, n);
+    for (size_t i= 0; i < N; ++i)
+        for (size_t j= 0; j < N; ++j)
+            for (size_t k= 0; k < N; ++k) {
+                const size_t row= (i*N + j)*N + k;
+                const int idx[3]= { int( i), int( j), int( k) };
+                b( row, row)+= 6. + c;
+                for (int d= 0; d < 3; ++d)
+                    for (int s= -1; s <= 1; s+= 2) {
+                        int nb[3]= { idx[0], idx[1], idx[2] };
+                        nb[d]+= s;
+                        if (nb[d] < 0 || nb[d] >= int( N))
+                            continue;
+                        b( row, (nb[0]*N + nb[1])*N + nb[2])-= 1. + (d == 0 && s == -1 ? c : 0.);
+                    }
+            }
+    b.Build();
+}
+
+/// \brief Solve a sequence of systems, which mimics a coupling iteration: the matrix and the right hand side change
+/// slightly and the last solution is the initial guess. Returns 1, if a solve does not converge.
+template <class SolverT>
+int SolveSequence (SolverT& solver, const VectorCL& b0, const VectorCL& b1, int& totaliter)
+{
+    int status= 0;
+    totaliter= 0;
+    VectorCL x( b0.size());
+    MatrixCL A;
+    for (int i= 0; i < 8; ++i) {
+        Assemble( A, 0.5 + 0.1*i);
+        const VectorCL b( b0 + (0.1*i)*b1);
+        solver.Solve( A, x, b, DummyExchangeCL());
+        totaliter+= solver.GetIter();
+        if (norm( VectorCL( A*x - b)) > 2e-8*norm( b))
+            status= 1;
+    }
+    return status;
+}
+
+int main ()
+{
+    try {
+        VectorCL b0( N*N*N), b1( N*N*N);
+        for (size_t i= 0; i < b0.size(); ++i) {
+            b0[i]= drand48();
+            b1[i]= drand48();
+        }
+        JACPcCL pc;
+        GCRSolverCL<JACPcCL> gcr( pc, 200, 200, 1e-8, /*relative*/ true);
+        RecycleGCRSolverCL<JACPcCL> rgcr( pc, 200, /*recycle*/ 20, 200, 1e-8, /*relative*/ true);
+        int it_gcr, it_rgcr;
+        int status= SolveSequence( gcr, b0, b1, it_gcr) + SolveSequence( rgcr, b0, b1, it_rgcr);
+        std::cout << "GCR: " << it_gcr << " iterations, GCR with recycling: " << it_rgcr << " iterations in "
+                  << rgcr.GetNumSolves() << " solves, recycle dimension: " << rgcr.GetRecycleDim() << '\n';
+        if (rgcr.GetTotalIter() != it_rgcr || rgcr.GetNumSolves() != 8 || rgcr.GetRecycleDim() != 20 || 20*it_rgcr > 17*it_gcr)
+            status= 1;
+
+        // A changed numbering discards the recycled directions.
+        rgcr.ClearRecycleSpace();
+        if (rgcr.GetRecycleDim() != 0)
+            status= 1;
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,150 @@
+/// \file reparammethods.cpp
+/// \brief compares and times the propagation methods of the reparametrization of the level set function
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "levelset/fastmarch.h"
+
+using namespace DROPS;
+
+double sigma (const Point3DCL&, double) { return 1.; }
+double Dist  (const Point3DCL& p, double) { return (p - MakePoint3D( 0.5, 0.25, 0.5)).norm() - 0.2; }
+double Phi   (const Point3DCL& p, double t) { return 6.*Dist( p, t); } ///< not a distance function
+
+/// \brief Reparametrize with the given method and return the maximal error of the distance over all DoF.
+double Reparam (LevelsetP2CL& lset, int method, VectorCL& result, double band= -1.)
+{
+    lset.Init( Phi);
+    TimerCL timer;
+    timer.Start();
+    std::auto_ptr<ReparamCL> reparam= ReparamFactoryCL::GetReparam( lset.GetMG(), lset.Phi, method, /*periodic*/ false, &lset.GetBndData());
+    reparam->SetNarrowBand( band);
+    reparam->Perform();
+    timer.Stop();
+    std::cout << "method " << method << ": " << timer.GetTime() << " s\n";
+    result.resize( lset.Phi.Data.size());
+    result= lset.Phi.Data;
+
+    lset.Init( Dist);
+    return supnorm( VectorCL( result - lset.Phi.Data));
+}
+
+int main ()
+{
+    try {
+        BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 12, 12, 12);
+        MultiGridCL mg( brick);
+        for (int i= 0; i < 2; ++i) { // refine near the interface
+            DROPS_FOR_TRIANG_TETRA( mg, -1, It)
+                if (std::abs( Dist( GetBaryCenter( *It), 0.)) < 0.1)
+                    It->SetRegRefMark();
+            mg.Refine();
+        }
+        SurfaceTensionCL sf( sigma);
+        const BndCondT bc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+        const LsetBndDataCL lsbnd( 6, bc);
+        LevelsetP2ContCL lset( mg, lsbnd, sf);
+        lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+        lset.Phi.SetIdx( &lset.idx);
+        std::cout << "level set unknowns: " << lset.idx.NumUnknowns() << '\n';
+
+        int status= 0;
+        VectorCL set_result, heap_result;
+        for (int init= 0; init < 4; ++init) {
+            const double set_err=  Reparam( lset, init,      set_result),
+                         heap_err= Reparam( lset, 20 + init, heap_result);
+            const double diff= supnorm( VectorCL( set_result - heap_result));
+            std::cout << "init " << init << ": error: set: " << set_err << ", heap: " << heap_err
+                      << ", difference: " << diff << '\n';
+            // Both close sets order the DoF in the same way; the OpenMP-parallel initialization may round differently.
+            if (diff > 1e-12)
+                status= 1;
+        }
+
+        // The fast iterative method is at least as accurate as fast marching. Its result does not depend on the
+        // number of threads up to rounding in the initialization; at least two threads are used to test the parallel code path.
+        const int max_threads=
+#ifdef _OPENMP
+            omp_get_max_threads();
+#else
+            1;
+#endif
+        const int num_threads= std::max( 2, max_threads);
+        VectorCL fim_result, fim_result1;
+        for (int init= 0; init < 4; ++init) {
+            const double set_err= Reparam( lset, init, set_result);
+#ifdef _OPENMP
+            omp_set_num_threads( 1);
+#endif
+            Reparam( lset, 30 + init, fim_result1);
+#ifdef _OPENMP
+            omp_set_num_threads( num_threads);
+#endif
+            const double fim_err= Reparam( lset, 30 + init, fim_result);
+            const double diff= supnorm( VectorCL( fim_result - fim_result1));
+            std::cout << "init " << init << ": error: set: " << set_err << ", fim: " << fim_err
+                      << ", difference 1 vs. " << num_threads << " threads: " << diff << '\n';
+            if (fim_err > set_err + 1e-10 || diff > 1e-12)
+                status= 1;
+        }
+#ifdef _OPENMP
+        omp_set_num_threads( max_threads);
+#endif
+
+        // Within the narrow band, the distances must not be less accurate than without band, outside, phi is clamped.
+        const double band= 0.05;
+        const int band_methods[4]= { 3, 23, 33, 13 };
+        VectorCL band_result, exact;
+        lset.Init( Dist);
+        exact= lset.Phi.Data;
+        for (int m= 0; m < 4; ++m) {
+            Reparam( lset, band_methods[m], set_result);
+            Reparam( lset, band_methods[m], band_result, band);
+            double diff= 0., err= 0., band_err= 0.;
+            size_t num_band= 0;
+            for (size_t i= 0; i < set_result.size(); ++i) {
+                if (std::abs( set_result[i]) <= band) {
+                    diff= std::max( diff, std::abs( band_result[i] - set_result[i]));
+                    err= std::max( err, std::abs( set_result[i] - exact[i]));
+                    band_err= std::max( band_err, std::abs( band_result[i] - exact[i]));
+                    ++num_band;
+                }
+                else if (std::abs( band_result[i]) > band || band_result[i]*set_result[i] < 0.)
+                    status= 1;
+            }
+            std::cout << "method " << band_methods[m] << ": narrow band with " << num_band << " DoF: error within band: "
+                      << err << ", with band: " << band_err << ", difference: " << diff << '\n';
+            if (band_err > err + 1e-10)
+                status= 1;
+        }
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
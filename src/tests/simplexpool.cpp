@@ -0,0 +1,98 @@
+/// \file simplexpool.cpp
+/// \brief compares and times the refinement and tetra sweeps with the simplices stored in memory pools and on the heap
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+
+using namespace DROPS;
+
+const Uint MaxLevel= 3; ///< number of refinement levels at the interface
+
+/// \brief Refine the tetras near the sphere with radius r around c up to MaxLevel and coarsen the others.
+void MarkSphere (MultiGridCL& mg, const Point3DCL& c, double r)
+{
+    DROPS_FOR_TRIANG_TETRA( mg, -1, It) {
+        const bool near= std::abs( (GetBaryCenter( *It) - c).norm() - r) < 2.*std::pow( It->GetVolume(), 1./3.);
+        if (near && It->GetLevel() < MaxLevel)
+            It->SetRegRefMark();
+        else if (!near && It->GetLevel() > 0)
+            It->SetRemoveMark();
+    }
+}
+
+/// \brief An assembly-like sweep: accumulate the coordinates of the vertices and the volumes of all tetras.
+double Sweep (const MultiGridCL& mg)
+{
+    double s= 0.;
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, -1, It) {
+        s+= It->GetVolume();
+        for (Uint i= 0; i < 4; ++i)
+            s+= 1e-3*It->GetVertex( i)->GetCoord()[0];
+        for (Uint i= 0; i < 6; ++i)
+            s+= 1e-3*GetBaryCenter( *It->GetEdge( i))[1];
+    }
+    return s;
+}
+
+/// \brief Moves a sphere through the cube, adapts the grid to it and sweeps over the tetras after each step.
+double Run (PoolAllocationT mode, const char* name)
+{
+    SetPoolAllocation( mode);
+    BrickBuilderCL brick( std_basis<3>( 0), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), 8, 8, 8);
+    MultiGridCL mg( brick);
+    TimerCL refine, sweep;
+    double s= 0.;
+    for (int step= 0; step < 6; ++step) {
+        refine.Start();
+        for (Uint i= 0; i < MaxLevel; ++i) {
+            MarkSphere( mg, Point3DCL( 0.3 + 0.4*step/6.), 0.2);
+            mg.Refine();
+        }
+        refine.Stop();
+        sweep.Start();
+        for (int i= 0; i < 10; ++i)
+            s+= Sweep( mg);
+        sweep.Stop();
+    }
+    std::cout << name << ": refinement: " << refine.GetTime() << " s, sweeps: " << sweep.GetTime() << " s, "
+              << std::distance( mg.GetTriangTetraBegin(), mg.GetTriangTetraEnd()) << " tetras\n";
+    return s;
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        const double heap= Run( HeapAllocation, "heap"),
+                     pool= Run( PooledAllocation, "pool");
+        // The storage must not change the grids.
+        status+= std::abs( heap - pool) < 1e-10*std::abs( heap) ? 0 : 1;
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,186 @@
+/// \file sparsedirect.cpp
+/// \brief tests the sparse direct solvers and compares them with iterative coarse grid solvers
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "num/sparsedirect.h"
+#include "num/krylovsolver.h"
+#include "num/precond.h"
+#include "parallel/exchange.h"
+
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t N= 14;   ///< grid points per direction
+const int    NumRhs= 20; ///< number of right hand sides, e.g. coarse grid solves in the V-cycles of one multigrid solve
+
+/// \brief 7-point stencil of -div(k grad u) + conv*du/dx on the unit cube with k= 1 + c*x.
+/// If neumann is false, the boundary values are eliminated (Dirichlet); otherwise, the boundary is a Neumann boundary.
+void Assemble (MatrixCL& A, double c, double conv, bool neumann, bool reuse)
+{
+    const size_t n= N*N*N;
+    SparseMatBuilderCL<double> b( &A, n, n, reuse);
+    for (size_t i= 0; i < N; ++i)
+        for (size_t j= 0; j < N; ++j)
+            for (size_t k= 0; k < N; ++k) {
+                const size_t row= (i*N + j)*N + k;
+                const int idx[3]= { int( i), int( j), int( k) };
+                for (int d= 0; d < 3; ++d)
+                    for (int s= -1; s <= 1; s+= 2) {
+                        int nb[3]= { idx[0], idx[1], idx[2] };
+                        nb[d]+= s;
+                        const double kappa= 1. + c*(i + 0.5*(d == 0 ? s : 0))/N;
+                        if (nb[d] < 0 || nb[d] >= int( N)) {
+                            if (!neumann)
+                                b( row, row)+= kappa;
+                            continue;
+                        }
+                        b( row, row)+= kappa;
+                        b( row, (nb[0]*N + nb[1])*N + nb[2])-= kappa - (d == 0 ? 0.5*s*conv : 0.);
+                    }
+            }
+    b.Build();
+}
+
+VectorCL RandomVector (size_t n)
+{
+    VectorCL v( n);
+    for (size_t i= 0; i < n; ++i)
+        v[i]= drand48();
+    return v;
+}
+
+double RelResidual (const MatrixCL& A, const VectorCL& x, const VectorCL& b)
+{
+    return norm( VectorCL( A*x - b))/norm( b);
+}
+
+/// \brief Solve NumRhs systems with the direct solver and the iterative solver and compare the time.
+template <class DirectT, class IterativeT>
+int Compare (const char* name, DirectT& direct, IterativeT& iterative, const MatrixCL& A, double tol)
+{
+    std::vector<VectorCL> b;
+    for (int i= 0; i < NumRhs; ++i)
+        b.push_back( RandomVector( A.num_rows()));
+    VectorCL x( A.num_rows());
+
+    TimerCL timer;
+    double res_direct= 0.;
+    for (int i= 0; i < NumRhs; ++i) {
+        direct.Solve( A, x, b[i]);
+        res_direct= std::max( res_direct, RelResidual( A, x, b[i]));
+    }
+    timer.Stop();
+    const double t_direct= timer.GetTime();
+
+    timer.Reset();
+    double res_iter= 0.;
+    int it= 0;
+    for (int i= 0; i < NumRhs; ++i) {
+        x= 0.;
+        iterative.Solve( A, x, b[i], DummyExchangeCL());
+        it+= iterative.GetIter();
+        res_iter= std::max( res_iter, RelResidual( A, x, b[i]));
+    }
+    timer.Stop();
+    std::cout << name << ": direct: nonzeros of the factors: " << direct.GetFactorNonzeros()
+              << ", residual: " << res_direct << ", time for " << NumRhs << " solves: " << t_direct << " s\n"
+              << name << ": iterative: " << it << " iterations, residual: " << res_iter
+              << ", time for " << NumRhs << " solves: " << timer.GetTime() << " s\n";
+    return res_direct < tol ? 0 : 1;
+}
+
+int TestOrdering ()
+{
+    MatrixCL A;
+    Assemble( A, 0., 0., false, false);
+    SparseCholeskySolverCL natural( A, NaturalOrdering),
+                           rcm( A, RCMOrdering),
+                           nd( A, NestedDissectionOrdering);
+    std::cout << "Nonzeros of the factors: natural: " << natural.GetFactorNonzeros() << ", RCM: " << rcm.GetFactorNonzeros()
+              << ", nested dissection: " << nd.GetFactorNonzeros() << '\n';
+    int status= nd.GetFactorNonzeros() < rcm.GetFactorNonzeros() ? 0 : 1;
+
+    // the permutation is a bijection
+    PermutationT p;
+    nested_dissection( A, p);
+    std::vector<char> used( p.size(), 0);
+    for (size_t i= 0; i < p.size(); ++i)
+        if (p[i] >= p.size() || used[p[i]]++ != 0)
+            status= 1;
+    return status;
+}
+
+int TestCholesky ()
+{
+    MatrixCL A;
+    Assemble( A, 1., 0., false, false);
+    SparseCholeskySolverCL direct( A);
+    SSORPcCL ssor;
+    PCGSolverCL<SSORPcCL> pcg( ssor, 1000, 1e-10, /*relative*/ true);
+    int status= Compare( "Cholesky", direct, pcg, A, 1e-12);
+
+    // Only the values change: the symbolic factorization is reused.
+    Assemble( A, 3., 0., false, true);
+    direct.Update( A);
+    VectorCL b( RandomVector( A.num_rows())), x;
+    direct.Solve( A, x, b);
+    std::cout << "Cholesky, new values: residual: " << RelResidual( A, x, b) << ", symbolic factorizations: "
+              << direct.GetNumSymbolic() << ", numeric factorizations: " << direct.GetNumNumeric() << '\n';
+    if (RelResidual( A, x, b) > 1e-12 || direct.GetNumSymbolic() != 1 || direct.GetNumNumeric() != 2)
+        status= 1;
+
+    // Singular Neumann matrix with consistent right hand side
+    MatrixCL An;
+    Assemble( An, 1., 0., true, false);
+    b-= b.sum()/b.size();
+    direct.Update( An);
+    direct.Solve( An, x, b);
+    std::cout << "Cholesky, Neumann: residual: " << RelResidual( An, x, b) << ", perturbed pivots: "
+              << direct.GetNumPerturbedPivots() << '\n';
+    if (RelResidual( An, x, b) > 1e-10)
+        status= 1;
+    return status;
+}
+
+int TestLU ()
+{
+    MatrixCL A;
+    Assemble( A, 1., 20., false, false);
+    SparseLUSolverCL direct( A);
+    JACPcCL jac;
+    GMResSolverCL<JACPcCL> gmres( jac, 100, 1000, 1e-10, /*relative*/ true);
+    return Compare( "LU", direct, gmres, A, 1e-12);
+}
+
+int main ()
+{
+    try {
+        const int status= TestOrdering() + TestCholesky() + TestLU();
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,314 @@
+/// \file squadrature.cpp
+/// \brief tests the quadrature rules, the local FE-functions of fixed size and the P2 element kernels and measures the setup of the two-phase matrices
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "misc/utils.h"
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "navstokes/instatnavstokes2phase.h"
+#include "levelset/levelset.h"
+#include "levelset/surfacetension.h"
+#include "misc/funcmap.h"
+#include "num/quadrature.h"
+#include "num/lattice-eval.h"
+
+#include <cstdlib>
+#include <new>
+
+/// counts the calls of operator new to measure the allocations during the setup of the matrices
+static size_t num_alloc= 0;
+
+void* operator new (size_t size)
+{
+#pragma omp atomic
+    ++num_alloc;
+    void* p= std::malloc( size == 0 ? 1 : size);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete (void* p) throw ()
+{
+    std::free( p);
+}
+
+void operator delete (void* p, size_t) throw ()
+{
+    operator delete( p);
+}
+
+using namespace DROPS;
+
+const double R= 0.3;  ///< radius of the sphere
+
+Point3DCL ZeroVel (const Point3DCL&, double) { return Point3DCL(); }
+Point3DCL Rotation(const Point3DCL& p, double) { return MakePoint3D( p[1] - 0.5, 0.5 - p[0], p[2]*(1. - p[2])); }
+double    Zero    (const Point3DCL&, double) { return 0.; }
+double    sigma   (const Point3DCL&, double) { return 1.; }
+double    Sphere  (const Point3DCL& p, double) { return (p - Point3DCL( 0.5)).norm() - R; }
+
+// used by TwoPhaseFlowCoeffCL
+static RegisterVectorFunction regvelzerovel( "ZeroVel", ZeroVel);
+static RegisterScalarFunction regscazero( "Zero", Zero);
+
+double    Quadratic (const Point3DCL& p, double t) { return p[0]*p[1] + 2.*p[2]*p[2] - t; }
+
+int Check (const char* name, double err, double tol= 1e-14)
+{
+    if (err < tol)
+        return 0;
+    std::cout << name << ": error: " << err << '\n';
+    return 1;
+}
+
+/// \brief Compare the quadrature rules and local functions of fixed size with the valarray-based ones on the tetras of mg.
+int CheckQuadrature (const MultiGridCL& mg, const LevelsetP2CL& lset)
+{
+    int status= 0;
+    SMatrixCL<3,3> T;
+    double det;
+    Quad2CL<Point3DCL> qGradRef2[10], qGrad2[10];
+    Quad5CL<Point3DCL> qGradRef5[10], qGrad5[10];
+    SQuad2CL<Point3DCL> sGradRef2[10], sGrad2[10];
+    SQuad5CL<Point3DCL> sGradRef5[10], sGrad5[10];
+    P2DiscCL::GetGradientsOnRef( qGradRef2);
+    P2DiscCL::GetGradientsOnRef( qGradRef5);
+    P2DiscCL::GetGradientsOnRef( sGradRef2);
+    P2DiscCL::GetGradientsOnRef( sGradRef5);
+    BaryCoordCL tri[3];
+    tri[0]= MakeBaryCoord( 1., 0., 0., 0.); tri[1]= MakeBaryCoord( 0., 0.5, 0.5, 0.); tri[2]= MakeBaryCoord( 0., 0., 0.2, 0.8);
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, mg.GetLastLevel(), it) {
+        GetTrafoTr( T, det, *it);
+        const double absdet= std::fabs( det);
+        const LocalP1CL<> p1( *it, Quadratic, 0.5);
+        const SLocalP1CL<> sp1( *it, Quadratic, 0.5);
+        const LocalP2CL<> p2( *it, lset.Phi, lset.GetBndData());
+        const SLocalP2CL<> sp2( *it, lset.Phi, lset.GetBndData());
+        const LocalP2CL<Point3DCL> p2vec( *it, Rotation, 0.);
+        const SLocalP2CL<Point3DCL> sp2vec( *it, Rotation, 0.);
+        for (Uint i= 0; i < 4; ++i)
+            status+= Check( "SLocalP1CL", std::fabs( p1[i] - sp1[i]));
+        for (Uint i= 0; i < 10; ++i)
+            status+= Check( "SLocalP2CL", std::fabs( p2[i] - sp2[i]) + (p2vec[i] - sp2vec[i]).norm());
+        status+= Check( "SLocalP2CL, evaluation", std::fabs( p2( BaryCoordCL( 0.1)) - sp2( BaryCoordCL( 0.1))));
+
+        // integrals of functions, P2-functions and products with the P2-basis
+        const double q2= Quad2CL<>( *it, Quadratic, 0.5).quad( absdet), q3= Quad3CL<>( *it, Quadratic, 0.5).quad( absdet),
+                     q5= Quad5CL<>( *it, Quadratic, 0.5).quad( absdet);
+        status+= Check( "SQuad2CL", std::fabs( q2 - SQuad2CL<>( *it, Quadratic, 0.5).quad( absdet)));
+        status+= Check( "SQuad3CL", std::fabs( q3 - SQuad3CL<>( *it, Quadratic, 0.5).quad( absdet)));
+        status+= Check( "SQuad5CL", std::fabs( q5 - SQuad5CL<>( *it, Quadratic, 0.5).quad( absdet)));
+        const Quad2CL<Point3DCL> qvec2( p2vec);
+        const Quad5CL<Point3DCL> qvec5( p2vec);
+        const SQuad2CL<Point3DCL> svec2( sp2vec);
+        const SQuad5CL<Point3DCL> svec5( sp2vec), svec5_lp2( p2vec);
+        const Quad5CL<> qp1( p1);
+        const SQuad5CL<> sp1_5( p1);
+        const Quad3CL<> q3p2( p2);
+        const SQuad3CL<> s3p2( sp2);
+        for (Uint i= 0; i < 10; ++i) {
+            status+= Check( "SQuad2CL, P2", (qvec2.quadP2( i, absdet) - svec2.quadP2( i, absdet)).norm());
+            status+= Check( "SQuad3CL, P2", std::fabs( q3p2.quadP2( i, absdet) - s3p2.quadP2( i, absdet)));
+            status+= Check( "SQuad5CL, P2", (qvec5.quadP2( i, absdet) - svec5.quadP2( i, absdet)).norm()
+                + (qvec5.quadP2( i, absdet) - svec5_lp2.quadP2( i, absdet)).norm() + std::fabs( qp1.quadP2( i, absdet) - sp1_5.quadP2( i, absdet)));
+        }
+
+        // gradients and the arithmetic of the assembly
+        P2DiscCL::GetGradients( qGrad2, qGradRef2, T);
+        P2DiscCL::GetGradients( qGrad5, qGradRef5, T);
+        P2DiscCL::GetGradients( sGrad2, sGradRef2, T);
+        P2DiscCL::GetGradients( sGrad5, sGradRef5, T);
+        for (Uint i= 0; i < 10; ++i)
+            for (Uint j= 0; j < 10; ++j) {
+                const SMatrixCL<3,3> Ak= quad( OuterProductExpressionCL( qGrad2[i], qGrad2[j]), absdet, make_Quad2Data()),
+                                     sAk= quad( outer_product( sGrad2[i], sGrad2[j]), absdet, make_Quad2Data());
+                status+= Check( "SQuad2CL, outer product", frobenius_norm_sq( Ak - sAk), 1e-24);
+                const double c= Quad5CL<>( dot( qvec5, qGrad5[j])).quadP2( i, absdet),
+                             sc= SQuad5CL<>( dot( svec5, sGrad5[j])).quadP2( i, absdet);
+                status+= Check( "SQuad5CL, convection", std::fabs( c - sc));
+            }
+        const SQuad5CL<> ssum( 2.*dot( svec5, svec5)*sp1_5 - sp1_5*(1./3.) + SQuad5CL<>( 1.));
+        const Quad5CL<> qsum( 2.*dot( qvec5, qvec5)*qp1 - qp1*(1./3.) + 1.);
+        status+= Check( "SGridFunctionCL, arithmetic", std::fabs( ssum.quad( absdet) - qsum.quad( absdet)));
+
+        // quadrature on a triangle
+        status+= Check( "SQuad5_2DCL", std::fabs( Quad5_2DCL<>( *it, tri, Quadratic, 0.5).quad( absdet) - SQuad5_2DCL<>( *it, tri, Quadratic, 0.5).quad( absdet))
+            + std::fabs( Quad5_2DCL<>( p2, tri).quad( absdet) - SQuad5_2DCL<>( sp2, tri).quad( absdet)));
+    }
+    return status;
+}
+
+/// \brief Compare the products of the P2-gradients from the P1 mass matrices with those from quadrature on uncut tetras and on both parts of cut tetras.
+int CheckGradientProducts (const MultiGridCL& mg, const LevelsetP2CL& lset)
+{
+    int status= 0;
+    SMatrixCL<3,3> T;
+    double det, m[2][4][4];
+    SLocalP1CL<Point3DCL> GradRef[10], Grad[10];
+    LocalP1CL<Point3DCL> GradRefLP1[10], GradLP1[10];
+    SMatrixCL<3,3> GG[2][10][10];
+    P2DiscCL::GetGradientsOnRef( GradRef);
+    P2DiscCL::GetGradientsOnRef( GradRefLP1);
+
+    const PrincipalLatticeCL& lat= PrincipalLatticeCL::instance( 2);
+    std::valarray<double> ls_loc( lat.vertex_size());
+    TetraPartitionCL partition;
+    QuadDomainCL q2dom;
+    GridFunctionCL<Point3DCL> qA[10];
+    size_t num_cut= 0;
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, mg.GetLastLevel(), it) {
+        GetTrafoTr( T, det, *it);
+        const double absdet= std::fabs( det);
+        P2DiscCL::GetGradients( Grad, GradRef, T);
+        P2DiscCL::GetGradients( GradLP1, GradRefLP1, T);
+        const LocalP2CL<> ls( *it, lset.Phi, lset.GetBndData());
+        evaluate_on_vertexes( ls, lat, Addr( ls_loc));
+        if (!equal_signs( ls_loc)) {
+            ++num_cut;
+            partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc);
+            make_CompositeQuad2Domain( q2dom, partition);
+            for (int i= 0; i < 10; ++i)
+                resize_and_evaluate_on_vertexes( GradLP1[i], q2dom, qA[i]);
+            for (int sign= 0; sign < 2; ++sign) {
+                const TetraSignEnum s= sign == 0 ? NegTetraC : PosTetraC;
+                for (int k= 0; k < 4; ++k)
+                    for (int l= 0; l < 4; ++l) {
+                        m[sign][k][l]= 0.;
+                        QuadDomainCL::const_weight_iterator w= q2dom.weight_begin( s);
+                        for (QuadDomainCL::const_vertex_iterator v= q2dom.vertex_begin( s); v != q2dom.vertex_end( s); ++v, ++w)
+                            m[sign][k][l]+= *w*(*v)[k]*(*v)[l]*absdet;
+                    }
+                P2DiscCL::GetGradientProducts( GG[sign], Grad, m[sign]);
+                for (int i= 0; i < 10; ++i)
+                    for (int j= 0; j <= i; ++j) {
+                        const SMatrixCL<3,3> Ak= quad( OuterProductExpressionCL( qA[i], qA[j]), absdet, q2dom, s);
+                        status+= Check( "GetGradientProducts, cut tetra", std::sqrt( frobenius_norm_sq( Ak - GG[sign][i][j])), 1e-12*absdet*frobenius_norm_sq( T));
+                    }
+            }
+        }
+        for (int k= 0; k < 4; ++k)
+            for (int l= 0; l < 4; ++l)
+                m[0][k][l]= absdet*P1DiscCL::GetMass( k, l);
+        P2DiscCL::GetGradientProducts( GG[0], Grad, m[0]);
+        SQuad2CL<Point3DCL> sGradRef[10], sGrad[10];
+        P2DiscCL::GetGradientsOnRef( sGradRef);
+        P2DiscCL::GetGradients( sGrad, sGradRef, T);
+        for (int i= 0; i < 10; ++i)
+            for (int j= 0; j <= i; ++j) {
+                const SMatrixCL<3,3> Ak= quad( outer_product( sGrad[i], sGrad[j]), absdet, make_Quad2Data());
+                status+= Check( "GetGradientProducts", std::sqrt( frobenius_norm_sq( Ak - GG[0][i][j])), 1e-12*absdet*frobenius_norm_sq( T));
+            }
+    }
+    std::cout << "checked the gradient products on " << num_cut << " cut tetras\n";
+    return status + (num_cut > 0 ? 0 : 1);
+}
+
+/// \brief Check the quadrature, then set up the matrices repeatedly and report the time and the allocations per tetra.
+int Benchmark (Uint n, int repeat)
+{
+    BrickBuilderCL brick( Point3DCL( 0.), std_basis<3>( 1), std_basis<3>( 2), std_basis<3>( 3), n, n, n);
+    const BndCondT bc[6]= { DirBC, DirBC, DirBC, DirBC, DirBC, DirBC };
+    const StokesVelBndDataCL::bnd_val_fun bnd_fun[6]= { Rotation, Rotation, Rotation, Rotation, Rotation, Rotation };
+    const StokesBndDataCL bnddata( 6, bc, bnd_fun);
+    TwoPhaseFlowCoeffCL coeff( 1., 10., 1., 5., 0., MakePoint3D( 0., 0., -9.81));
+    coeff.volforce= Rotation;
+    InstatNavierStokes2PhaseP2P1CL Stokes( brick, coeff, bnddata, P1X_FE, 0.);
+    MultiGridCL& mg= Stokes.GetMG();
+
+    SurfaceTensionCL sf( sigma);
+    const BndCondT lsbc[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    const LsetBndDataCL lsbnd( 6, lsbc);
+    LevelsetP2ContCL lset( mg, lsbnd, sf);
+    lset.CreateNumbering( mg.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( Sphere);
+
+    Stokes.CreateNumberingVel( mg.GetLastLevel(), &Stokes.vel_idx);
+    Stokes.CreateNumberingPr( mg.GetLastLevel(), &Stokes.pr_idx, 0, &lset);
+    Stokes.SetIdx();
+    Stokes.v.SetIdx( &Stokes.vel_idx);
+    Stokes.InitVel( &Stokes.v, Rotation);
+    VecDescCL cplA( &Stokes.vel_idx), cplM( &Stokes.vel_idx), cplN( &Stokes.vel_idx);
+    size_t num_tetra= 0;
+    DROPS_FOR_TRIANG_CONST_TETRA( const_cast<const MultiGridCL&>( mg), mg.GetLastLevel(), it)
+        ++num_tetra;
+
+    const int status= CheckQuadrature( mg, lset) + CheckGradientProducts( mg, lset);
+
+    TimerCL timer;
+    size_t alloc;
+    std::cout << "tetras: " << num_tetra << '\n';
+    Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+    alloc= num_alloc;
+    timer.Reset();
+    for (int i= 0; i < repeat; ++i)
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+    timer.Stop();
+    std::cout << "SetupSystem1:   " << timer.GetTime()/repeat << " s, allocations per tetra: " << double( num_alloc - alloc)/(repeat*num_tetra) << '\n';
+
+    // without the setup of the sparsity pattern, only the local matrices are computed
+    Stokes.SetPatternReuse( true);
+    Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+    alloc= num_alloc;
+    timer.Reset();
+    for (int i= 0; i < repeat; ++i)
+        Stokes.SetupSystem1( &Stokes.A, &Stokes.M, &Stokes.b, &cplA, &cplM, lset, 0.);
+    timer.Stop();
+    std::cout << "SetupSystem1, reused pattern: " << timer.GetTime()/repeat << " s, allocations per tetra: " << double( num_alloc - alloc)/(repeat*num_tetra) << '\n';
+
+    alloc= num_alloc;
+    timer.Reset();
+    for (int i= 0; i < repeat; ++i)
+        Stokes.SetupNonlinear( &Stokes.N, &Stokes.v, &cplN, lset, 0.);
+    timer.Stop();
+    std::cout << "SetupNonlinear: " << timer.GetTime()/repeat << " s, allocations per tetra: " << double( num_alloc - alloc)/(repeat*num_tetra) << '\n';
+
+    alloc= num_alloc;
+    timer.Reset();
+    for (int i= 0; i < repeat; ++i)
+        Stokes.SetupPrMass( &Stokes.prM, lset);
+    timer.Stop();
+    std::cout << "SetupPrMass:    " << timer.GetTime()/repeat << " s, allocations per tetra: " << double( num_alloc - alloc)/(repeat*num_tetra) << '\n';
+
+    VectorCL x( Stokes.vel_idx.NumUnknowns()), y( Stokes.pr_idx.NumUnknowns());
+    for (size_t i= 0; i < x.size(); ++i)
+        x[i]= std::sin( double( i));
+    for (size_t i= 0; i < y.size(); ++i)
+        y[i]= std::cos( double( i));
+    std::cout.precision( 17);
+    std::cout << "CHECK " << norm( VectorCL( Stokes.A.Data*x)) << ' ' << norm( VectorCL( Stokes.M.Data*x)) << ' ' << norm( Stokes.b.Data)
+              << ' ' << norm( VectorCL( Stokes.N.Data*x)) << ' ' << norm( cplN.Data) << ' ' << norm( VectorCL( Stokes.prM.Data*y)) << '\n';
+    return status;
+}
+
+int main (int argc, char** argv)
+{
+    try {
+        const int status= Benchmark( argc > 1 ? std::atoi( argv[1]) : 8, argc > 2 ? std::atoi( argv[2]) : 1);
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}
@@ -0,0 +1,134 @@
+/// \file transpmul.cpp
+/// \brief compares and times the algorithms of the transposed matrix-vector product
+/// \author LNM RWTH Aachen: ; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2013 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/spmat.h"
+#include "misc/utils.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace DROPS;
+
+const size_t N= 32; ///< pressure grid points per direction; the velocity grid has 2N-1 points per direction
+
+void InitVector( VectorCL& v)
+{
+    for (size_t i= 0; i < v.size(); ++i)
+        v[i]= drand48() - 0.5;
+}
+
+/// \brief Divergence-like matrix with the shape of the P2/P1-matrix B: Each pressure unknown on the coarse grid
+/// couples with the 3 components of the velocity unknowns on the fine grid in its neighbourhood.
+void BuildMatrix (MatrixCL& B)
+{
+    const size_t M= 2*N - 1;
+    SparseMatBuilderCL<double> bB( &B, N*N*N, 3*M*M*M);
+    for (size_t k= 0; k < N; ++k)
+        for (size_t j= 0; j < N; ++j)
+            for (size_t i= 0; i < N; ++i) {
+                const size_t p= i + N*(j + N*k);
+                for (size_t kk= 2*k > 0 ? 2*k - 1 : 0; kk <= std::min( 2*k + 1, M - 1); ++kk)
+                    for (size_t jj= 2*j > 0 ? 2*j - 1 : 0; jj <= std::min( 2*j + 1, M - 1); ++jj)
+                        for (size_t ii= 2*i > 0 ? 2*i - 1 : 0; ii <= std::min( 2*i + 1, M - 1); ++ii)
+                            for (Uint c= 0; c < 3; ++c)
+                                bB( p, 3*(ii + M*(jj + M*kk)) + c)= drand48() - 0.5;
+            }
+    bB.Build();
+}
+
+int Check (const char* name, double err)
+{
+    std::cout << name << ": error: " << err << '\n';
+    return err < 1e-12 ? 0 : 1;
+}
+
+/// \brief Time transp_mul for all numbers of threads up to the maximum.
+void Benchmark (const char* name, const MatrixCL& B, const VectorCL& x)
+{
+    const int max_threads=
+#ifdef _OPENMP
+        omp_get_max_threads();
+#else
+        1;
+#endif
+    VectorCL y( B.num_cols());
+    for (int t= 1; t <= max_threads; t*= 2) {
+#ifdef _OPENMP
+        omp_set_num_threads( t);
+#endif
+        y= transp_mul( B, x); // warm-up; sets up the transpose for ExplicitTranspMul
+        TimerCL timer;
+        timer.Start();
+        for (int i= 0; i < 20; ++i)
+            y= transp_mul( B, x);
+        timer.Stop();
+        std::cout << name << ": " << t << " threads: " << timer.GetTime()/20. << " s\n";
+    }
+#ifdef _OPENMP
+    omp_set_num_threads( max_threads);
+#endif
+}
+
+int main ()
+{
+    try {
+        int status= 0;
+        MatrixCL B;
+        BuildMatrix( B);
+        std::cout << "B: " << B.num_rows() << " x " << B.num_cols() << ", " << B.num_nonzeros() << " nonzeros\n";
+
+        MatrixCL BT;
+        TimerCL timer;
+        timer.Start();
+        transpose( B, BT);
+        timer.Stop();
+        std::cout << "transpose: " << timer.GetTime() << " s\n";
+        double err= 0.;
+        for (size_t i= 0; i < B.num_rows(); ++i)
+            for (size_t nz= B.row_beg( i); nz < B.row_beg( i + 1); ++nz)
+                err= std::max( err, std::fabs( BT( B.col_ind( nz), i) - B.val( nz)));
+        status+= Check( "transpose", err + (BT.num_nonzeros() == B.num_nonzeros() ? 0. : 1.));
+
+        VectorCL x( B.num_rows());
+        InitVector( x);
+        const VectorCL ref( transp_mul( B, x));
+        Benchmark( "serial", B, x);
+
+        B.SetTranspMul( PrivateTranspMul);
+        status+= Check( "private", supnorm( VectorCL( transp_mul( B, x) - ref))/supnorm( ref));
+        Benchmark( "private", B, x);
+
+        B.SetTranspMul( ExplicitTranspMul);
+        status+= Check( "explicit", supnorm( VectorCL( transp_mul( B, x) - ref))/supnorm( ref));
+        Benchmark( "explicit", B, x);
+        // A modification of B must update the explicit transpose.
+        B*= 2.;
+        status+= Check( "explicit, modified", supnorm( VectorCL( transp_mul( B, x) - 2.*ref))/supnorm( ref));
+
+        std::cout << (status == 0 ? "All tests passed.\n" : "Some tests failed.\n");
+        return status;
+    }
+    catch (DROPSErrCL err) { err.handle(); }
+    return 1;
+}